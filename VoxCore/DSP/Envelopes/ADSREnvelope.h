@@ -5,6 +5,20 @@
 //  ADSR Envelope Generator
 //  Analog-style exponential curves (RC circuit behavior like SH-101)
 //
+//  Templated on sample type: level, smoothing state, and per-sample
+//  coefficients are SampleType; segment times stay double. ADSREnvelope is
+//  the double-precision reference, ADSREnvelopeFloat the float render path.
+//
+//  processBlock() renders whole segments without per-sample state checks:
+//  every segment is a geometric recursion, so the sample where it ends
+//  (attack >= 0.999, decay within 0.001 of sustain, release < 0.0001) is
+//  predicted with a log. The run up to just before that point executes the
+//  same recurrence branch-free; only the last few samples before a boundary
+//  go through the checked per-sample path. Segments are monotonic, so one
+//  check of the run's final level confirms no boundary was skipped (if the
+//  prediction was off, the run is redone per sample). Output is identical
+//  to process().
+//
 
 #pragma once
 
@@ -12,8 +26,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
-class ADSREnvelope {
+template <typename SampleType>
+class ADSREnvelopeT {
 public:
     enum class State {
         IDLE,
@@ -23,19 +39,19 @@ public:
         RELEASE
     };
     
-    ADSREnvelope(double sampleRate = 44100.0) 
+    ADSREnvelopeT(double sampleRate = 44100.0) 
         : mSampleRate(sampleRate),
           mState(State::IDLE),
-          mCurrentLevel(0.0),
-          mSmoothedOutput(0.0),
+          mCurrentLevel(0),
+          mSmoothedOutput(0),
           mAttackTime(0.01),    // 10ms default
           mDecayTime(0.1),      // 100ms default
-          mSustainLevel(0.7),   // 70% default
+          mSustainLevel(SampleType(0.7)), // 70% default
           mReleaseTime(0.3),    // 300ms default
-          mAttackCoeff(0.0),
-          mDecayCoeff(0.0),
-          mReleaseCoeff(0.0),
-          mSmoothingCoeff(0.99) {
+          mAttackCoeff(0),
+          mDecayCoeff(0),
+          mReleaseCoeff(0),
+          mSmoothingCoeff(SampleType(0.99)) {
         calculateCoefficients();
         calculateSmoothingCoeff();
     }
@@ -59,7 +75,7 @@ public:
     }
     
     void setSustainLevel(double level) {
-        mSustainLevel = std::max(0.0, std::min(1.0, level));
+        mSustainLevel = static_cast<SampleType>(std::max(0.0, std::min(1.0, level)));
     }
     
     void setReleaseTime(double seconds) {
@@ -70,12 +86,91 @@ public:
     // ADSR parameter getters
     double getAttackTime() const { return mAttackTime; }
     double getDecayTime() const { return mDecayTime; }
-    double getSustainLevel() const { return mSustainLevel; }
+    double getSustainLevel() const { return static_cast<double>(mSustainLevel); }
     double getReleaseTime() const { return mReleaseTime; }
     
+    // Returned by getSamplesUntilSilent() while the gate holds the level up
+    static constexpr int kNeverSilent = std::numeric_limits<int>::max();
+    
+    // Predict how many more process() calls until the smoothed output falls
+    // below threshold and stays there, from the current level, smoother state,
+    // and coefficients (no simulation). Held notes (attack/decay/sustain) never
+    // fall silent unless the sustain level is itself below the threshold.
+    int getSamplesUntilSilent(double threshold = 0.0001) const {
+        const double s = static_cast<double>(mSmoothingCoeff);
+        const double y0 = static_cast<double>(mSmoothedOutput);
+        const double level = static_cast<double>(mCurrentLevel);
+        threshold = std::max(threshold, 1e-12);
+        
+        switch (mState) {
+            case State::IDLE:
+                return smootherDecaySamples(y0, threshold);
+                
+            case State::ATTACK:
+            case State::DECAY:
+            case State::SUSTAIN:
+                if (mState == State::SUSTAIN && static_cast<double>(mSustainLevel) < threshold) {
+                    // Smoother settles toward the (sub-threshold) sustain level
+                    double gap = y0 - static_cast<double>(mSustainLevel);
+                    if (gap <= 0.0 || y0 < threshold) return 0;
+                    return decaySamples(gap, threshold - static_cast<double>(mSustainLevel), s);
+                }
+                return kNeverSilent;
+                
+            case State::RELEASE: {
+                // Level: L[n] = L0 * r^n until it drops below 0.0001 at nEnd,
+                // then 0. Smoother: y[n] = s^n (y0 - K) + K r^n,
+                // K = (1 - s) L0 r / (r - s).
+                double r = 1.0 - static_cast<double>(mReleaseCoeff);
+                if (std::abs(r - s) < 1e-12) {
+                    r = s * (1.0 - 1e-9);
+                }
+                const double K = (1.0 - s) * level * r / (r - s);
+                const int nEnd = std::max(1, static_cast<int>(std::ceil(segmentLength(level, 0.0001, 1.0 - r))));
+                auto smoothed = [&](int n) {
+                    return std::pow(s, n) * (y0 - K) + K * std::pow(r, n);
+                };
+                
+                // y[n] rises at most once (smoother catching up), then falls.
+                // Start the search after the turning point, if any.
+                int start = 0;
+                double ratio = -(y0 - K) * std::log(s) / (K * std::log(r));
+                if (K != 0.0 && ratio > 0.0) {
+                    start = std::max(0, static_cast<int>(std::ceil(std::log(ratio) / std::log(r / s))));
+                }
+                
+                if (start >= nEnd) {
+                    // Still rising or flat when release ends: smoother tail only
+                    double yEnd = nEnd > 0 ? smoothed(nEnd - 1) * s : y0;
+                    return nEnd + smootherDecaySamples(yEnd, threshold);
+                }
+                if (smoothed(start) < threshold) {
+                    return start;
+                }
+                if (smoothed(nEnd - 1) >= threshold) {
+                    // Crosses after the level snaps to 0
+                    double yEnd = smoothed(nEnd - 1) * s;
+                    return nEnd + smootherDecaySamples(yEnd, threshold);
+                }
+                // Bisect the falling part for the first sample below threshold
+                int lo = start, hi = nEnd - 1;
+                while (hi - lo > 1) {
+                    int mid = lo + (hi - lo) / 2;
+                    if (smoothed(mid) < threshold) {
+                        hi = mid;
+                    } else {
+                        lo = mid;
+                    }
+                }
+                return hi;
+            }
+        }
+        return kNeverSilent;
+    }
+    
     // Get current envelope state
     State getState() const { return mState; }
-    double getCurrentLevel() const { return mCurrentLevel; }
+    SampleType getCurrentLevel() const { return mCurrentLevel; }
     
     // Gate control
     void noteOn() {
@@ -93,15 +188,15 @@ public:
     // Reset envelope to idle state
     void reset() {
         mState = State::IDLE;
-        mCurrentLevel = 0.0;
-        mSmoothedOutput = 0.0;
+        mCurrentLevel = SampleType(0);
+        mSmoothedOutput = SampleType(0);
     }
     
     // Process next sample - analog RC circuit style exponential curves
-    double process() {
+    SampleType process() {
         switch (mState) {
             case State::IDLE:
-                mCurrentLevel = 0.0;
+                mCurrentLevel = SampleType(0);
                 break;
                 
             case State::ATTACK:
@@ -109,8 +204,8 @@ public:
                 // We aim for kAttackTarget so we actually reach 1.0
                 // This mimics an RC circuit charging toward a higher voltage
                 mCurrentLevel = mCurrentLevel + (kAttackTarget - mCurrentLevel) * mAttackCoeff;
-                if (mCurrentLevel >= 0.999) {
-                    mCurrentLevel = 1.0;
+                if (mCurrentLevel >= SampleType(0.999)) {
+                    mCurrentLevel = SampleType(1);
                     mState = State::DECAY;
                 }
                 break;
@@ -120,7 +215,7 @@ public:
                 // Classic RC discharge curve
                 mCurrentLevel = mCurrentLevel + (mSustainLevel - mCurrentLevel) * mDecayCoeff;
                 // Check if we're close enough to sustain (within 0.1% or below)
-                if (std::abs(mCurrentLevel - mSustainLevel) < 0.001) {
+                if (std::abs(mCurrentLevel - mSustainLevel) < SampleType(0.001)) {
                     mCurrentLevel = mSustainLevel;
                     mState = State::SUSTAIN;
                 }
@@ -133,9 +228,9 @@ public:
             case State::RELEASE:
                 // Exponential decay toward zero
                 // Classic RC discharge curve - fast initial drop, long tail
-                mCurrentLevel = mCurrentLevel * (1.0 - mReleaseCoeff);
-                if (mCurrentLevel < 0.0001) {
-                    mCurrentLevel = 0.0;
+                mCurrentLevel = mCurrentLevel * (SampleType(1) - mReleaseCoeff);
+                if (mCurrentLevel < SampleType(0.0001)) {
+                    mCurrentLevel = SampleType(0);
                     mState = State::IDLE;
                 }
                 break;
@@ -143,22 +238,200 @@ public:
         
         // Apply one-pole smoothing filter to remove clicks and discontinuities
         // This smooths out any sudden jumps in envelope level
-        mSmoothedOutput = mSmoothedOutput * mSmoothingCoeff + mCurrentLevel * (1.0 - mSmoothingCoeff);
+        mSmoothedOutput = mSmoothedOutput * mSmoothingCoeff + mCurrentLevel * (SampleType(1) - mSmoothingCoeff);
         
         return mSmoothedOutput;
     }
     
     // Process block of samples
-    void processBlock(double* output, int numSamples) {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = process();
-        }
+    void processBlock(SampleType* output, int numSamples) {
+        render(output, numSamples, false);
+    }
+    
+    // Process until the envelope goes idle (the sample that reaches IDLE is
+    // included). Returns the number of samples written.
+    int processBlockWhileActive(SampleType* output, int numSamples) {
+        return render(output, numSamples, true);
     }
     
 private:
+    // EnvelopeBankT gathers and scatters level, state, and coefficients
+    template <typename, int> friend class EnvelopeBankT;
+    
+    int render(SampleType* output, int numSamples, bool stopWhenIdle) {
+        int i = 0;
+        while (i < numSamples) {
+            if (stopWhenIdle && mState == State::IDLE) {
+                break;
+            }
+            int run = uncheckedRunLength(numSamples - i);
+            if (run > 0) {
+                SampleType startLevel = mCurrentLevel;
+                SampleType startSmoothed = mSmoothedOutput;
+                renderRun(output + i, run);
+                if (segmentBoundaryReached()) {
+                    // Prediction was too optimistic: redo the run checked
+                    mCurrentLevel = startLevel;
+                    mSmoothedOutput = startSmoothed;
+                    for (int k = 0; k < run; ++k) {
+                        output[i + k] = process();
+                    }
+                }
+                i += run;
+            } else {
+                output[i++] = process();
+            }
+        }
+        return i;
+    }
+    
+    // Samples that can be rendered before the current segment could possibly
+    // end. The analytic boundary is backed off by a margin (1/64 of the run,
+    // at least 4 samples) to absorb rounding in the SampleType recurrence.
+    int uncheckedRunLength(int remaining) const {
+        double samplesToBoundary;
+        switch (mState) {
+            case State::IDLE:
+            case State::SUSTAIN:
+                return remaining;
+            case State::ATTACK:
+                samplesToBoundary = segmentLength(static_cast<double>(kAttackTarget - mCurrentLevel),
+                                                  static_cast<double>(kAttackTarget) - 0.999,
+                                                  static_cast<double>(mAttackCoeff));
+                break;
+            case State::DECAY:
+                samplesToBoundary = segmentLength(std::abs(static_cast<double>(mCurrentLevel - mSustainLevel)),
+                                                  0.001,
+                                                  static_cast<double>(mDecayCoeff));
+                break;
+            case State::RELEASE:
+                samplesToBoundary = segmentLength(static_cast<double>(mCurrentLevel),
+                                                  0.0001,
+                                                  static_cast<double>(mReleaseCoeff));
+                break;
+            default:
+                return 0;
+        }
+        
+        return safeRunLength(samplesToBoundary, remaining);
+    }
+    
+    // Back a predicted boundary off by the rounding margin
+    static int safeRunLength(double samplesToBoundary, int remaining) {
+        if (samplesToBoundary > remaining + 64.0) {
+            return remaining;
+        }
+        int n = static_cast<int>(samplesToBoundary);
+        int safe = n - std::max(4, n / 64);
+        return std::max(0, std::min(safe, remaining));
+    }
+    
+    // The per-sample end-of-segment test from process(), on the current level
+    bool segmentBoundaryReached() const {
+        switch (mState) {
+            case State::ATTACK:
+                return mCurrentLevel >= SampleType(0.999);
+            case State::DECAY:
+                return std::abs(mCurrentLevel - mSustainLevel) < SampleType(0.001);
+            case State::RELEASE:
+                return mCurrentLevel < SampleType(0.0001);
+            default:
+                return false;
+        }
+    }
+    
+    // Samples for the smoother alone (level 0) to fall from y to below threshold
+    int smootherDecaySamples(double y, double threshold) const {
+        if (y < threshold) {
+            return 0;
+        }
+        return decaySamples(y, threshold, static_cast<double>(mSmoothingCoeff));
+    }
+    
+    // First n with gap * factor^n < target
+    static int decaySamples(double gap, double target, double factor) {
+        if (gap < target) {
+            return 0;
+        }
+        if (factor <= 0.0) {
+            return 1;
+        }
+        if (factor >= 1.0) {
+            return kNeverSilent;
+        }
+        double n = std::floor(std::log(target / gap) / std::log(factor)) + 1.0;
+        return n >= static_cast<double>(kNeverSilent) ? kNeverSilent : static_cast<int>(n);
+    }
+    
+    // Samples for a gap shrinking geometrically by (1 - coeff) per sample to
+    // fall from gapStart to gapEnd: log(gapEnd / gapStart) / log(1 - coeff)
+    static double segmentLength(double gapStart, double gapEnd, double coeff) {
+        if (gapStart <= gapEnd || coeff <= 0.0 || coeff >= 1.0) {
+            return 0.0;
+        }
+        return std::log(gapEnd / gapStart) / std::log1p(-coeff);
+    }
+    
+    // Branch-free run of the current segment's recurrence plus the smoother.
+    // Caller guarantees the segment does not end within count samples.
+    void renderRun(SampleType* output, int count) {
+        SampleType level = mCurrentLevel;
+        SampleType smoothed = mSmoothedOutput;
+        const SampleType smoothing = mSmoothingCoeff;
+        const SampleType smoothingInput = SampleType(1) - mSmoothingCoeff;
+        
+        switch (mState) {
+            case State::IDLE:
+                level = SampleType(0);
+                for (int i = 0; i < count; ++i) {
+                    smoothed = smoothed * smoothing + level * smoothingInput;
+                    output[i] = smoothed;
+                }
+                break;
+            case State::SUSTAIN:
+                level = mSustainLevel;
+                for (int i = 0; i < count; ++i) {
+                    smoothed = smoothed * smoothing + level * smoothingInput;
+                    output[i] = smoothed;
+                }
+                break;
+            case State::ATTACK: {
+                const SampleType coeff = mAttackCoeff;
+                for (int i = 0; i < count; ++i) {
+                    level = level + (kAttackTarget - level) * coeff;
+                    smoothed = smoothed * smoothing + level * smoothingInput;
+                    output[i] = smoothed;
+                }
+                break;
+            }
+            case State::DECAY: {
+                const SampleType coeff = mDecayCoeff;
+                const SampleType sustain = mSustainLevel;
+                for (int i = 0; i < count; ++i) {
+                    level = level + (sustain - level) * coeff;
+                    smoothed = smoothed * smoothing + level * smoothingInput;
+                    output[i] = smoothed;
+                }
+                break;
+            }
+            case State::RELEASE: {
+                const SampleType factor = SampleType(1) - mReleaseCoeff;
+                for (int i = 0; i < count; ++i) {
+                    level = level * factor;
+                    smoothed = smoothed * smoothing + level * smoothingInput;
+                    output[i] = smoothed;
+                }
+                break;
+            }
+        }
+        
+        mCurrentLevel = level;
+        mSmoothedOutput = smoothed;
+    }
+    
     // Attack target slightly above 1.0 so exponential curve actually reaches 1.0
     // In a real RC circuit, you charge toward a higher voltage than your threshold
-    static constexpr double kAttackTarget = 1.2;
+    static constexpr SampleType kAttackTarget = SampleType(1.2);
     
     // Time constant multiplier - how many time constants to reach ~99.3% of target
     // 5 time constants = 99.3% of final value (e^-5 ≈ 0.007)
@@ -176,19 +449,19 @@ private:
         // coeff = 1 - e^(-1 / (tau * sampleRate))
         // where tau = attackTime / kTimeConstantMultiplier
         double tau = mAttackTime / kTimeConstantMultiplier;
-        mAttackCoeff = 1.0 - std::exp(-1.0 / (tau * mSampleRate));
+        mAttackCoeff = static_cast<SampleType>(1.0 - std::exp(-1.0 / (tau * mSampleRate)));
     }
     
     void calculateDecayCoeff() {
         // Same formula for decay toward sustain level
         double tau = mDecayTime / kTimeConstantMultiplier;
-        mDecayCoeff = 1.0 - std::exp(-1.0 / (tau * mSampleRate));
+        mDecayCoeff = static_cast<SampleType>(1.0 - std::exp(-1.0 / (tau * mSampleRate)));
     }
     
     void calculateReleaseCoeff() {
         // Same formula for release toward zero
         double tau = mReleaseTime / kTimeConstantMultiplier;
-        mReleaseCoeff = 1.0 - std::exp(-1.0 / (tau * mSampleRate));
+        mReleaseCoeff = static_cast<SampleType>(1.0 - std::exp(-1.0 / (tau * mSampleRate)));
     }
     
     void calculateSmoothingCoeff() {
@@ -196,27 +469,30 @@ private:
         // This provides click-free envelope transitions without affecting musical timing
         double smoothingTimeMs = 1.0; // 1ms smoothing
         double smoothingTimeSamples = (smoothingTimeMs / 1000.0) * mSampleRate;
-        mSmoothingCoeff = std::exp(-1.0 / smoothingTimeSamples);
+        mSmoothingCoeff = static_cast<SampleType>(std::exp(-1.0 / smoothingTimeSamples));
     }
     
     double mSampleRate;
     State mState;
-    double mCurrentLevel;
-    double mSmoothedOutput;  // One-pole filtered output for click-free transitions
+    SampleType mCurrentLevel;
+    SampleType mSmoothedOutput;  // One-pole filtered output for click-free transitions
     
     // ADSR parameters
     double mAttackTime;      // Time to reach full level (seconds)
     double mDecayTime;       // Time to reach sustain level (seconds)
-    double mSustainLevel;    // Level to hold while gate is on (0-1)
+    SampleType mSustainLevel; // Level to hold while gate is on (0-1)
     double mReleaseTime;     // Time to reach zero after gate off (seconds)
     
     // Calculated coefficients for exponential curves (per sample)
-    double mAttackCoeff;
-    double mDecayCoeff;
-    double mReleaseCoeff;
+    SampleType mAttackCoeff;
+    SampleType mDecayCoeff;
+    SampleType mReleaseCoeff;
     
     // Smoothing filter coefficient for click prevention
-    double mSmoothingCoeff;
+    SampleType mSmoothingCoeff;
 };
 
+using ADSREnvelope = ADSREnvelopeT<double>;
+using ADSREnvelopeFloat = ADSREnvelopeT<float>;
+
 #endif // __cplusplus
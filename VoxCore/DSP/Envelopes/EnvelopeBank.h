@@ -0,0 +1,340 @@
+//
+//  EnvelopeBank.h
+//  VoxCore
+//
+//  Voice-batched ADSR envelopes (structure of arrays)
+//
+//  Every voice owns an amp and a mod ADSREnvelopeT, each with its state
+//  scattered across its own object. The bank gathers those envelopes into
+//  lanes - level, smoothed output, state, and segment coefficients each in
+//  their own array - and advances all lanes together. Every segment is
+//  written as the one recurrence
+//      level = level * mul + (target - level) * coeff
+//  with per-lane mul/target/coeff, chosen so each segment rounds exactly as
+//  in ADSREnvelopeT::process(): a lane's output is bit-identical to the
+//  envelope it was loaded from.
+//
+//  As in ADSREnvelopeT::processBlock(), the samples before the earliest
+//  predicted segment boundary across all lanes run just that recurrence and
+//  the smoother - a loop over lanes with no per-lane branches, so it
+//  compiles to SIMD over voices. Samples near a boundary take a checked step
+//  whose segment transitions are 0/1 lane masks blended arithmetically.
+//
+//  Lanes are masked rather than branched around: a lane that has gone idle -
+//  or whose gate lane has, for a mod envelope that only runs while its voice
+//  sounds - holds its state for the rest of the block.
+//
+//  Usage per block: clear(), addLane() for each envelope, process(), then
+//  store() each lane back into its envelope.
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include "ADSREnvelope.h"
+#include <array>
+#include <algorithm>
+#include <cmath>
+
+template <typename SampleType, int MaxLanes>
+class EnvelopeBankT {
+public:
+    using EnvelopeType = ADSREnvelopeT<SampleType>;
+    using State = typename EnvelopeType::State;
+
+    static constexpr int kMaxLanes = MaxLanes;
+    static constexpr int kBlockSize = 64;
+
+    void clear() { mLaneCount = 0; }
+
+    int getLaneCount() const { return mLaneCount; }
+
+    // Gather an envelope into the next lane. A lane with a gateLane advances
+    // only while that lane is active (mod envelope following its voice's amp
+    // envelope); otherwise it advances while its own state is not IDLE.
+    // Returns the lane index, or -1 if the bank is full.
+    int addLane(const EnvelopeType& env, int gateLane = -1) {
+        if (mLaneCount >= kMaxLanes) {
+            return -1;
+        }
+        const int lane = mLaneCount++;
+        const State state = env.mState;
+        const SampleType sustain = env.mSustainLevel;
+        mLevel[lane] = env.mCurrentLevel;
+        mSmoothed[lane] = env.mSmoothedOutput;
+        mState[lane] = static_cast<SampleType>(static_cast<int>(state));
+        mSustain[lane] = sustain;
+        mDecayCoeff[lane] = env.mDecayCoeff;
+        mSmoothing[lane] = env.mSmoothingCoeff;
+        mSmoothingInput[lane] = SampleType(1) - env.mSmoothingCoeff;
+        mGate[lane] = (gateLane >= 0 && gateLane < lane) ? gateLane : lane;
+        mActiveSamples[lane] = SampleType(0);
+
+        // Segment as next = level * mul + (target - level) * coeff, each
+        // term chosen so the result rounds exactly like process():
+        //   attack/decay  mul 1, coeff c   -> level + (target - level) * c
+        //   release       mul 1 - c, 0     -> level * (1 - c)
+        //   sustain/idle  mul 1, coeff 1   -> target (level preset to it)
+        mMul[lane] = SampleType(1);
+        mCoeff[lane] = SampleType(1);
+        mIsAttack[lane] = state == State::ATTACK ? SampleType(1) : SampleType(0);
+        mIsDecay[lane] = state == State::DECAY ? SampleType(1) : SampleType(0);
+        mIsRelease[lane] = state == State::RELEASE ? SampleType(1) : SampleType(0);
+        switch (state) {
+            case State::IDLE:
+                mTarget[lane] = SampleType(0);
+                mLevel[lane] = SampleType(0);
+                break;
+            case State::ATTACK:
+                mTarget[lane] = kAttackTarget;
+                mCoeff[lane] = env.mAttackCoeff;
+                break;
+            case State::DECAY:
+                mTarget[lane] = sustain;
+                mCoeff[lane] = env.mDecayCoeff;
+                break;
+            case State::SUSTAIN:
+                mTarget[lane] = sustain;
+                mLevel[lane] = sustain;
+                break;
+            case State::RELEASE:
+                mTarget[lane] = SampleType(0);
+                mMul[lane] = SampleType(1) - env.mReleaseCoeff;
+                mCoeff[lane] = SampleType(0);
+                break;
+        }
+        return lane;
+    }
+
+    // Advance every lane numSamples (<= kBlockSize) samples. As in
+    // ADSREnvelopeT::processBlock(), the samples up to the next predicted
+    // segment boundary in any lane run the bare recurrence across lanes;
+    // only the samples near a boundary take the checked step.
+    void process(int numSamples) {
+        numSamples = std::min(numSamples, kBlockSize);
+
+        for (int l = 0; l < mLaneCount; ++l) {
+            mActiveSamples[l] = SampleType(0);
+            mLive[l] = SampleType(1);
+        }
+        if (!updateLive()) {
+            return;
+        }
+
+        int i = 0;
+        while (i < numSamples) {
+            int run = uncheckedRunLength(numSamples - i);
+            if (run > 0) {
+                const auto startLevel = mLevel;
+                const auto startSmoothed = mSmoothed;
+                renderRun(i, run);
+                if (segmentBoundaryReached()) {
+                    // Prediction was too optimistic: redo the run checked
+                    mLevel = startLevel;
+                    mSmoothed = startSmoothed;
+                    for (int k = 0; k < run; ++k) {
+                        stepChecked(i + k);
+                    }
+                } else {
+                    for (int l = 0; l < mLaneCount; ++l) {
+                        mActiveSamples[l] += mLive[l] * static_cast<SampleType>(run);
+                    }
+                }
+                i += run;
+            } else if (!stepChecked(i++)) {
+                break;
+            }
+        }
+    }
+
+    // Scatter a lane's state back into its envelope
+    void store(int lane, EnvelopeType& env) const {
+        env.mCurrentLevel = mLevel[lane];
+        env.mSmoothedOutput = mSmoothed[lane];
+        env.mState = static_cast<State>(static_cast<int>(mState[lane]));
+    }
+
+    // Lane output for the last process(): sample i is at output(lane)[i * stride()]
+    const SampleType* output(int lane) const { return &mOutput[0][lane]; }
+    static constexpr int stride() { return kMaxLanes; }
+    SampleType getOutput(int lane, int sample) const { return mOutput[sample][lane]; }
+
+    // Samples the lane advanced in the last process() - for an amp envelope,
+    // the samples its voice rendered before going idle (that sample included)
+    int getActiveSamples(int lane) const { return static_cast<int>(mActiveSamples[lane]); }
+
+    State getState(int lane) const { return static_cast<State>(static_cast<int>(mState[lane])); }
+
+private:
+    // Segment states as lane values, so the kernel runs in one element type
+    static constexpr SampleType kIdle = static_cast<int>(State::IDLE);
+    static constexpr SampleType kAttack = static_cast<int>(State::ATTACK);
+    static constexpr SampleType kDecay = static_cast<int>(State::DECAY);
+    static constexpr SampleType kSustain = static_cast<int>(State::SUSTAIN);
+    static constexpr SampleType kRelease = static_cast<int>(State::RELEASE);
+    static constexpr SampleType kAttackTarget = EnvelopeType::kAttackTarget;
+
+    // Samples every live lane can run before its segment could end
+    int uncheckedRunLength(int remaining) const {
+        int run = remaining;
+        for (int l = 0; l < mLaneCount && run > 0; ++l) {
+            if (mLive[l] == SampleType(0)) {
+                continue;
+            }
+            const double level = static_cast<double>(mLevel[l]);
+            double samplesToBoundary;
+            if (mIsAttack[l] != SampleType(0)) {
+                samplesToBoundary = EnvelopeType::segmentLength(static_cast<double>(kAttackTarget) - level,
+                                                                static_cast<double>(kAttackTarget) - 0.999,
+                                                                static_cast<double>(mCoeff[l]));
+            } else if (mIsDecay[l] != SampleType(0)) {
+                samplesToBoundary = EnvelopeType::segmentLength(std::abs(level - static_cast<double>(mSustain[l])),
+                                                                0.001,
+                                                                static_cast<double>(mCoeff[l]));
+            } else if (mIsRelease[l] != SampleType(0)) {
+                samplesToBoundary = EnvelopeType::segmentLength(level, 0.0001,
+                                                                1.0 - static_cast<double>(mMul[l]));
+            } else {
+                continue;  // idle and sustain never end on their own
+            }
+            run = std::min(run, EnvelopeType::safeRunLength(samplesToBoundary, remaining));
+        }
+        return run;
+    }
+
+    // The end-of-segment tests from process(), on every live lane
+    bool segmentBoundaryReached() const {
+        for (int l = 0; l < mLaneCount; ++l) {
+            const SampleType level = mLevel[l];
+            if ((mIsAttack[l] != SampleType(0) && level >= SampleType(0.999)) ||
+                (mIsDecay[l] != SampleType(0) && std::abs(level - mSustain[l]) < SampleType(0.001)) ||
+                (mIsRelease[l] != SampleType(0) && level < SampleType(0.0001))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Bare segment recurrence and smoother across lanes; the caller
+    // guarantees no lane reaches a segment boundary within count samples
+    void renderRun(int start, int count) {
+        const int lanes = mLaneCount;
+        for (int i = start; i < start + count; ++i) {
+            auto& out = mOutput[i];
+            for (int l = 0; l < lanes; ++l) {
+                const SampleType level = mLevel[l];
+                const SampleType next = level * mMul[l] + (mTarget[l] - level) * mCoeff[l];
+                const SampleType smoothed = mSmoothed[l] * mSmoothing[l] + next * mSmoothingInput[l];
+                mLevel[l] = next;
+                mSmoothed[l] = smoothed;
+                out[l] = smoothed;
+            }
+        }
+    }
+
+    // One sample of every lane with segment transitions; returns false once
+    // every lane is masked
+    bool stepChecked(int i) {
+        const int lanes = mLaneCount;
+        auto& out = mOutput[i];
+        for (int l = 0; l < lanes; ++l) {
+            const SampleType state = mState[l];
+            const SampleType level = mLevel[l];
+            const SampleType target = mTarget[l];
+            const SampleType coeff = mCoeff[l];
+            const SampleType mul = mMul[l];
+            const SampleType sustain = mSustain[l];
+            const SampleType decayCoeff = mDecayCoeff[l];
+            const SampleType attack = mIsAttack[l];
+            const SampleType decay = mIsDecay[l];
+            const SampleType release = mIsRelease[l];
+
+            // One recurrence for every segment
+            const SampleType raw = level * mul + (target - level) * coeff;
+
+            // End-of-segment tests from process(), as 0/1 lane masks. At
+            // most one fires, and the transitions below blend with them
+            // arithmetically (x * 1 + y * 0 == x exactly), leaving no
+            // per-state select chains for the compiler to turn back into
+            // branches.
+            const SampleType attackDone = raw >= SampleType(0.999) ? attack : SampleType(0);
+            const SampleType decayDone = std::abs(raw - sustain) < SampleType(0.001) ? decay : SampleType(0);
+            const SampleType releaseDone = raw < SampleType(0.0001) ? release : SampleType(0);
+            const SampleType done = attackDone + decayDone + releaseDone;
+            const SampleType stay = SampleType(1) - done;
+
+            // attack -> decay at 1, decay -> sustain at sustain, release -> idle at 0
+            const SampleType next = raw * stay + attackDone + sustain * decayDone;
+            const SampleType nextTarget = target * (SampleType(1) - attackDone) + sustain * attackDone;
+            const SampleType nextCoeff = coeff * stay + decayCoeff * attackDone + (decayDone + releaseDone);
+            const SampleType nextMul = mul * (SampleType(1) - releaseDone) + releaseDone;
+
+            const SampleType smoothed = mSmoothed[l] * mSmoothing[l] + next * mSmoothingInput[l];
+
+            mLevel[l] = next;
+            mState[l] = state + (kDecay - kAttack) * attackDone
+                              + (kSustain - kDecay) * decayDone
+                              + (kIdle - kRelease) * releaseDone;
+            mIsAttack[l] = attack - attackDone;
+            mIsDecay[l] = decay + attackDone - decayDone;
+            mIsRelease[l] = release - releaseDone;
+            mTarget[l] = nextTarget;
+            mCoeff[l] = nextCoeff;
+            mMul[l] = nextMul;
+            mSmoothed[l] = smoothed;
+            mActiveSamples[l] += mLive[l];
+            out[l] = smoothed;
+        }
+        return updateLive();
+    }
+
+    // Recompute the lane mask; returns false once every lane is masked. A
+    // lane is masked by freezing its segment (mul 1, coeff 0) and smoother
+    // (coefficient 1, input 0): both recurrences then reproduce their state
+    // exactly and no end-of-segment test can fire, so the kernel needs no
+    // per-lane select. Lanes never unmask within a block.
+    bool updateLive() {
+        bool any = false;
+        for (int l = 0; l < mLaneCount; ++l) {
+            const bool live = mLive[l] != SampleType(0) && mState[mGate[l]] != kIdle;
+            if (!live && mLive[l] != SampleType(0)) {
+                mMul[l] = SampleType(1);
+                mCoeff[l] = SampleType(0);
+                mSmoothing[l] = SampleType(1);
+                mSmoothingInput[l] = SampleType(0);
+            }
+            mLive[l] = live ? SampleType(1) : SampleType(0);
+            any = any || live;
+        }
+        return any;
+    }
+
+    int mLaneCount = 0;
+
+    std::array<SampleType, kMaxLanes> mLevel{};
+    std::array<SampleType, kMaxLanes> mSmoothed{};
+    std::array<SampleType, kMaxLanes> mState{};
+    std::array<SampleType, kMaxLanes> mIsAttack{};       // 0/1 state masks
+    std::array<SampleType, kMaxLanes> mIsDecay{};
+    std::array<SampleType, kMaxLanes> mIsRelease{};
+    std::array<SampleType, kMaxLanes> mMul{};            // current segment
+    std::array<SampleType, kMaxLanes> mTarget{};
+    std::array<SampleType, kMaxLanes> mCoeff{};
+    std::array<SampleType, kMaxLanes> mSustain{};
+    std::array<SampleType, kMaxLanes> mDecayCoeff{};     // for attack -> decay
+    std::array<SampleType, kMaxLanes> mSmoothing{};
+    std::array<SampleType, kMaxLanes> mSmoothingInput{};
+    std::array<int, kMaxLanes> mGate{};
+    std::array<SampleType, kMaxLanes> mLive{};           // 1 = lane advances this sample
+    std::array<SampleType, kMaxLanes> mActiveSamples{};
+
+    // Interleaved by sample so each step stores one contiguous row of lanes
+    std::array<std::array<SampleType, kMaxLanes>, kBlockSize> mOutput{};
+};
+
+// Amp + mod envelope for each of 16 voices
+using EnvelopeBank = EnvelopeBankT<double, 32>;
+using EnvelopeBankFloat = EnvelopeBankT<float, 32>;
+
+#endif // __cplusplus
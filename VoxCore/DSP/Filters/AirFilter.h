@@ -0,0 +1,93 @@
+//
+//  AirFilter.h
+//  VoxCore
+//
+//  "Air" one-pole lowpass from ARCHITECTURE.md: y[n] = y[n-1] + a * (x[n] - y[n-1])
+//  The Air amount (0 = full brightness, 1 = full darkness) maps to a cutoff of
+//  20000 * (1 - air * 0.9) Hz, so the filter never fully closes. At air = 0 the
+//  filter is bypassed outright, keeping the default voice output unchanged.
+//
+//  Templated on sample type like the rest of the voice chain.
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+
+template <typename SampleType>
+class AirFilterT {
+public:
+    AirFilterT(double sampleRate = 44100.0)
+        : mSampleRate(sampleRate)
+    {
+        updateCoefficient();
+    }
+
+    void setSampleRate(double sampleRate) {
+        mSampleRate = sampleRate;
+        updateCoefficient();
+    }
+
+    // Air amount: 0.0 (bright, bypassed) to 1.0 (dark, ~2 kHz cutoff)
+    void setAir(double air) {
+        double clamped = std::max(0.0, std::min(1.0, air));
+        if (clamped != mAir) {
+            mAir = clamped;
+            updateCoefficient();
+        }
+    }
+
+    double getAir() const { return mAir; }
+    double getCutoffFrequency() const { return 20000.0 * (1.0 - mAir * 0.9); }
+    bool isBypassed() const { return mAir <= 0.0; }
+
+    void reset() {
+        mState = SampleType(0);
+    }
+
+    SampleType process(SampleType input) {
+        if (isBypassed()) {
+            mState = input;
+            return input;
+        }
+        mState += mCoeff * (input - mState);
+        return mState;
+    }
+
+    void processBlock(SampleType* samples, int numSamples) {
+        if (isBypassed()) {
+            if (numSamples > 0) {
+                mState = samples[numSamples - 1];
+            }
+            return;
+        }
+        SampleType state = mState;
+        const SampleType coeff = mCoeff;
+        for (int i = 0; i < numSamples; ++i) {
+            state += coeff * (samples[i] - state);
+            samples[i] = state;
+        }
+        mState = state;
+    }
+
+private:
+    void updateCoefficient() {
+        // Matched one-pole: a = 1 - e^(-2*pi*fc/fs), cutoff kept below Nyquist
+        double cutoff = std::min(getCutoffFrequency(), mSampleRate * 0.49);
+        mCoeff = static_cast<SampleType>(1.0 - std::exp(-2.0 * std::numbers::pi * cutoff / mSampleRate));
+    }
+
+    double mSampleRate;
+    double mAir = 0.0;
+    SampleType mCoeff = SampleType(1);
+    SampleType mState = SampleType(0);
+};
+
+using AirFilter = AirFilterT<double>;
+using AirFilterFloat = AirFilterT<float>;
+
+#endif // __cplusplus
@@ -5,6 +5,21 @@
 //  Dual formant (resonant bandpass) filter for vocal synthesis
 //  Uses two parallel SVF (state variable filter) bandpass filters
 //
+//  Frequency/Q setters only record targets and mark the coefficients dirty.
+//  The SVF coefficients (two tan() calls) are recomputed once, lazily, at the
+//  start of the next process()/processBlock() call, so a burst of setter calls
+//  from a parameter event costs a single update.
+//
+//  setVowelPosition() drives the filter from a 2-D vowel space (VowelSpace.h);
+//  its coefficients come from a per-sample-rate grid by bilinear lookup, so
+//  moving through the space needs no tan() evaluations. The grid is shared by
+//  every filter at that rate (VowelSpace::shared()); a filter only holds a
+//  pointer to it, so copying a filter or a voice never copies the table.
+//
+//  Templated on sample type: SVF state and coefficients are SampleType, while
+//  frequency/Q parameters stay double. FormantFilter is the double-precision
+//  reference; FormantFilterFloat is the single-precision render path.
+//
 
 #pragma once
 
@@ -14,10 +29,14 @@
 #include <algorithm>
 #include <numbers>
 
-class FormantFilter {
+#include "VowelSpace.h"
+
+template <typename SampleType>
+class FormantFilterT {
 public:
-    FormantFilter(double sampleRate = 44100.0)
+    FormantFilterT(double sampleRate = 44100.0)
         : mSampleRate(sampleRate)
+        , mVowelSpace(&VowelSpace::shared(sampleRate))
     {
         reset();
         // Initialize with default vowel 'A' formants
@@ -28,52 +47,98 @@ public:
         setFormant1Gain(1.0);
         setFormant2Gain(0.7);
         setDryGain(0.0);
+        updateCoefficients();
     }
     
     void setSampleRate(double sampleRate) {
         mSampleRate = sampleRate;
-        updateCoefficients();
+        if (mVowelSpace->getSampleRate() != sampleRate) {
+            mVowelSpace = &VowelSpace::shared(sampleRate);
+        }
+        mCoefficientsDirty = true;
     }
     
     // Set formant 1 center frequency (Hz)
     void setFormant1Frequency(double freq) {
-        mF1Freq = std::max(80.0, std::min(freq, mSampleRate * 0.45));
-        updateCoefficients();
+        double clamped = std::max(80.0, std::min(freq, mSampleRate * 0.45));
+        if (clamped != mF1Freq || mUseVowelSpace) {
+            mF1Freq = clamped;
+            mUseVowelSpace = false;  // Manual frequencies leave the vowel space
+            mCoefficientsDirty = true;
+        }
     }
     
     // Set formant 2 center frequency (Hz)
     void setFormant2Frequency(double freq) {
-        mF2Freq = std::max(80.0, std::min(freq, mSampleRate * 0.45));
-        updateCoefficients();
+        double clamped = std::max(80.0, std::min(freq, mSampleRate * 0.45));
+        if (clamped != mF2Freq || mUseVowelSpace) {
+            mF2Freq = clamped;
+            mUseVowelSpace = false;  // Manual frequencies leave the vowel space
+            mCoefficientsDirty = true;
+        }
+    }
+    
+    // Per-grain formant scatter (Hz), added to both formants at coefficient
+    // time. The voice latches this once per grain onset, so a scattered cloud
+    // recomputes coefficients at grain rate rather than per sample.
+    void setGrainFormantOffset(double hz) {
+        if (hz != mGrainOffsetHz) {
+            mGrainOffsetHz = hz;
+            mCoefficientsDirty = true;
+        }
     }
     
+    double getGrainFormantOffset() const { return mGrainOffsetHz; }
+    
+    // Modulation offsets (Hz) for F1 and F2, added at coefficient time on top
+    // of the manual, vowel morph or vowel space frequencies. Lets per-voice
+    // and global formant modulation move the formants in every mode.
+    void setFormantModulation(double f1Hz, double f2Hz) {
+        if (f1Hz != mF1ModHz || f2Hz != mF2ModHz) {
+            mF1ModHz = f1Hz;
+            mF2ModHz = f2Hz;
+            mCoefficientsDirty = true;
+        }
+    }
+    
+    double getFormant1Modulation() const { return mF1ModHz; }
+    double getFormant2Modulation() const { return mF2ModHz; }
+    
     // Set formant 1 Q (resonance/bandwidth)
     void setFormant1Q(double q) {
-        mF1Q = std::max(0.5, std::min(q, 50.0));
-        updateCoefficients();
+        double clamped = std::max(0.5, std::min(q, 50.0));
+        if (clamped != mF1Q) {
+            mF1Q = clamped;
+            mCoefficientsDirty = true;
+        }
     }
     
     // Set formant 2 Q (resonance/bandwidth)
     void setFormant2Q(double q) {
-        mF2Q = std::max(0.5, std::min(q, 50.0));
-        updateCoefficients();
+        double clamped = std::max(0.5, std::min(q, 50.0));
+        if (clamped != mF2Q) {
+            mF2Q = clamped;
+            mCoefficientsDirty = true;
+        }
     }
     
     // Set formant 1 output gain
     void setFormant1Gain(double gain) {
-        mF1Gain = std::max(0.0, std::min(gain, 2.0));
+        mF1Gain = static_cast<SampleType>(std::max(0.0, std::min(gain, 2.0)));
     }
     
     // Set formant 2 output gain
     void setFormant2Gain(double gain) {
-        mF2Gain = std::max(0.0, std::min(gain, 2.0));
+        mF2Gain = static_cast<SampleType>(std::max(0.0, std::min(gain, 2.0)));
     }
     
     // Set dry (unfiltered) signal gain
     void setDryGain(double gain) {
-        mDryGain = std::max(0.0, std::min(gain, 2.0));
+        mDryGain = static_cast<SampleType>(std::max(0.0, std::min(gain, 2.0)));
     }
     
+    SampleType getDryGain() const { return mDryGain; }
+    
     // Vowel morphing (0.0 = A, 0.25 = E, 0.5 = I, 0.75 = O, 1.0 = U)
     void setVowelMorph(double morph) {
         morph = std::max(0.0, std::min(1.0, morph));
@@ -91,7 +156,7 @@ public:
         // Interpolate between vowels
         double pos = morph * 4.0; // 0-4 for 5 vowels
         int idx1 = static_cast<int>(pos);
-        int idx2 = (idx1 + 1) % 5;
+        int idx2 = std::min(idx1 + 1, 4);
         double frac = pos - idx1;
         
         if (idx1 >= 4) {
@@ -107,55 +172,129 @@ public:
         setFormant2Frequency(f2);
     }
     
+    // 2-D vowel space position (see VowelSpace.h): x = front..back,
+    // y = close..open. Formant frequencies follow the vowel chart and the SVF
+    // gains come from the precomputed grid.
+    void setVowelPosition(double x, double y) {
+        x = std::max(0.0, std::min(1.0, x));
+        y = std::max(0.0, std::min(1.0, y));
+        if (!mUseVowelSpace || x != mVowelX || y != mVowelY) {
+            mUseVowelSpace = true;
+            mVowelX = x;
+            mVowelY = y;
+            VowelSpace::frequenciesAt(x, y, mF1Freq, mF2Freq);
+            mCoefficientsDirty = true;
+        }
+    }
+    
+    bool isUsingVowelSpace() const { return mUseVowelSpace; }
+    double getVowelX() const { return mVowelX; }
+    double getVowelY() const { return mVowelY; }
+    
+    // Recompute SVF coefficients if any setter has run since the last update.
+    // Called automatically by process()/processBlock(); exposed so callers can
+    // hoist the update to a block boundary explicitly.
+    void updateCoefficientsIfNeeded() {
+        if (mCoefficientsDirty) {
+            updateCoefficients();
+        }
+    }
+    
+    bool needsCoefficientUpdate() const { return mCoefficientsDirty; }
+    
+    double getFormant1Frequency() const { return mF1Freq; }
+    double getFormant2Frequency() const { return mF2Freq; }
+    double getFormant1Q() const { return mF1Q; }
+    double getFormant2Q() const { return mF2Q; }
+    
     void reset() {
         // Reset SVF state for both formants
-        mF1_ic1eq = 0.0;
-        mF1_ic2eq = 0.0;
-        mF2_ic1eq = 0.0;
-        mF2_ic2eq = 0.0;
+        mF1_ic1eq = SampleType(0);
+        mF1_ic2eq = SampleType(0);
+        mF2_ic1eq = SampleType(0);
+        mF2_ic2eq = SampleType(0);
     }
     
     // Process a single sample
-    double process(double input) {
-        // Formant 1 - SVF bandpass
-        double v1_1 = mF1_a1 * mF1_ic1eq + mF1_a2 * (input - mF1_ic2eq);
-        double v2_1 = mF1_ic2eq + mF1_a2 * mF1_ic1eq + mF1_a3 * (input - mF1_ic2eq);
-        mF1_ic1eq = 2.0 * v1_1 - mF1_ic1eq;
-        mF1_ic2eq = 2.0 * v2_1 - mF1_ic2eq;
-        double bp1 = v1_1;
-        
-        // Formant 2 - SVF bandpass
-        double v1_2 = mF2_a1 * mF2_ic1eq + mF2_a2 * (input - mF2_ic2eq);
-        double v2_2 = mF2_ic2eq + mF2_a2 * mF2_ic1eq + mF2_a3 * (input - mF2_ic2eq);
-        mF2_ic1eq = 2.0 * v1_2 - mF2_ic1eq;
-        mF2_ic2eq = 2.0 * v2_2 - mF2_ic2eq;
-        double bp2 = v1_2;
-        
-        // Mix formants and dry signal
-        return bp1 * mF1Gain + bp2 * mF2Gain + input * mDryGain;
+    SampleType process(SampleType input) {
+        updateCoefficientsIfNeeded();
+        return processSample(input);
     }
     
-    void processBlock(double* samples, int numSamples) {
+    void processBlock(SampleType* samples, int numSamples) {
+        updateCoefficientsIfNeeded();
         for (int i = 0; i < numSamples; ++i) {
-            samples[i] = process(samples[i]);
+            samples[i] = processSample(samples[i]);
         }
     }
     
+    // Formant bands only (F1 + F2, no dry path). For callers that apply the
+    // dry mix themselves, e.g. VoxVoice's fused output stage:
+    // process(x) == processWet(x) + x * getDryGain()
+    SampleType processWet(SampleType input) {
+        updateCoefficientsIfNeeded();
+        return processBands(input);
+    }
+    
 private:
+    // Process a single sample with the current coefficients (no dirty check)
+    SampleType processSample(SampleType input) {
+        return processBands(input) + input * mDryGain;
+    }
+    
+    SampleType processBands(SampleType input) {
+        // Formant 1 - SVF bandpass
+        SampleType v1_1 = mF1_a1 * mF1_ic1eq + mF1_a2 * (input - mF1_ic2eq);
+        SampleType v2_1 = mF1_ic2eq + mF1_a2 * mF1_ic1eq + mF1_a3 * (input - mF1_ic2eq);
+        mF1_ic1eq = SampleType(2) * v1_1 - mF1_ic1eq;
+        mF1_ic2eq = SampleType(2) * v2_1 - mF1_ic2eq;
+        SampleType bp1 = v1_1;
+        
+        // Formant 2 - SVF bandpass
+        SampleType v1_2 = mF2_a1 * mF2_ic1eq + mF2_a2 * (input - mF2_ic2eq);
+        SampleType v2_2 = mF2_ic2eq + mF2_a2 * mF2_ic1eq + mF2_a3 * (input - mF2_ic2eq);
+        mF2_ic1eq = SampleType(2) * v1_2 - mF2_ic1eq;
+        mF2_ic2eq = SampleType(2) * v2_2 - mF2_ic2eq;
+        SampleType bp2 = v1_2;
+        
+        // Mix formants (dry signal is added by the caller)
+        return bp1 * mF1Gain + bp2 * mF2Gain;
+    }
+    
     void updateCoefficients() {
+        double g1, g2;
+        const double offset1 = mGrainOffsetHz + mF1ModHz;
+        const double offset2 = mGrainOffsetHz + mF2ModHz;
+        if (mUseVowelSpace && offset1 == 0.0 && offset2 == 0.0) {
+            // Vowel space: bilinear lookup in the precomputed gain grid
+            mVowelSpace->gainsAt(mVowelX, mVowelY, g1, g2);
+        } else {
+            double maxFreq = mSampleRate * 0.45;
+            double f1 = mF1Freq;
+            double f2 = mF2Freq;
+            if (offset1 != 0.0 || offset2 != 0.0) {
+                f1 = std::max(80.0, std::min(f1 + offset1, maxFreq));
+                f2 = std::max(80.0, std::min(f2 + offset2, maxFreq));
+            }
+            g1 = std::tan(std::numbers::pi * f1 / mSampleRate);
+            g2 = std::tan(std::numbers::pi * f2 / mSampleRate);
+        }
+        
         // SVF coefficients for formant 1
-        double g1 = std::tan(std::numbers::pi * mF1Freq / mSampleRate);
         double k1 = 1.0 / mF1Q;
-        mF1_a1 = 1.0 / (1.0 + g1 * (g1 + k1));
-        mF1_a2 = g1 * mF1_a1;
-        mF1_a3 = g1 * mF1_a2;
+        double a1 = 1.0 / (1.0 + g1 * (g1 + k1));
+        mF1_a1 = static_cast<SampleType>(a1);
+        mF1_a2 = static_cast<SampleType>(g1 * a1);
+        mF1_a3 = static_cast<SampleType>(g1 * (g1 * a1));
         
         // SVF coefficients for formant 2
-        double g2 = std::tan(std::numbers::pi * mF2Freq / mSampleRate);
         double k2 = 1.0 / mF2Q;
-        mF2_a1 = 1.0 / (1.0 + g2 * (g2 + k2));
-        mF2_a2 = g2 * mF2_a1;
-        mF2_a3 = g2 * mF2_a2;
+        double a2 = 1.0 / (1.0 + g2 * (g2 + k2));
+        mF2_a1 = static_cast<SampleType>(a2);
+        mF2_a2 = static_cast<SampleType>(g2 * a2);
+        mF2_a3 = static_cast<SampleType>(g2 * (g2 * a2));
+        
+        mCoefficientsDirty = false;
     }
     
     double mSampleRate;
@@ -165,17 +304,30 @@ private:
     double mF2Freq = 1200.0;
     double mF1Q = 10.0;
     double mF2Q = 10.0;
-    double mF1Gain = 1.0;
-    double mF2Gain = 0.7;
-    double mDryGain = 0.0;
+    double mGrainOffsetHz = 0.0;
+    double mF1ModHz = 0.0;              // Modulation offsets
+    double mF2ModHz = 0.0;
+    SampleType mF1Gain = SampleType(1.0);
+    SampleType mF2Gain = SampleType(0.7);
+    SampleType mDryGain = SampleType(0);
+    bool mCoefficientsDirty = true;
+    
+    // 2-D vowel space
+    const VowelSpace* mVowelSpace;   // Shared grid for mSampleRate
+    bool mUseVowelSpace = false;
+    double mVowelX = 0.5;
+    double mVowelY = 1.0;
     
     // SVF coefficients for formant 1
-    double mF1_a1 = 0.0, mF1_a2 = 0.0, mF1_a3 = 0.0;
-    double mF1_ic1eq = 0.0, mF1_ic2eq = 0.0;
+    SampleType mF1_a1 = 0, mF1_a2 = 0, mF1_a3 = 0;
+    SampleType mF1_ic1eq = 0, mF1_ic2eq = 0;
     
     // SVF coefficients for formant 2
-    double mF2_a1 = 0.0, mF2_a2 = 0.0, mF2_a3 = 0.0;
-    double mF2_ic1eq = 0.0, mF2_ic2eq = 0.0;
+    SampleType mF2_a1 = 0, mF2_a2 = 0, mF2_a3 = 0;
+    SampleType mF2_ic1eq = 0, mF2_ic2eq = 0;
 };
 
+using FormantFilter = FormantFilterT<double>;
+using FormantFilterFloat = FormantFilterT<float>;
+
 #endif // __cplusplus
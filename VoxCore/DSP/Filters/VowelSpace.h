@@ -0,0 +1,131 @@
+//
+//  VowelSpace.h
+//  VoxCore
+//
+//  Two-dimensional vowel space (F1/F2 vowel chart) for the formant filter.
+//
+//  X axis = tongue position:  0.0 = front (I, E)   ... 1.0 = back (U, O)
+//  Y axis = openness:         0.0 = close (I, U)   ... 1.0 = open (A)
+//
+//  Formant frequencies are bilinear between a 3x3 grid of anchor vowels
+//  (close/mid/open x front/central/back). For rendering, the space is
+//  resampled once per sample rate into a kGridSize x kGridSize grid of SVF
+//  prewarp gains g = tan(pi * f / fs), so moving through the space costs a
+//  bilinear lookup instead of two tan() calls.
+//
+//  The grid only depends on the sample rate, so filters don't own one:
+//  shared() builds a grid the first time a rate is asked for and hands every
+//  later caller the same read-only instance.
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class VowelSpace {
+public:
+    static constexpr int kAnchors = 3;
+    static constexpr int kGridSize = 17;
+
+    // Anchor formants [openness][backness] in Hz. The A, E, I, O, U entries
+    // match the 1-D vowel morph table; the rest fill in the chart.
+    // (x, y): I = (0, 0), U = (1, 0), E = (0, 0.5), O = (1, 0.5), A = (0.5, 1)
+    static constexpr double kAnchorF1[kAnchors][kAnchors] = {
+        { 300.0, 320.0, 350.0 },    // close:  I, barred-i, U
+        { 400.0, 500.0, 500.0 },    // mid:    E, schwa, O
+        { 750.0, 800.0, 700.0 }     // open:   ae, A, script-a
+    };
+    static constexpr double kAnchorF2[kAnchors][kAnchors] = {
+        { 2700.0, 1650.0,  700.0 },
+        { 2200.0, 1500.0,  800.0 },
+        { 1750.0, 1200.0, 1000.0 }
+    };
+
+    // Exact (piecewise bilinear) formant frequencies at a point in the space
+    static void frequenciesAt(double x, double y, double& f1, double& f2) {
+        double fx = std::clamp(x, 0.0, 1.0) * (kAnchors - 1);
+        double fy = std::clamp(y, 0.0, 1.0) * (kAnchors - 1);
+        int i = std::min(static_cast<int>(fx), kAnchors - 2);
+        int j = std::min(static_cast<int>(fy), kAnchors - 2);
+        double tx = fx - i;
+        double ty = fy - j;
+        f1 = bilinear(kAnchorF1[j][i], kAnchorF1[j][i + 1], kAnchorF1[j + 1][i], kAnchorF1[j + 1][i + 1], tx, ty);
+        f2 = bilinear(kAnchorF2[j][i], kAnchorF2[j][i + 1], kAnchorF2[j + 1][i], kAnchorF2[j + 1][i + 1], tx, ty);
+    }
+
+    // Grid for a sample rate, built on first use and kept for the life of the
+    // process (one per distinct rate). Takes a lock; not for the render
+    // thread.
+    static const VowelSpace& shared(double sampleRate) {
+        static std::mutex mutex;
+        static std::vector<std::unique_ptr<VowelSpace>> grids;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& grid : grids) {
+            if (grid->getSampleRate() == sampleRate) {
+                return *grid;
+            }
+        }
+        grids.push_back(std::make_unique<VowelSpace>(sampleRate));
+        return *grids.back();
+    }
+
+    VowelSpace(double sampleRate = 44100.0) {
+        setSampleRate(sampleRate);
+    }
+
+    // Rebuild the coefficient grid (2 * kGridSize^2 tan() calls). Not for the
+    // render thread.
+    void setSampleRate(double sampleRate) {
+        if (sampleRate == mSampleRate) {
+            return;
+        }
+        mSampleRate = sampleRate;
+        const double maxFreq = sampleRate * 0.45;
+        for (int j = 0; j < kGridSize; ++j) {
+            for (int i = 0; i < kGridSize; ++i) {
+                double f1, f2;
+                frequenciesAt(static_cast<double>(i) / (kGridSize - 1),
+                              static_cast<double>(j) / (kGridSize - 1), f1, f2);
+                f1 = std::max(80.0, std::min(f1, maxFreq));
+                f2 = std::max(80.0, std::min(f2, maxFreq));
+                mG1[j][i] = std::tan(std::numbers::pi * f1 / sampleRate);
+                mG2[j][i] = std::tan(std::numbers::pi * f2 / sampleRate);
+            }
+        }
+    }
+
+    double getSampleRate() const { return mSampleRate; }
+
+    // Bilinear lookup of the SVF prewarp gains at (x, y)
+    void gainsAt(double x, double y, double& g1, double& g2) const {
+        double fx = std::clamp(x, 0.0, 1.0) * (kGridSize - 1);
+        double fy = std::clamp(y, 0.0, 1.0) * (kGridSize - 1);
+        int i = std::min(static_cast<int>(fx), kGridSize - 2);
+        int j = std::min(static_cast<int>(fy), kGridSize - 2);
+        double tx = fx - i;
+        double ty = fy - j;
+        g1 = bilinear(mG1[j][i], mG1[j][i + 1], mG1[j + 1][i], mG1[j + 1][i + 1], tx, ty);
+        g2 = bilinear(mG2[j][i], mG2[j][i + 1], mG2[j + 1][i], mG2[j + 1][i + 1], tx, ty);
+    }
+
+private:
+    static double bilinear(double v00, double v10, double v01, double v11, double tx, double ty) {
+        double top = v00 + (v10 - v00) * tx;
+        double bottom = v01 + (v11 - v01) * tx;
+        return top + (bottom - top) * ty;
+    }
+
+    double mSampleRate = 0.0;
+    std::array<std::array<double, kGridSize>, kGridSize> mG1{};
+    std::array<std::array<double, kGridSize>, kGridSize> mG2{};
+};
+
+#endif // __cplusplus
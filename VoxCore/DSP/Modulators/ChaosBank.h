@@ -0,0 +1,300 @@
+//
+//  ChaosBank.h
+//  VoxCore
+//
+//  Per-voice chaos (structure of arrays)
+//
+//  One attractor state vector per voice: the x, y and z of every lane live
+//  in their own arrays and each RK4 step runs as one loop over lanes, so a
+//  tick of sixteen Lorenz (or Rössler) voices is a single vectorizable
+//  update instead of sixteen scalar ChaosGenerators. Henon lanes iterate the
+//  map on their own staggered clocks, like the scalar generator's phase
+//  accumulator.
+//
+//  Lanes share type, output channel and rate, and use the standard attractor
+//  parameters. The integration, step caps and output normalization are the
+//  scalar generator's (ChaosGenerator::rk4Step, kMaxLorenzStep, ...), and
+//  the output goes through the same 0.01-per-sample smoother, applied per
+//  tick. seed() scatters the lanes' starting points, so the voices are on
+//  different parts of the attractor from the first tick.
+//
+//  Usage: process(samples) once per tick, then getValue(lane) in [-1, 1].
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include "ChaosGenerator.h"
+#include "DSPUtilities.h"
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+template <int MaxLanes>
+class ChaosBankT {
+public:
+    using ChaosType = ChaosGenerator::ChaosType;
+    using Output = ChaosGenerator::Output;
+
+    static constexpr int kMaxLanes = MaxLanes;
+
+    ChaosBankT(double sampleRate = 44100.0) {
+        setSampleRate(sampleRate);
+        seed(0);
+    }
+
+    void setSampleRate(double sampleRate) {
+        mSampleRate = sampleRate;
+        updateTimeStep();
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // Parameters (shared by all lanes)
+    // ═══════════════════════════════════════════════════════════════
+
+    // Changing the type restarts every lane on the new attractor
+    void setType(ChaosType type) {
+        if (type != mType) {
+            mType = type;
+            reset();
+        }
+    }
+
+    ChaosType getType() const {
+        return mType;
+    }
+
+    void setOutput(Output output) {
+        mOutput = output;
+    }
+
+    Output getOutput() const {
+        return mOutput;
+    }
+
+    // Rate: speed of evolution (0.1 to 10.0), as ChaosGenerator::setRate
+    void setRate(double rate) {
+        mRate = std::max(0.1, std::min(10.0, rate));
+        updateTimeStep();
+    }
+
+    double getRate() const {
+        return mRate;
+    }
+
+    // Lanes advanced by process(); lanes past the count hold their state
+    void setLaneCount(int count) {
+        mLaneCount = std::max(0, std::min(kMaxLanes, count));
+    }
+
+    int getLaneCount() const {
+        return mLaneCount;
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // Processing
+    // ═══════════════════════════════════════════════════════════════
+
+    // Give every lane its own random stream (derived from seedValue) and
+    // scatter the starting points
+    void seed(uint64_t seedValue) {
+        for (int lane = 0; lane < kMaxLanes; ++lane) {
+            mRandom[lane].setSeed(seedValue * kMaxLanes + static_cast<uint64_t>(lane));
+        }
+        reset();
+    }
+
+    void reset() {
+        for (int lane = 0; lane < kMaxLanes; ++lane) {
+            restartLane(lane);
+            mValue[lane] = 0.0;
+        }
+    }
+
+    // Advance every lane by samples samples (one control tick)
+    void process(int samples) {
+        if (samples != mTickSamples) {
+            mTickSamples = samples;
+            mTickSmoothingCoeff = 1.0 - std::pow(1.0 - kSmoothingCoeff, samples);
+        }
+
+        switch (mType) {
+            case ChaosType::Lorenz:
+                processLorenz(mTimeStep * samples);
+                break;
+            case ChaosType::Henon:
+                processHenon(mHenonPhaseInc * samples);
+                break;
+            case ChaosType::Rossler:
+                processRossler(mRosslerTimeStep * samples);
+                break;
+        }
+
+        const int n = mLaneCount;
+        const double coeff = mTickSmoothingCoeff;
+        for (int lane = 0; lane < n; ++lane) {
+            mValue[lane] += (mRaw[lane] - mValue[lane]) * coeff;
+        }
+    }
+
+    // Lane value in [-1, 1]
+    double getValue(int lane) const {
+        return mValue[lane];
+    }
+
+    // Lane state (for visualization and tests)
+    void getLaneState(int lane, double& x, double& y, double& z) const {
+        x = mX[lane];
+        y = mY[lane];
+        z = mZ[lane];
+    }
+
+private:
+    void processLorenz(double dt) {
+        auto lorenz = [](double x, double y, double z, double& dx, double& dy, double& dz) {
+            dx = kSigma * (y - x);
+            dy = x * (kRho - z) - y;
+            dz = x * y - kBeta * z;
+        };
+        integrate(dt, ChaosGenerator::kMaxLorenzStep, lorenz);
+
+        const int n = mLaneCount;
+        for (int lane = 0; lane < n; ++lane) {
+            mRaw[lane] = ChaosGenerator::lorenzOutput(mOutput, mX[lane], mY[lane], mZ[lane]);
+        }
+    }
+
+    void processRossler(double dt) {
+        auto rossler = [](double x, double y, double z, double& dx, double& dy, double& dz) {
+            dx = -y - z;
+            dy = x + kRosslerA * y;
+            dz = kRosslerB + z * (x - kRosslerC);
+        };
+        integrate(dt, ChaosGenerator::kMaxRosslerStep, rossler);
+
+        const int n = mLaneCount;
+        for (int lane = 0; lane < n; ++lane) {
+            mRaw[lane] = ChaosGenerator::rosslerOutput(mOutput, mX[lane], mY[lane], mZ[lane]);
+        }
+    }
+
+    // RK4 steps of at most maxStep, each one loop over all lanes; lanes that
+    // diverged restart afterwards
+    template <typename Derivative>
+    void integrate(double dt, double maxStep, Derivative derivative) {
+        const int n = mLaneCount;
+        const int steps = ChaosGenerator::integrationSteps(dt, maxStep);
+        const double h = dt / steps;
+        for (int i = 0; i < steps; ++i) {
+            for (int lane = 0; lane < n; ++lane) {
+                ChaosGenerator::rk4Step(mX[lane], mY[lane], mZ[lane], h, derivative);
+            }
+        }
+        for (int lane = 0; lane < n; ++lane) {
+            if (!std::isfinite(mX[lane] + mY[lane] + mZ[lane])) {
+                restartLane(lane);
+            }
+        }
+    }
+
+    // Map iterations on each lane's own clock, then linear interpolation
+    // between the last two iterations (z holds the previous x, the
+    // interpolation start)
+    void processHenon(double increment) {
+        const int n = mLaneCount;
+        for (int lane = 0; lane < n; ++lane) {
+            double phase = mHenonPhase[lane] + increment;
+            while (phase >= 1.0) {
+                phase -= 1.0;
+                mZ[lane] = mX[lane];
+                mHenonPrevY[lane] = mY[lane];
+                double x = 1.0 - kHenonA * mX[lane] * mX[lane] + mY[lane];
+                double y = kHenonB * mX[lane];
+                if (std::abs(x) > 10.0 || std::abs(y) > 10.0) {
+                    x = 0.1;
+                    y = 0.1;
+                }
+                mX[lane] = x;
+                mY[lane] = y;
+            }
+            mHenonPhase[lane] = phase;
+        }
+        for (int lane = 0; lane < n; ++lane) {
+            double t = mHenonPhase[lane];
+            double x = mZ[lane] + t * (mX[lane] - mZ[lane]);
+            double y = mHenonPrevY[lane] + t * (mY[lane] - mHenonPrevY[lane]);
+            mRaw[lane] = ChaosGenerator::henonOutput(mOutput, x, y);
+        }
+    }
+
+    // Random starting point near the active attractor
+    void restartLane(int lane) {
+        FastRandom& random = mRandom[lane];
+        switch (mType) {
+            case ChaosType::Lorenz:
+                mX[lane] = random.nextBipolar() * 10.0;
+                mY[lane] = random.nextBipolar() * 10.0;
+                mZ[lane] = 25.0 + random.nextBipolar() * 10.0;
+                break;
+            case ChaosType::Henon:
+                mX[lane] = 0.1 + random.nextBipolar() * 0.3;
+                mY[lane] = 0.1 + random.nextBipolar() * 0.1;
+                mZ[lane] = mX[lane];
+                mHenonPrevY[lane] = mY[lane];
+                mHenonPhase[lane] = random.nextUnipolar();
+                break;
+            case ChaosType::Rossler:
+                mX[lane] = random.nextBipolar() * 5.0;
+                mY[lane] = random.nextBipolar() * 5.0;
+                mZ[lane] = 0.0;
+                break;
+        }
+        mRaw[lane] = 0.0;
+    }
+
+    void updateTimeStep() {
+        // Same time scales as ChaosGenerator::updateTimeStep()
+        mTimeStep = (mRate * 0.01) / mSampleRate * 1000.0;
+        mRosslerTimeStep = mTimeStep * 6.0;
+        mHenonPhaseInc = (mRate * 30.0) / mSampleRate;
+    }
+
+    // Standard parameters (ChaosGenerator defaults)
+    static constexpr double kSigma = 10.0;
+    static constexpr double kRho = 28.0;
+    static constexpr double kBeta = 8.0 / 3.0;
+    static constexpr double kHenonA = 1.4;
+    static constexpr double kHenonB = 0.3;
+    static constexpr double kRosslerA = 0.2;
+    static constexpr double kRosslerB = 0.2;
+    static constexpr double kRosslerC = 5.7;
+    static constexpr double kSmoothingCoeff = 0.01;
+
+    double mSampleRate = 44100.0;
+    ChaosType mType = ChaosType::Lorenz;
+    Output mOutput = Output::X;
+    double mRate = 1.0;
+    int mLaneCount = kMaxLanes;
+
+    double mTimeStep = 0.0;
+    double mRosslerTimeStep = 0.0;
+    double mHenonPhaseInc = 0.0;
+    int mTickSamples = 1;
+    double mTickSmoothingCoeff = kSmoothingCoeff;
+
+    // Lane state
+    std::array<double, kMaxLanes> mX{};
+    std::array<double, kMaxLanes> mY{};
+    std::array<double, kMaxLanes> mZ{};
+    std::array<double, kMaxLanes> mHenonPrevY{};
+    std::array<double, kMaxLanes> mHenonPhase{};
+    std::array<double, kMaxLanes> mRaw{};
+    std::array<double, kMaxLanes> mValue{};
+    std::array<FastRandom, kMaxLanes> mRandom;
+};
+
+using ChaosBank = ChaosBankT<16>;
+
+#endif // __cplusplus
@@ -14,6 +14,17 @@
 //    x[n+1] = 1 - ax² + y
 //    y[n+1] = bx
 //
+//  Rössler Attractor: Lazy spiral with occasional bursts
+//    dx/dt = -y - z
+//    dy/dt = x + ay
+//    dz/dt = b + z(x - c)
+//
+//  Control-rate mode (setControlRate): the attractor advances once per N
+//  samples by N samples' worth of time, split into RK4 steps no longer than
+//  the attractor's stable step (kMaxLorenzStep, kMaxRosslerStep), and the
+//  output is Catmull-Rom interpolated between ticks (see ControlCubicT).
+//  The divergence check runs once per tick.
+//
 
 #pragma once
 
@@ -22,15 +33,22 @@
 #include <cmath>
 #include <algorithm>
 #include <random>
+#include "ControlRate.h"
 
 class ChaosGenerator {
 public:
     enum class ChaosType {
         Lorenz,  // Smooth, continuous chaos
-        Henon    // Snappy, rhythmic chaos
+        Henon,   // Snappy, rhythmic chaos
+        Rossler  // Slow spiral with bursts
     };
     
-    // Output channels (for Lorenz, which has 3D state)
+    // Longest RK4 steps (attractor time units) the flows are integrated
+    // with; Rössler evolves ~6x slower than Lorenz so it tolerates ~6x more
+    static constexpr double kMaxLorenzStep = 0.01;
+    static constexpr double kMaxRosslerStep = 0.06;
+    
+    // Output channels (for Lorenz and Rössler, which have 3D state)
     enum class Output {
         X,
         Y,
@@ -59,6 +77,14 @@ public:
         // Henon parameters (standard chaotic regime)
         , mHenonA(1.4)
         , mHenonB(0.3)
+        // Rössler state
+        , mRosslerX(1.0)
+        , mRosslerY(0.0)
+        , mRosslerZ(0.0)
+        // Rössler parameters (standard chaotic regime)
+        , mRosslerA(0.2)
+        , mRosslerB(0.2)
+        , mRosslerC(5.7)
         // Output
         , mCurrentValue(0.0)
         , mSmoothedValue(0.0)
@@ -72,6 +98,8 @@ public:
         mLorenzZ += dist(gen);
         mHenonX += dist(gen);
         mHenonY += dist(gen);
+        mRosslerX += dist(gen);
+        mRosslerY += dist(gen);
         
         updateTimeStep();
     }
@@ -129,6 +157,19 @@ public:
         return mBlend;
     }
     
+    // Samples per control tick (1 = audio rate); see ControlRate.h
+    void setControlRate(int samplesPerTick) {
+        int clamped = ControlRate::clampSamples(samplesPerTick);
+        if (clamped != mControlRate) {
+            mControlRate = clamped;
+            mInterpolator.reset(mCurrentValue);
+        }
+    }
+    
+    int getControlRate() const {
+        return mControlRate;
+    }
+    
     // ═══════════════════════════════════════════════════════════════
     // Lorenz Parameters (advanced)
     // ═══════════════════════════════════════════════════════════════
@@ -157,6 +198,106 @@ public:
         mHenonB = std::max(0.1, std::min(0.5, b));
     }
     
+    // ═══════════════════════════════════════════════════════════════
+    // Rössler Parameters (advanced)
+    // ═══════════════════════════════════════════════════════════════
+    
+    void setRosslerA(double a) {
+        mRosslerA = std::max(0.05, std::min(0.3, a));
+    }
+    
+    void setRosslerB(double b) {
+        mRosslerB = std::max(0.05, std::min(2.0, b));
+    }
+    
+    void setRosslerC(double c) {
+        mRosslerC = std::max(2.0, std::min(10.0, c));
+    }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Integration and Normalization (shared with ChaosBankT)
+    // ═══════════════════════════════════════════════════════════════
+    
+    // Lorenz attractor typical ranges: x,y in [-20, 20], z in [0, 50]
+    static double lorenzOutput(Output output, double x, double y, double z) {
+        double value;
+        switch (output) {
+            case Output::X:
+                value = x / 20.0;
+                break;
+            case Output::Y:
+                value = y / 20.0;
+                break;
+            case Output::Z:
+                value = (z - 25.0) / 25.0;  // Center around 25
+                break;
+            case Output::XY_Mix:
+            default:
+                value = (x + y) / 40.0;
+                break;
+        }
+        return std::max(-1.0, std::min(1.0, value));
+    }
+    
+    // Henon attractor range is roughly [-1.5, 1.5]
+    static double henonOutput(Output output, double x, double y) {
+        double value;
+        switch (output) {
+            case Output::X:
+                value = x / 1.5;
+                break;
+            case Output::Y:
+                value = y / 0.5;  // Y has smaller range
+                break;
+            case Output::Z:
+            case Output::XY_Mix:
+            default:
+                value = (x + y * 2.0) / 2.5;
+                break;
+        }
+        return std::max(-1.0, std::min(1.0, value));
+    }
+    
+    // Rössler typical ranges: x in [-10, 12], y in [-11, 8], z in [0, 23]
+    // with z near zero except during bursts
+    static double rosslerOutput(Output output, double x, double y, double z) {
+        double value;
+        switch (output) {
+            case Output::X:
+                value = x / 11.0;
+                break;
+            case Output::Y:
+                value = y / 11.0;
+                break;
+            case Output::Z:
+                value = z / 11.5 - 1.0;
+                break;
+            case Output::XY_Mix:
+            default:
+                value = (x + y) / 22.0;
+                break;
+        }
+        return std::max(-1.0, std::min(1.0, value));
+    }
+    
+    // Number of RK4 steps needed to cover dt without exceeding maxStep
+    static int integrationSteps(double dt, double maxStep) {
+        return dt > maxStep ? static_cast<int>(std::ceil(dt / maxStep)) : 1;
+    }
+    
+    // One Runge-Kutta 4th order step of a 3-D flow, derivative(x, y, z, dx, dy, dz)
+    template <typename Derivative>
+    static void rk4Step(double& x, double& y, double& z, double dt, Derivative derivative) {
+        double k1x, k1y, k1z, k2x, k2y, k2z, k3x, k3y, k3z, k4x, k4y, k4z;
+        derivative(x, y, z, k1x, k1y, k1z);
+        derivative(x + 0.5 * dt * k1x, y + 0.5 * dt * k1y, z + 0.5 * dt * k1z, k2x, k2y, k2z);
+        derivative(x + 0.5 * dt * k2x, y + 0.5 * dt * k2y, z + 0.5 * dt * k2z, k3x, k3y, k3z);
+        derivative(x + dt * k3x, y + dt * k3y, z + dt * k3z, k4x, k4y, k4z);
+        x += (dt / 6.0) * (k1x + 2*k2x + 2*k3x + k4x);
+        y += (dt / 6.0) * (k1y + 2*k2y + 2*k3y + k4y);
+        z += (dt / 6.0) * (k1z + 2*k2z + 2*k3z + k4z);
+    }
+    
     // ═══════════════════════════════════════════════════════════════
     // Processing
     // ═══════════════════════════════════════════════════════════════
@@ -172,31 +313,26 @@ public:
         mLorenzZ = 0.0 + dist(gen);
         mHenonX = 0.1 + dist(gen);
         mHenonY = 0.1 + dist(gen);
+        mRosslerX = 1.0 + dist(gen);
+        mRosslerY = 0.0 + dist(gen);
+        mRosslerZ = 0.0;
         mCurrentValue = 0.0;
         mSmoothedValue = 0.0;
+        mInterpolator.reset(0.0);
     }
     
     // Process one sample, returns value in range [-1, 1] * amount * blend
     double process() {
-        double rawValue = 0.0;
-        
-        switch (mType) {
-            case ChaosType::Lorenz:
-                rawValue = processLorenz();
-                break;
-            case ChaosType::Henon:
-                rawValue = processHenon();
-                break;
-        }
-        
-        // Check for numerical issues
-        if (!std::isfinite(rawValue)) {
-            reset();
-            rawValue = 0.0;
+        if (mControlRate > ControlRate::kAudioRate) {
+            if (mInterpolator.needsTick()) {
+                mInterpolator.pushTarget(tick(mControlRate), mControlRate);
+            }
+            // Catmull-Rom can overshoot the tick values slightly
+            mCurrentValue = std::max(-1.0, std::min(1.0, mInterpolator.next()));
+        } else {
+            mCurrentValue = tick(1);
         }
         
-        mCurrentValue = rawValue;
-        
         // Light smoothing to reduce harsh transitions
         double smoothingCoeff = 0.01;
         mSmoothedValue += (mCurrentValue - mSmoothedValue) * smoothingCoeff;
@@ -227,82 +363,71 @@ public:
         y = mHenonY;
     }
     
+    // Get Rössler state (for visualization)
+    void getRosslerState(double& x, double& y, double& z) const {
+        x = mRosslerX;
+        y = mRosslerY;
+        z = mRosslerZ;
+    }
+    
     // Check if state is valid (no NaN/Inf)
     bool isStateValid() const {
         return std::isfinite(mLorenzX) && std::isfinite(mLorenzY) && 
                std::isfinite(mLorenzZ) && std::isfinite(mHenonX) && 
-               std::isfinite(mHenonY);
+               std::isfinite(mHenonY) && std::isfinite(mRosslerX) &&
+               std::isfinite(mRosslerY) && std::isfinite(mRosslerZ);
     }
     
 private:
-    double processLorenz() {
-        // Runge-Kutta 4th order integration for stability
-        double x = mLorenzX, y = mLorenzY, z = mLorenzZ;
-        double dt = mTimeStep;
-        
-        // k1
-        double k1x = mSigma * (y - x);
-        double k1y = x * (mRho - z) - y;
-        double k1z = x * y - mBeta * z;
-        
-        // k2
-        double x2 = x + 0.5 * dt * k1x;
-        double y2 = y + 0.5 * dt * k1y;
-        double z2 = z + 0.5 * dt * k1z;
-        double k2x = mSigma * (y2 - x2);
-        double k2y = x2 * (mRho - z2) - y2;
-        double k2z = x2 * y2 - mBeta * z2;
-        
-        // k3
-        double x3 = x + 0.5 * dt * k2x;
-        double y3 = y + 0.5 * dt * k2y;
-        double z3 = z + 0.5 * dt * k2z;
-        double k3x = mSigma * (y3 - x3);
-        double k3y = x3 * (mRho - z3) - y3;
-        double k3z = x3 * y3 - mBeta * z3;
-        
-        // k4
-        double x4 = x + dt * k3x;
-        double y4 = y + dt * k3y;
-        double z4 = z + dt * k3z;
-        double k4x = mSigma * (y4 - x4);
-        double k4y = x4 * (mRho - z4) - y4;
-        double k4z = x4 * y4 - mBeta * z4;
-        
-        // Update state
-        mLorenzX = x + (dt / 6.0) * (k1x + 2*k2x + 2*k3x + k4x);
-        mLorenzY = y + (dt / 6.0) * (k1y + 2*k2y + 2*k3y + k4y);
-        mLorenzZ = z + (dt / 6.0) * (k1z + 2*k2z + 2*k3z + k4z);
+    // Advance the active attractor by samples' worth of time and return its
+    // normalized output, resetting if the state has diverged
+    double tick(int samples) {
+        double rawValue = 0.0;
         
-        // Normalize output to [-1, 1]
-        // Lorenz attractor typical ranges: x,y in [-20, 20], z in [0, 50]
-        double output;
-        switch (mOutput) {
-            case Output::X:
-                output = mLorenzX / 20.0;
-                break;
-            case Output::Y:
-                output = mLorenzY / 20.0;
+        switch (mType) {
+            case ChaosType::Lorenz:
+                rawValue = processLorenz(mTimeStep * samples);
                 break;
-            case Output::Z:
-                output = (mLorenzZ - 25.0) / 25.0;  // Center around 25
+            case ChaosType::Henon:
+                rawValue = processHenon(mHenonPhaseInc * samples);
                 break;
-            case Output::XY_Mix:
-            default:
-                output = (mLorenzX + mLorenzY) / 40.0;
+            case ChaosType::Rossler:
+                rawValue = processRossler(mRosslerTimeStep * samples);
                 break;
         }
         
-        return std::max(-1.0, std::min(1.0, output));
+        // Check for numerical issues
+        if (!std::isfinite(rawValue)) {
+            reset();
+            rawValue = 0.0;
+        }
+        return rawValue;
+    }
+    
+    double processLorenz(double dt) {
+        // Runge-Kutta 4th order integration for stability
+        const double sigma = mSigma, rho = mRho, beta = mBeta;
+        auto lorenz = [sigma, rho, beta](double x, double y, double z, double& dx, double& dy, double& dz) {
+            dx = sigma * (y - x);
+            dy = x * (rho - z) - y;
+            dz = x * y - beta * z;
+        };
+        const int steps = integrationSteps(dt, kMaxLorenzStep);
+        const double h = dt / steps;
+        for (int i = 0; i < steps; ++i) {
+            rk4Step(mLorenzX, mLorenzY, mLorenzZ, h, lorenz);
+        }
+        
+        return lorenzOutput(mOutput, mLorenzX, mLorenzY, mLorenzZ);
     }
     
-    double processHenon() {
+    double processHenon(double increment) {
         // Henon map is discrete, but we need smooth audio output
         // Process at a lower rate and interpolate
         
-        mHenonPhaseAccum += mHenonPhaseInc;
+        mHenonPhaseAccum += increment;
         
-        if (mHenonPhaseAccum >= 1.0) {
+        while (mHenonPhaseAccum >= 1.0) {
             mHenonPhaseAccum -= 1.0;
             
             // Store previous for interpolation
@@ -329,24 +454,23 @@ private:
         double interpX = mHenonPrevX + t * (mHenonX - mHenonPrevX);
         double interpY = mHenonPrevY + t * (mHenonY - mHenonPrevY);
         
-        // Normalize output to [-1, 1]
-        // Henon attractor range is roughly [-1.5, 1.5]
-        double output;
-        switch (mOutput) {
-            case Output::X:
-                output = interpX / 1.5;
-                break;
-            case Output::Y:
-                output = interpY / 0.5;  // Y has smaller range
-                break;
-            case Output::Z:
-            case Output::XY_Mix:
-            default:
-                output = (interpX + interpY * 2.0) / 2.5;
-                break;
+        return henonOutput(mOutput, interpX, interpY);
+    }
+    
+    double processRossler(double dt) {
+        const double a = mRosslerA, b = mRosslerB, c = mRosslerC;
+        auto rossler = [a, b, c](double x, double y, double z, double& dx, double& dy, double& dz) {
+            dx = -y - z;
+            dy = x + a * y;
+            dz = b + z * (x - c);
+        };
+        const int steps = integrationSteps(dt, kMaxRosslerStep);
+        const double h = dt / steps;
+        for (int i = 0; i < steps; ++i) {
+            rk4Step(mRosslerX, mRosslerY, mRosslerZ, h, rossler);
         }
         
-        return std::max(-1.0, std::min(1.0, output));
+        return rosslerOutput(mOutput, mRosslerX, mRosslerY, mRosslerZ);
     }
     
     void updateTimeStep() {
@@ -354,6 +478,10 @@ private:
         // At rate=1.0, we want a reasonable evolution speed
         mTimeStep = (mRate * 0.01) / mSampleRate * 1000.0;
         
+        // Rössler orbits take ~6 time units versus ~1 for Lorenz; run it
+        // proportionally faster so both circle at a similar speed
+        mRosslerTimeStep = mTimeStep * 6.0;
+        
         // Henon iteration rate (how often we compute new map iteration)
         // At rate=1.0, about 20-50 iterations per second for rhythmic feel
         mHenonPhaseInc = (mRate * 30.0) / mSampleRate;
@@ -378,6 +506,15 @@ private:
     double mHenonPhaseAccum = 0.0;
     double mHenonPhaseInc = 0.0;
     
+    // Rössler state and parameters
+    double mRosslerX, mRosslerY, mRosslerZ;
+    double mRosslerA, mRosslerB, mRosslerC;
+    double mRosslerTimeStep = 0.0;
+    
+    // Control rate
+    int mControlRate = ControlRate::kAudioRate;
+    ControlCubic mInterpolator;
+    
     // Output
     double mCurrentValue;
     double mSmoothedValue;
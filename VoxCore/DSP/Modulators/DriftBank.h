@@ -0,0 +1,282 @@
+//
+//  DriftBank.h
+//  VoxCore
+//
+//  Per-voice drift (structure of arrays)
+//
+//  PLAN.md's "per-voice vs global" drift: every voice wanders on its own
+//  drift curve. Rather than one DriftGenerator per voice, the bank keeps each
+//  lane's value, walk target, phase, breath variation and random stream in
+//  their own arrays and advances all lanes together once per control tick,
+//  in loops over lanes with no per-lane branches. The only branches are the
+//  rare cycle wraps (once per 1/rate seconds per lane) that draw a new
+//  random step.
+//
+//  Lanes share one mode, rate and half-life; seed() gives each lane its own
+//  random stream and a staggered starting phase, so no two lanes step at
+//  the same moment. The modes match DriftGenerator, with Entropy restarted
+//  per note: retrigger() throws a lane to a random offset in [-1, 1] that
+//  decays back to 0 with the bank's half-life, so voices start apart and
+//  settle into unison.
+//
+//  Usage: process(samples) once per tick, then getValue(lane) in [-1, 1].
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include "DriftGenerator.h"
+#include "DSPUtilities.h"
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+template <int MaxLanes>
+class DriftBankT {
+public:
+    using Mode = DriftGenerator::Mode;
+
+    static constexpr int kMaxLanes = MaxLanes;
+
+    DriftBankT(double sampleRate = 44100.0) {
+        seed(0);
+        setSampleRate(sampleRate);
+    }
+
+    void setSampleRate(double sampleRate) {
+        mSampleRate = sampleRate;
+        updateCoefficients();
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // Parameters (shared by all lanes)
+    // ═══════════════════════════════════════════════════════════════
+
+    // Rate: 0.001 Hz to 0.1 Hz, as DriftGenerator::setRate
+    void setRate(double rateHz) {
+        double clamped = std::max(0.001, std::min(0.1, rateHz));
+        if (clamped != mRate) {
+            mRate = clamped;
+            updateCoefficients();
+        }
+    }
+
+    double getRate() const {
+        return mRate;
+    }
+
+    void setMode(Mode mode) {
+        mMode = mode;
+    }
+
+    Mode getMode() const {
+        return mMode;
+    }
+
+    // Entropy: seconds for a retriggered lane's offset to halve (0.1 s to 1 h)
+    void setEntropyHalfLife(double seconds) {
+        double clamped = std::max(0.1, std::min(3600.0, seconds));
+        if (clamped != mEntropyHalfLife) {
+            mEntropyHalfLife = clamped;
+            updateCoefficients();
+        }
+    }
+
+    double getEntropyHalfLife() const {
+        return mEntropyHalfLife;
+    }
+
+    // Lanes advanced by process(); lanes past the count hold their state
+    void setLaneCount(int count) {
+        mLaneCount = std::max(0, std::min(kMaxLanes, count));
+    }
+
+    int getLaneCount() const {
+        return mLaneCount;
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // Processing
+    // ═══════════════════════════════════════════════════════════════
+
+    // Give every lane its own random stream (derived from seedValue) and a
+    // staggered phase, and return all lanes to the centre
+    void seed(uint64_t seedValue) {
+        for (int lane = 0; lane < kMaxLanes; ++lane) {
+            mRandom[lane].setSeed(seedValue * kMaxLanes + static_cast<uint64_t>(lane));
+            mPhase[lane] = mRandom[lane].nextUnipolar();
+        }
+        reset();
+    }
+
+    void reset() {
+        mValue.fill(0.0);
+        mTarget.fill(0.0);
+        mBreathVariation.fill(0.0);
+    }
+
+    // Note-on for one lane. In Entropy mode the lane jumps to a random offset
+    // and starts decaying back to 0; the wandering modes carry on unbroken.
+    void retrigger(int lane) {
+        if (mMode == Mode::Entropy && lane >= 0 && lane < kMaxLanes) {
+            mValue[lane] = mRandom[lane].nextBipolar();
+        }
+    }
+
+    // Advance every lane by samples samples (one control tick)
+    void process(int samples) {
+        if (samples != mTickSamples) {
+            mTickSamples = samples;
+            updateTickCoefficients();
+        }
+        const double increment = mPhaseIncrement * samples;
+
+        switch (mMode) {
+            case Mode::RandomWalk:
+                processRandomWalk(increment);
+                smoothToward(mTarget);
+                break;
+            case Mode::Breath:
+                processBreath(increment);
+                smoothToward(mRaw);
+                break;
+            case Mode::Tide:
+                processTide(increment);
+                smoothToward(mRaw);
+                break;
+            case Mode::Entropy:
+                processEntropy();
+                break;
+        }
+    }
+
+    // Lane value in [-1, 1]
+    double getValue(int lane) const {
+        return mValue[lane];
+    }
+
+private:
+    // Phase advance for all lanes, then a random step for the lanes that
+    // completed a cycle (the scalar walk's Gaussian step, approximated by a
+    // sum of four uniforms)
+    void processRandomWalk(double increment) {
+        const int n = mLaneCount;
+        for (int lane = 0; lane < n; ++lane) {
+            mPhase[lane] += increment;
+        }
+        for (int lane = 0; lane < n; ++lane) {
+            if (mPhase[lane] >= 1.0) {
+                mPhase[lane] -= 1.0;
+                FastRandom& random = mRandom[lane];
+                double sum = random.nextUnipolar() + random.nextUnipolar() +
+                             random.nextUnipolar() + random.nextUnipolar();
+                double step = (sum - 2.0) * kWalkStepScale;
+                double target = mTarget[lane] + step;
+                target -= target * 0.1;  // Springs back from edges
+                mTarget[lane] = std::max(-1.0, std::min(1.0, target));
+            }
+        }
+    }
+
+    // Asymmetric rise/fall, as DriftGenerator: smoothstep up over 60% of the
+    // cycle, down over the rest, with a random amplitude per breath
+    void processBreath(double increment) {
+        const int n = mLaneCount;
+        for (int lane = 0; lane < n; ++lane) {
+            double phase = mPhase[lane] + increment;
+            double rise = smoothstep(phase * (1.0 / kRiseTime));
+            double fall = 1.0 - smoothstep((phase - kRiseTime) * (1.0 / (1.0 - kRiseTime)));
+            mRaw[lane] = phase < kRiseTime ? rise : fall;
+            mPhase[lane] = phase;
+        }
+        for (int lane = 0; lane < n; ++lane) {
+            if (mPhase[lane] >= 1.0) {
+                mPhase[lane] -= 1.0;
+                mBreathVariation[lane] = mRandom[lane].nextBipolar() * 0.1;
+            }
+        }
+        for (int lane = 0; lane < n; ++lane) {
+            double value = (mRaw[lane] * 2.0 - 1.0) * (1.0 + mBreathVariation[lane]);
+            mRaw[lane] = std::max(-1.0, std::min(1.0, value));
+        }
+    }
+
+    void processTide(double increment) {
+        const int n = mLaneCount;
+        for (int lane = 0; lane < n; ++lane) {
+            double phase = mPhase[lane] + increment;
+            phase -= phase >= 1.0 ? 1.0 : 0.0;
+            mPhase[lane] = phase;
+            mRaw[lane] = DSPUtilities::sinTurns(phase);
+        }
+    }
+
+    // Already smooth: decay straight toward 0
+    void processEntropy() {
+        const int n = mLaneCount;
+        const double decay = 1.0 - mTickEntropyCoeff;
+        for (int lane = 0; lane < n; ++lane) {
+            mValue[lane] *= decay;
+        }
+    }
+
+    // The scalar generator's output smoother, one tick at a time
+    void smoothToward(const std::array<double, kMaxLanes>& raw) {
+        const int n = mLaneCount;
+        const double coeff = mTickSmoothingCoeff;
+        for (int lane = 0; lane < n; ++lane) {
+            double value = mValue[lane] + (raw[lane] - mValue[lane]) * coeff;
+            mValue[lane] = std::max(-1.0, std::min(1.0, value));
+        }
+    }
+
+    static double smoothstep(double t) {
+        t = std::max(0.0, std::min(1.0, t));
+        return t * t * (3.0 - 2.0 * t);
+    }
+
+    void updateCoefficients() {
+        mPhaseIncrement = mRate / mSampleRate;
+        // Same per-sample smoothing as DriftGenerator: 10 periods per cycle
+        mSmoothingCoeff = 1.0 / std::max(1.0, mSampleRate / (mRate * 10.0));
+        mEntropyCoeff = -std::expm1(-std::numbers::ln2 / (mEntropyHalfLife * mSampleRate));
+        updateTickCoefficients();
+    }
+
+    // Per-tick equivalents of mTickSamples per-sample steps
+    void updateTickCoefficients() {
+        mTickSmoothingCoeff = 1.0 - std::pow(1.0 - mSmoothingCoeff, mTickSamples);
+        mTickEntropyCoeff = 1.0 - std::pow(1.0 - mEntropyCoeff, mTickSamples);
+    }
+
+    // Irwin-Hall(4) has variance 1/3; scale to the walk's 0.1 std deviation
+    static constexpr double kWalkStepScale = 0.1 * 1.7320508075688772;
+    static constexpr double kRiseTime = 0.6;
+
+    double mSampleRate = 44100.0;
+    Mode mMode = Mode::RandomWalk;
+    double mRate = 0.01;
+    double mEntropyHalfLife = 2.0;
+    int mLaneCount = kMaxLanes;
+
+    double mPhaseIncrement = 0.0;
+    double mSmoothingCoeff = 0.0;
+    double mEntropyCoeff = 0.0;
+    int mTickSamples = 1;
+    double mTickSmoothingCoeff = 0.0;
+    double mTickEntropyCoeff = 0.0;
+
+    // Lane state
+    std::array<double, kMaxLanes> mValue{};
+    std::array<double, kMaxLanes> mTarget{};
+    std::array<double, kMaxLanes> mPhase{};
+    std::array<double, kMaxLanes> mBreathVariation{};
+    std::array<double, kMaxLanes> mRaw{};
+    std::array<FastRandom, kMaxLanes> mRandom;
+};
+
+using DriftBank = DriftBankT<16>;
+
+#endif // __cplusplus
@@ -9,6 +9,11 @@
 //  - RandomWalk: Brownian motion, bounded
 //  - Breath: Organic rise/fall pattern
 //  - Tide: Slow sine, very low frequency
+//  - Entropy: One-way exponential decay toward a target, set by half-life
+//
+//  At 0.001-0.1 Hz the drift barely moves within a block, so it is a natural
+//  fit for control-rate mode (setControlRate): one step per N samples with a
+//  linear ramp in between.
 //
 
 #pragma once
@@ -19,15 +24,19 @@
 #include <numbers>
 #include <random>
 #include <algorithm>
+#include "ControlRate.h"
 
 class DriftGenerator {
 public:
     enum class Mode {
         RandomWalk,  // Brownian motion, bounded (-1 to +1)
         Breath,      // Organic rise/fall pattern
-        Tide         // Very slow sine wave
+        Tide,        // Very slow sine wave
+        Entropy      // One-way decay toward the entropy target
     };
     
+    static constexpr double kEntropyStart = 1.0;  // Value Entropy starts from after reset()
+    
     DriftGenerator(double sampleRate = 44100.0)
         : mSampleRate(sampleRate)
         , mMode(Mode::RandomWalk)
@@ -89,58 +98,116 @@ public:
         return mMode;
     }
     
+    // Entropy: seconds for the distance to the target to halve (0.1 s to 1 h)
+    void setEntropyHalfLife(double seconds) {
+        mEntropyHalfLife = std::max(0.1, std::min(3600.0, seconds));
+        updateSmoothingCoeff();
+    }
+    
+    double getEntropyHalfLife() const {
+        return mEntropyHalfLife;
+    }
+    
+    // Entropy: value the decay settles on (-1 to +1)
+    void setEntropyTarget(double target) {
+        mEntropyTarget = std::max(-1.0, std::min(1.0, target));
+    }
+    
+    double getEntropyTarget() const {
+        return mEntropyTarget;
+    }
+    
+    // Samples per control tick (1 = audio rate); see ControlRate.h
+    void setControlRate(int samplesPerTick) {
+        int clamped = ControlRate::clampSamples(samplesPerTick);
+        if (clamped != mControlRate) {
+            mControlRate = clamped;
+            mRamp.reset(mCurrentValue);
+            updateSmoothingCoeff();
+        }
+    }
+    
+    int getControlRate() const {
+        return mControlRate;
+    }
+    
     // ═══════════════════════════════════════════════════════════════
     // Processing
     // ═══════════════════════════════════════════════════════════════
     
     void reset() {
-        mCurrentValue = 0.0;
+        mCurrentValue = (mMode == Mode::Entropy) ? kEntropyStart : 0.0;
         mTargetValue = 0.0;
         mPhase = 0.0;
         mBreathPhase = 0.0;
         mBreathDirection = 1.0;
+        mRamp.reset(mCurrentValue);
     }
     
     // Process one sample, returns value in range [-1, 1] * amount
     double process() {
+        if (mControlRate > ControlRate::kAudioRate) {
+            if (mRamp.needsTick()) {
+                mRamp.setTarget(advance(mControlRate), mControlRate);
+            }
+            return mRamp.next() * mAmount;
+        }
+        return advance(ControlRate::kAudioRate) * mAmount;
+    }
+    
+    // Get current value without advancing
+    double getCurrentValue() const {
+        return getRawValue() * mAmount;
+    }
+    
+    // Get raw (unscaled) value
+    double getRawValue() const {
+        return mControlRate > ControlRate::kAudioRate ? mRamp.getValue() : mCurrentValue;
+    }
+    
+private:
+    // One step of the drift covering samples samples (1, or one control tick)
+    double advance(int samples) {
+        const bool perSample = (samples == ControlRate::kAudioRate);
+        
+        if (mMode == Mode::Entropy) {
+            // Already smooth: decay straight toward the target
+            double decay = perSample ? mEntropyCoeff : mTickEntropyCoeff;
+            mCurrentValue += (mEntropyTarget - mCurrentValue) * decay;
+            return mCurrentValue;
+        }
+        
+        const double increment = perSample ? mPhaseIncrement : mPhaseIncrement * samples;
+        const double coeff = perSample ? mSmoothingCoeff : mTickSmoothingCoeff;
         double rawValue = 0.0;
         
         switch (mMode) {
             case Mode::RandomWalk:
-                rawValue = processRandomWalk();
+                rawValue = processRandomWalk(increment);
                 break;
             case Mode::Breath:
-                rawValue = processBreath();
+                rawValue = processBreath(increment);
                 break;
             case Mode::Tide:
-                rawValue = processTide();
+                rawValue = processTide(increment);
+                break;
+            case Mode::Entropy:
                 break;
         }
         
         // Smooth the output for all modes
-        mCurrentValue += (rawValue - mCurrentValue) * mSmoothingCoeff;
+        mCurrentValue += (rawValue - mCurrentValue) * coeff;
         
         // Ensure bounded output
         mCurrentValue = std::max(-1.0, std::min(1.0, mCurrentValue));
         
-        return mCurrentValue * mAmount;
-    }
-    
-    // Get current value without advancing
-    double getCurrentValue() const {
-        return mCurrentValue * mAmount;
-    }
-    
-    // Get raw (unscaled) value
-    double getRawValue() const {
         return mCurrentValue;
     }
     
-private:
     // Brownian motion with soft boundaries
-    double processRandomWalk() {
+    double processRandomWalk(double increment) {
         // Advance phase
-        mPhase += mPhaseIncrement;
+        mPhase += increment;
         
         // At each "cycle", add random walk step
         if (mPhase >= 1.0) {
@@ -162,9 +229,9 @@ private:
     }
     
     // Organic breathing pattern - asymmetric rise/fall
-    double processBreath() {
+    double processBreath(double increment) {
         // Advance breath phase
-        mBreathPhase += mPhaseIncrement;
+        mBreathPhase += increment;
         
         // Asymmetric timing: slower rise, faster fall
         double riseTime = 0.6;  // Rise takes 60% of cycle
@@ -193,9 +260,9 @@ private:
     }
     
     // Very slow sine wave
-    double processTide() {
+    double processTide(double increment) {
         // Simple sine wave at ultra-low frequency
-        mPhase += mPhaseIncrement;
+        mPhase += increment;
         if (mPhase >= 1.0) {
             mPhase -= 1.0;
         }
@@ -219,6 +286,13 @@ private:
         double smoothingTime = 1.0 / (mRate * 10.0);  // 10 smoothing periods per cycle
         double smoothingSamples = smoothingTime * mSampleRate;
         mSmoothingCoeff = 1.0 / std::max(1.0, smoothingSamples);
+        // Same decay per tick as mControlRate per-sample steps
+        mTickSmoothingCoeff = 1.0 - std::pow(1.0 - mSmoothingCoeff, mControlRate);
+        
+        // Entropy: (1 - coeff)^(halfLife * sampleRate) = 1/2
+        // (expm1 keeps precision for the tiny per-sample step)
+        mEntropyCoeff = -std::expm1(-std::numbers::ln2 / (mEntropyHalfLife * mSampleRate));
+        mTickEntropyCoeff = -std::expm1(-std::numbers::ln2 * mControlRate / (mEntropyHalfLife * mSampleRate));
     }
     
     double mSampleRate;
@@ -233,6 +307,15 @@ private:
     double mBreathDirection;
     double mBreathVariation = 0.0;
     double mSmoothingCoeff;
+    double mTickSmoothingCoeff = 0.0;
+    double mEntropyHalfLife = 30.0;
+    double mEntropyTarget = 0.0;
+    double mEntropyCoeff = 0.0;
+    double mTickEntropyCoeff = 0.0;
+    
+    // Control-rate mode
+    int mControlRate = ControlRate::kAudioRate;
+    ControlRamp mRamp;
     
     // Random generators
     std::mt19937 mRandomGen;
@@ -9,6 +9,7 @@
 //  - 16 steps, each stores vowel position (0.0-1.0 for A-E-I-O-U morph)
 //  - Free-running or tempo-synced
 //  - Glide (portamento) between steps
+//  - Optional control-rate mode: one step per N samples, linear ramp between
 //
 
 #pragma once
@@ -18,6 +19,7 @@
 #include <array>
 #include <cmath>
 #include <algorithm>
+#include "ControlRate.h"
 
 class FormantSequencer {
 public:
@@ -51,10 +53,10 @@ public:
         : mSampleRate(sampleRate)
         , mStepCount(16)
         , mRate(1.0)         // 1 Hz default (1 step per second)
-        , mGlide(0.0)        // 0% glide
         , mSyncMode(SyncMode::Free)
         , mBeatDivision(BeatDivision::Quarter)
         , mTempo(120.0)
+        , mGlide(0.0)        // 0% glide
         , mGlideCurve(GlideCurve::Linear)
         , mCurrentStep(0)
         , mPhase(0.0)
@@ -158,6 +160,36 @@ public:
         return mTempo;
     }
     
+    // Length of one step in quarter-note beats
+    static double beatsPerStep(BeatDivision division) {
+        switch (division) {
+            case BeatDivision::Whole:          return 4.0;
+            case BeatDivision::Half:           return 2.0;
+            case BeatDivision::DottedQuarter:  return 1.5;
+            case BeatDivision::Quarter:        return 1.0;
+            case BeatDivision::TripletQuarter: return 2.0 / 3.0;
+            case BeatDivision::DottedEighth:   return 0.75;
+            case BeatDivision::Eighth:         return 0.5;
+            case BeatDivision::TripletEighth:  return 1.0 / 3.0;
+            case BeatDivision::Sixteenth:      return 0.25;
+            case BeatDivision::ThirtySecond:   return 0.125;
+        }
+        return 1.0;
+    }
+    
+    // Samples per control tick (1 = audio rate); see ControlRate.h
+    void setControlRate(int samplesPerTick) {
+        int clamped = ControlRate::clampSamples(samplesPerTick);
+        if (clamped != mControlRate) {
+            mControlRate = clamped;
+            mRamp.reset(mCurrentValue);
+        }
+    }
+    
+    int getControlRate() const {
+        return mControlRate;
+    }
+    
     // ═══════════════════════════════════════════════════════════════
     // Glide/Portamento
     // ═══════════════════════════════════════════════════════════════
@@ -202,6 +234,7 @@ public:
         mTargetValue = mSteps[0];
         mPreviousValue = mSteps[0];
         mGlideProgress = 1.0;
+        mRamp.reset(mCurrentValue);
     }
     
     // Jump to specific step
@@ -211,24 +244,70 @@ public:
         mCurrentValue = mTargetValue;
         mPhase = 0.0;
         mGlideProgress = 1.0;
+        mRamp.reset(mCurrentValue);
     }
     
     int getCurrentStep() const {
         return mCurrentStep;
     }
     
+    // Host transport sync (TempoSync mode only): put the sequencer where a
+    // pattern started at beat 0 would be, so the next process() call renders
+    // the sample at beatPosition. Step changes glide as if reached normally.
+    void syncToBeatPosition(double beatPosition) {
+        if (mSyncMode != SyncMode::TempoSync || !mRunning) {
+            return;
+        }
+        // Position of the previous sample; advance() moves onto beatPosition
+        double steps = beatPosition / beatsPerStep(mBeatDivision) - mPhaseIncrement;
+        double whole = std::floor(steps);
+        int step = static_cast<int>(std::fmod(whole, static_cast<double>(mStepCount)));
+        if (step < 0) {
+            step += mStepCount;
+        }
+        mPhase = steps - whole;
+        if (step != mCurrentStep) {
+            mCurrentStep = step;
+            mPreviousValue = mSteps[(step + mStepCount - 1) % mStepCount];
+            mTargetValue = mSteps[step];
+            mGlideProgress = 0.0;
+        }
+    }
+    
     // ═══════════════════════════════════════════════════════════════
     // Processing
     // ═══════════════════════════════════════════════════════════════
     
     // Process one sample, returns vowel morph value (0.0-1.0)
     double process() {
+        if (mControlRate > ControlRate::kAudioRate) {
+            if (mRamp.needsTick()) {
+                mRamp.setTarget(advance(mPhaseIncrement * mControlRate), mControlRate);
+            }
+            return mRamp.next();
+        }
+        return advance(mPhaseIncrement);
+    }
+    
+    // Get current output value without advancing
+    double getCurrentValue() const {
+        return mControlRate > ControlRate::kAudioRate ? mRamp.getValue() : mCurrentValue;
+    }
+    
+    // Get phase within current step (0.0-1.0)
+    double getStepPhase() const {
+        return mPhase;
+    }
+    
+private:
+    // Advance the sequencer by increment's worth of step phase
+    double advance(double increment) {
         if (!mRunning) {
             return mCurrentValue;
         }
         
         // Advance phase
-        mPhase += mPhaseIncrement;
+        mPhase += increment;
         
         // Check for step advance
         if (mPhase >= 1.0) {
@@ -261,17 +340,6 @@ public:
         return mCurrentValue;
     }
     
-    // Get current output value without advancing
-    double getCurrentValue() const {
-        return mCurrentValue;
-    }
-    
-    // Get phase within current step (0.0-1.0)
-    double getStepPhase() const {
-        return mPhase;
-    }
-    
-private:
     double applyGlideCurve(double t) const {
         switch (mGlideCurve) {
             case GlideCurve::Linear:
@@ -290,39 +358,7 @@ private:
         if (mSyncMode == SyncMode::TempoSync) {
             // Convert tempo and beat division to Hz
             double beatsPerSecond = mTempo / 60.0;
-            
-            switch (mBeatDivision) {
-                case BeatDivision::Whole:
-                    effectiveRate = beatsPerSecond / 4.0;
-                    break;
-                case BeatDivision::Half:
-                    effectiveRate = beatsPerSecond / 2.0;
-                    break;
-                case BeatDivision::Quarter:
-                    effectiveRate = beatsPerSecond;
-                    break;
-                case BeatDivision::DottedQuarter:
-                    effectiveRate = beatsPerSecond * 2.0 / 3.0;
-                    break;
-                case BeatDivision::TripletQuarter:
-                    effectiveRate = beatsPerSecond * 1.5;
-                    break;
-                case BeatDivision::Eighth:
-                    effectiveRate = beatsPerSecond * 2.0;
-                    break;
-                case BeatDivision::DottedEighth:
-                    effectiveRate = beatsPerSecond * 4.0 / 3.0;
-                    break;
-                case BeatDivision::TripletEighth:
-                    effectiveRate = beatsPerSecond * 3.0;
-                    break;
-                case BeatDivision::Sixteenth:
-                    effectiveRate = beatsPerSecond * 4.0;
-                    break;
-                case BeatDivision::ThirtySecond:
-                    effectiveRate = beatsPerSecond * 8.0;
-                    break;
-            }
+            effectiveRate = beatsPerSecond / beatsPerStep(mBeatDivision);
         }
         
         mPhaseIncrement = effectiveRate / mSampleRate;
@@ -353,6 +389,10 @@ private:
     double mGlideProgress;
     double mPreviousValue;
     bool mRunning;
+    
+    // Control-rate mode
+    int mControlRate = ControlRate::kAudioRate;
+    ControlRamp mRamp;
 };
 
 #endif // __cplusplus
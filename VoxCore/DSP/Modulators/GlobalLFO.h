@@ -89,6 +89,11 @@ public:
         return mLFO.getTempo();
     }
     
+    // Follow the host beat position (tempo-synced LFOs only)
+    void syncToBeatPosition(double beatPosition) {
+        mLFO.syncToBeatPosition(beatPosition);
+    }
+    
     void setPhaseOffset(double offset) {
         mLFO.setPhaseOffset(offset);
     }
@@ -97,6 +102,15 @@ public:
         return mLFO.getPhaseOffset();
     }
     
+    // Samples per control tick (1 = audio rate); see ControlRate.h
+    void setControlRate(int samplesPerTick) {
+        mLFO.setControlRate(samplesPerTick);
+    }
+    
+    int getControlRate() const {
+        return mLFO.getControlRate();
+    }
+    
     // ═══════════════════════════════════════════════════════════════
     // Amount and Destination Routing
     // ═══════════════════════════════════════════════════════════════
@@ -218,6 +232,12 @@ public:
         return total;
     }
     
+    void setControlRate(int samplesPerTick) {
+        for (int i = 0; i < kNumGlobalLFOs; ++i) {
+            mLFOs[i].setControlRate(samplesPerTick);
+        }
+    }
+    
     // Set tempo for all LFOs (for host sync)
     void setTempo(double bpm) {
         for (int i = 0; i < kNumGlobalLFOs; ++i) {
@@ -225,6 +245,12 @@ public:
         }
     }
     
+    void syncToBeatPosition(double beatPosition) {
+        for (int i = 0; i < kNumGlobalLFOs; ++i) {
+            mLFOs[i].syncToBeatPosition(beatPosition);
+        }
+    }
+    
 private:
     std::array<GlobalLFO, kNumGlobalLFOs> mLFOs;
 };
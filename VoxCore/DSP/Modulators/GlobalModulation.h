@@ -6,9 +6,14 @@
 //  Combines all global modulation sources:
 //  - Two Global LFOs
 //  - Drift Engine
-//  - Chaos Generator (Lorenz/Henon)
+//  - Chaos Generator (Lorenz/Henon/Rössler)
 //  - Formant Step Sequencer
 //
+//  process() returns every destination for one sample. processBlock()
+//  renders a block of each destination into the GlobalModulationBlock
+//  buffers, so a voice pool computes global modulation once per block and
+//  every voice reads the same buffers. Both give the same values.
+//
 
 #pragma once
 
@@ -18,6 +23,8 @@
 #include "DriftGenerator.h"
 #include "ChaosGenerator.h"
 #include "FormantSequencer.h"
+#include <array>
+#include <algorithm>
 
 // Modulation routing destinations
 enum class ModDestination {
@@ -88,6 +95,29 @@ struct GlobalModulationValues {
     double sequencerValue = 0.0;
 };
 
+// One block of every global destination, filled by processBlock(). A
+// destination whose routing amounts are all 0 is zero-filled and marked
+// inactive, so readers can skip it.
+struct GlobalModulationBlock {
+    static constexpr int kMaxSamples = 64;
+    
+    std::array<double, kMaxSamples> pitch{};       // semitones
+    std::array<double, kMaxSamples> formant1{};    // Hz
+    std::array<double, kMaxSamples> formant2{};    // Hz
+    std::array<double, kMaxSamples> vowelMorph{};  // 0-1 range
+    std::array<double, kMaxSamples> dutyCycle{};   // 0-1 range
+    std::array<double, kMaxSamples> pan{};         // -1 to 1
+    
+    bool pitchActive = false;
+    bool formant1Active = false;
+    bool formant2Active = false;
+    bool vowelMorphActive = false;
+    bool dutyCycleActive = false;
+    bool panActive = false;
+    
+    int count = 0;
+};
+
 class GlobalModulation {
 public:
     GlobalModulation(double sampleRate = 44100.0)
@@ -214,6 +244,94 @@ public:
         return mValues;
     }
     
+    // Render count samples (at most GlobalModulationBlock::kMaxSamples) of
+    // every destination into the block buffers; the same values as count
+    // calls to process(), and getValues() afterwards holds the last one
+    void processBlock(int count) {
+        count = std::max(0, std::min(GlobalModulationBlock::kMaxSamples, count));
+        mBlock.count = count;
+        if (count == 0) {
+            return;
+        }
+        
+        // Sources first, one pass each
+        for (int i = 0; i < count; ++i) {
+            mLFOBank.process();
+            mLFO1Buffer[i] = mLFOBank.lfo1().getCurrentValue();
+            mLFO2Buffer[i] = mLFOBank.lfo2().getCurrentValue();
+        }
+        for (int i = 0; i < count; ++i) {
+            mDriftBuffer[i] = mDrift.process();
+        }
+        for (int i = 0; i < count; ++i) {
+            mChaosBuffer[i] = mChaos.process();
+        }
+        for (int i = 0; i < count; ++i) {
+            mSequencerBuffer[i] = mSequencer.process();
+        }
+        
+        // Then each destination as one weighted sum over the block
+        const GlobalModulationAmounts& a = mAmounts;
+        mBlock.pitchActive = mixDestination(mBlock.pitch.data(), count,
+            a.lfo1ToPitch, a.lfo2ToPitch, a.driftToPitch, a.chaosToPitch);
+        mBlock.formant1Active = mixDestination(mBlock.formant1.data(), count,
+            a.lfo1ToFormant1, a.lfo2ToFormant1, a.driftToFormant1, a.chaosToFormant1);
+        mBlock.formant2Active = mixDestination(mBlock.formant2.data(), count,
+            a.lfo1ToFormant2, a.lfo2ToFormant2, a.driftToFormant2, a.chaosToFormant2);
+        mBlock.vowelMorphActive = mixDestination(mBlock.vowelMorph.data(), count,
+            a.lfo1ToVowelMorph, a.lfo2ToVowelMorph, a.driftToVowelMorph, a.chaosToVowelMorph,
+            a.sequencerToVowelMorph);
+        mBlock.dutyCycleActive = mixDestination(mBlock.dutyCycle.data(), count,
+            a.lfo1ToDutyCycle, a.lfo2ToDutyCycle, a.driftToDutyCycle, a.chaosToDutyCycle);
+        mBlock.panActive = mixDestination(mBlock.pan.data(), count,
+            a.lfo1ToPan, a.lfo2ToPan, a.driftToPan, a.chaosToPan);
+        
+        const int last = count - 1;
+        mValues.lfo1Value = mLFO1Buffer[last];
+        mValues.lfo2Value = mLFO2Buffer[last];
+        mValues.driftValue = mDriftBuffer[last];
+        mValues.chaosValue = mChaosBuffer[last];
+        mValues.sequencerValue = mSequencerBuffer[last];
+        mValues.totalPitchMod = mBlock.pitch[last];
+        mValues.totalFormant1Mod = mBlock.formant1[last];
+        mValues.totalFormant2Mod = mBlock.formant2[last];
+        mValues.totalVowelMorphMod = mBlock.vowelMorph[last];
+        mValues.totalDutyCycleMod = mBlock.dutyCycle[last];
+        mValues.totalPanMod = mBlock.pan[last];
+    }
+    
+    // Buffers from the last processBlock()
+    const GlobalModulationBlock& getBlock() const {
+        return mBlock;
+    }
+    
+    int getBlockCount() const {
+        return mBlock.count;
+    }
+    
+    // One sample of a destination from the last processBlock()
+    double getBlockValue(ModDestination dest, int index) const {
+        if (index < 0 || index >= mBlock.count) {
+            return 0.0;
+        }
+        switch (dest) {
+            case ModDestination::Pitch:
+                return mBlock.pitch[index];
+            case ModDestination::Formant1:
+                return mBlock.formant1[index];
+            case ModDestination::Formant2:
+                return mBlock.formant2[index];
+            case ModDestination::VowelMorph:
+                return mBlock.vowelMorph[index];
+            case ModDestination::DutyCycle:
+                return mBlock.dutyCycle[index];
+            case ModDestination::Pan:
+                return mBlock.pan[index];
+            default:
+                return 0.0;
+        }
+    }
+    
     // Get current modulation values (after process())
     GlobalModulationValues getValues() const {
         return mValues;
@@ -248,7 +366,56 @@ public:
         mSequencer.setTempo(bpm);
     }
     
+    // Resync tempo-synced LFOs and the sequencer to the host beat position
+    // of the next sample (call once per render block while the transport
+    // runs, so the phase tracks the host instead of accumulating increments)
+    void syncToBeatPosition(double beatPosition) {
+        mLFOBank.syncToBeatPosition(beatPosition);
+        mSequencer.syncToBeatPosition(beatPosition);
+    }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Control Rate (quality setting)
+    // ═══════════════════════════════════════════════════════════════
+    
+    // Run every source once per samplesPerTick samples (1 = audio rate):
+    // linear ramps for the LFOs, drift and sequencer, cubic interpolation
+    // for the chaos attractor
+    void setControlRate(int samplesPerTick) {
+        mLFOBank.setControlRate(samplesPerTick);
+        mDrift.setControlRate(samplesPerTick);
+        mChaos.setControlRate(samplesPerTick);
+        mSequencer.setControlRate(samplesPerTick);
+    }
+    
+    int getControlRate() const {
+        return mDrift.getControlRate();
+    }
+    
 private:
+    // Weighted sum of the source buffers into out, in process()'s order;
+    // false (and zeros) when every amount is 0
+    bool mixDestination(double* out, int count, double lfo1Amount, double lfo2Amount,
+                        double driftAmount, double chaosAmount, double sequencerAmount = 0.0) const {
+        if (lfo1Amount == 0.0 && lfo2Amount == 0.0 && driftAmount == 0.0 &&
+            chaosAmount == 0.0 && sequencerAmount == 0.0) {
+            std::fill_n(out, count, 0.0);
+            return false;
+        }
+        for (int i = 0; i < count; ++i) {
+            out[i] = mLFO1Buffer[i] * lfo1Amount +
+                     mLFO2Buffer[i] * lfo2Amount +
+                     mDriftBuffer[i] * driftAmount +
+                     mChaosBuffer[i] * chaosAmount;
+        }
+        if (sequencerAmount != 0.0) {
+            for (int i = 0; i < count; ++i) {
+                out[i] += mSequencerBuffer[i] * sequencerAmount;
+            }
+        }
+        return true;
+    }
+    
     double mSampleRate;
     
     // Modulation sources
@@ -262,6 +429,14 @@ private:
     
     // Current values
     GlobalModulationValues mValues;
+    
+    // Block render: per-source scratch and the destination buffers
+    std::array<double, GlobalModulationBlock::kMaxSamples> mLFO1Buffer{};
+    std::array<double, GlobalModulationBlock::kMaxSamples> mLFO2Buffer{};
+    std::array<double, GlobalModulationBlock::kMaxSamples> mDriftBuffer{};
+    std::array<double, GlobalModulationBlock::kMaxSamples> mChaosBuffer{};
+    std::array<double, GlobalModulationBlock::kMaxSamples> mSequencerBuffer{};
+    GlobalModulationBlock mBlock;
 };
 
 #endif // __cplusplus
@@ -164,7 +164,7 @@ public:
     
     // Convert pitch scatter from cents to frequency ratio
     static double centsToRatio(double cents) {
-        return std::pow(2.0, cents / 1200.0);
+        return PitchTable::centsToRatio(cents);
     }
     
     // Get effective grain period based on density settings
@@ -12,6 +12,7 @@
 
 #ifdef __cplusplus
 
+#include "PitchTable.h"
 #include <cmath>
 #include <random>
 #include <algorithm>
@@ -164,7 +165,7 @@ using StochasticGenerator = StochasticDistribution;
 
 // Convert cents to frequency ratio: 100 cents = 1 semitone = 2^(1/12)
 inline double centsToRatio(double cents) {
-    return std::pow(2.0, cents / 1200.0);
+    return PitchTable::centsToRatio(cents);
 }
 
 // Convert frequency ratio to cents
@@ -4,6 +4,18 @@
 //
 //  Low Frequency Oscillator for modulation
 //
+//  Templated on sample type: the phase accumulator stays double so slow rates
+//  do not drift, while the waveform output and smoothing state are SampleType.
+//
+//  The phase offset is baked into the accumulator (mPhase is the phase the
+//  waveform is read at), the sine is a polynomial, and noise comes from an
+//  8-byte xorshift generator, so the render path calls no libm function and
+//  never allocates. processBlock() renders a whole block with one waveform
+//  dispatch; process() and processBlock() produce identical samples.
+//
+//  With setControlRate(N > 1) the waveform is evaluated once per N samples
+//  and the output is a linear ramp between those control ticks.
+//
 
 #pragma once
 
@@ -12,9 +24,12 @@
 #include <cmath>
 #include <numbers>
 #include <algorithm>
-#include <random>
+#include <cstdint>
+#include "DSPUtilities.h"
+#include "ControlRate.h"
 
-class LFO {
+template <typename SampleType>
+class LFOT {
 public:
     enum class Waveform {
         SINE,
@@ -68,7 +83,7 @@ public:
         BEAT            // Retrigger on beat
     };
     
-    LFO(double sampleRate = 44100.0)
+    LFOT(double sampleRate = 44100.0)
         : mSampleRate(sampleRate)
         , mPhase(0.0)
         , mPhaseIncrement(0.0)
@@ -83,25 +98,24 @@ public:
         , mDelaySamples(0)
         , mDelayCounter(0)
         , mSmoothingCutoff(20.0)
-        , mSavedRandom(0.0)
-        , mSmoothedValue(0.0)
+        , mSavedRandom(0)
+        , mSmoothedValue(0)
     {
         setRate(1.0);
-        // Initialize random generator
-        std::random_device rd;
-        mRandomGen = std::mt19937(rd());
-        mRandomDist = std::uniform_real_distribution<double>(-1.0, 1.0);
+        // Seed from the instance address so every voice gets its own stream
+        mRandom.setSeed(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this)));
         updateSmoothingCoeff();
     }
     
     void setSampleRate(double sampleRate) {
         mSampleRate = sampleRate;
         setRate(mRate);
+        updateSmoothingCoeff();
     }
     
     void setRate(double rateHz) {
         mRate = std::max(0.01, std::min(100.0, rateHz));
-        mPhaseIncrement = mRate / mSampleRate;
+        updateEffectiveRate();
     }
     
     double getRate() const { return mRate; }
@@ -115,7 +129,8 @@ public:
     void reset() {
         mPhase = mPhaseOffset;
         mDelayCounter = mDelaySamples;
-        mSmoothedValue = 0.0;
+        mSmoothedValue = SampleType(0);
+        mRamp.reset(SampleType(0));
     }
     
     // Alias for setRate
@@ -146,8 +161,64 @@ public:
     
     double getTempo() const { return mTempo; }
     
+    bool isTempoSynced() const {
+        return mSyncMode == SyncMode::TEMPO_SYNC || mSyncMode == SyncMode::BEAT_SYNC;
+    }
+    
+    // Length of one LFO cycle in quarter-note beats
+    static double beatsPerCycle(BeatDivision division) {
+        switch (division) {
+            case BeatDivision::FOUR_BARS:         return 16.0;
+            case BeatDivision::TWO_BARS:          return 8.0;
+            case BeatDivision::WHOLE:             return 4.0;
+            case BeatDivision::DOTTED_HALF:       return 3.0;
+            case BeatDivision::HALF:              return 2.0;
+            case BeatDivision::HALF_TRIPLET:
+            case BeatDivision::TRIPLET_HALF:      return 4.0 / 3.0;
+            case BeatDivision::QUARTER_DOT:
+            case BeatDivision::DOTTED_QUARTER:    return 1.5;
+            case BeatDivision::QUARTER:           return 1.0;
+            case BeatDivision::QUARTER_TRIPLET:
+            case BeatDivision::TRIPLET_QUARTER:   return 2.0 / 3.0;
+            case BeatDivision::EIGHTH_DOT:
+            case BeatDivision::DOTTED_EIGHTH:     return 0.75;
+            case BeatDivision::EIGHTH:            return 0.5;
+            case BeatDivision::EIGHTH_TRIPLET:
+            case BeatDivision::TRIPLET_EIGHTH:    return 1.0 / 3.0;
+            case BeatDivision::SIXTEENTH_DOT:     return 0.375;
+            case BeatDivision::SIXTEENTH:         return 0.25;
+            case BeatDivision::SIXTEENTH_TRIPLET: return 1.0 / 6.0;
+            case BeatDivision::THIRTY_SECOND:
+            case BeatDivision::THIRTYSECOND:      return 0.125;
+        }
+        return 1.0;
+    }
+    
+    // Host transport sync: place the phase where a cycle started at beat 0
+    // would be at beatPosition (the next process() call's sample). Only
+    // tempo-synced LFOs follow the host; free-running ones ignore this.
+    void syncToBeatPosition(double beatPosition) {
+        if (!isTempoSynced()) {
+            return;
+        }
+        double cycles = beatPosition / beatsPerCycle(mBeatDivision);
+        syncToBasePhase(cycles - std::floor(cycles));
+    }
+    
+    // Moves the running phase by the change in offset, so the waveform keeps
+    // reading at (accumulated phase + offset) without a per-sample fmod
     void setPhaseOffset(double offset) {
-        mPhaseOffset = std::fmod(std::abs(offset), 1.0);
+        double newOffset = std::fmod(std::abs(offset), 1.0);
+        if (newOffset == mPhaseOffset) {
+            return;
+        }
+        mPhase += newOffset - mPhaseOffset;
+        if (mPhase >= 1.0) {
+            mPhase -= 1.0;
+        } else if (mPhase < 0.0) {
+            mPhase += 1.0;
+        }
+        mPhaseOffset = newOffset;
     }
     
     double getPhaseOffset() const { return mPhaseOffset; }
@@ -161,6 +232,8 @@ public:
     void retrigger() {
         mPhase = mPhaseOffset;
         mDelayCounter = mDelaySamples;
+        // Start a fresh control tick from the current output value
+        mRamp.reset(mRamp.getValue());
     }
     
     void setDelayTime(double seconds) {
@@ -178,67 +251,78 @@ public:
     
     double getSmoothingCutoff() const { return mSmoothingCutoff; }
     
+    // Samples per control tick (1 = audio rate); see ControlRate.h
+    void setControlRate(int samplesPerTick) {
+        int clamped = ControlRate::clampSamples(samplesPerTick);
+        if (clamped != mControlRate) {
+            mControlRate = clamped;
+            mRamp.reset(mSmoothedValue);
+            updateSmoothingCoeff();
+        }
+    }
+    
+    int getControlRate() const { return mControlRate; }
+    
+    // ═══════════════════════════════════════════════════════════════════
+    // Shared phase (VoicePool's shared LFO)
+    // ═══════════════════════════════════════════════════════════════════
+    
+    // Free-running accumulator phase, i.e. the read phase minus the offset
+    double getBasePhase() const {
+        double phase = mPhase - mPhaseOffset;
+        return phase < 0.0 ? phase + 1.0 : phase;
+    }
+    
+    // Follow an external accumulator: read at basePhase + this LFO's offset
+    void syncToBasePhase(double basePhase) {
+        double phase = basePhase + mPhaseOffset;
+        mPhase = phase >= 1.0 ? phase - 1.0 : phase;
+    }
+    
+    // True when other renders the same waveform over time as this LFO,
+    // apart from the phase offset, so the two can share one accumulator
+    bool sharesShapeWith(const LFOT& other) const {
+        return mPhaseIncrement == other.mPhaseIncrement &&
+               mWaveform == other.mWaveform &&
+               mSmoothingCutoff == other.mSmoothingCutoff &&
+               mControlRate == other.mControlRate &&
+               mDelaySamples == other.mDelaySamples;
+    }
+    
+    // Reseed the noise / sample-and-hold generator (for reproducible renders)
+    void setRandomSeed(uint64_t seed) {
+        mRandom.setSeed(seed);
+    }
+    
     // Returns value in range [-1, 1]
-    double process() {
+    SampleType process() {
         // Handle delay
         if (mDelayCounter > 0) {
             mDelayCounter--;
-            return 0.0;
+            return SampleType(0);
         }
         
-        double output = 0.0;
-        bool didWrap = false;
-        
-        // Apply phase offset
-        double effectivePhase = std::fmod(mPhase + mPhaseOffset, 1.0);
+        if (mControlRate > ControlRate::kAudioRate) {
+            if (mRamp.needsTick()) {
+                mRamp.setTarget(tick(), mControlRate);
+            }
+            return mRamp.next();
+        }
         
+        SampleType output = SampleType(0);
+        const double increment = mPhaseIncrement;
         switch (mWaveform) {
-            case Waveform::SINE:
-                output = std::sin(effectivePhase * std::numbers::pi * 2.0);
-                break;
-                
-            case Waveform::TRIANGLE:
-                // Triangle wave: rising from -1 to 1, then falling from 1 to -1
-                if (effectivePhase < 0.5) {
-                    output = 4.0 * effectivePhase - 1.0;
-                } else {
-                    output = 3.0 - 4.0 * effectivePhase;
-                }
-                break;
-                
-            case Waveform::SAW:
-                // Saw wave: rising from -1 to 1
-                output = 2.0 * effectivePhase - 1.0;
-                break;
-                
-            case Waveform::SQUARE:
-                output = (effectivePhase < 0.5) ? 1.0 : -1.0;
-                break;
-                
+            case Waveform::SINE:            output = step<Waveform::SINE>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::TRIANGLE:        output = step<Waveform::TRIANGLE>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::SAW:             output = step<Waveform::SAW>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::SQUARE:          output = step<Waveform::SQUARE>(mPhase, increment, mSavedRandom, mRandom); break;
             case Waveform::SAMPLE_AND_HOLD:
-            case Waveform::RANDOM:
-                output = mSavedRandom;
-                break;
-                
-            case Waveform::NOISE:
-                output = mRandomDist(mRandomGen);
-                break;
-        }
-        
-        // Update phase
-        mPhase += mPhaseIncrement;
-        if (mPhase >= 1.0) {
-            mPhase -= 1.0;
-            didWrap = true;
-        }
-        
-        // For S&H, grab new random value on phase wrap
-        if ((mWaveform == Waveform::SAMPLE_AND_HOLD || mWaveform == Waveform::RANDOM) && didWrap) {
-            mSavedRandom = mRandomDist(mRandomGen);
+            case Waveform::RANDOM:          output = step<Waveform::SAMPLE_AND_HOLD>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::NOISE:           output = step<Waveform::NOISE>(mPhase, increment, mSavedRandom, mRandom); break;
         }
         
         // Apply smoothing
-        if (mSmoothingCutoff < mSampleRate * 0.4) {
+        if (isSmoothing()) {
             mSmoothedValue += (output - mSmoothedValue) * mSmoothingCoeff;
             return mSmoothedValue;
         }
@@ -246,65 +330,141 @@ public:
         return output;
     }
     
+    // Render numSamples values; same output as calling process() per sample
+    void processBlock(SampleType* output, int numSamples) {
+        int done = 0;
+        if (mDelayCounter > 0) {
+            int delayed = std::min(mDelayCounter, numSamples);
+            std::fill(output, output + delayed, SampleType(0));
+            mDelayCounter -= delayed;
+            done = delayed;
+        }
+        if (done == numSamples) {
+            return;
+        }
+        
+        output += done;
+        const int count = numSamples - done;
+        if (mControlRate > ControlRate::kAudioRate) {
+            for (int i = 0; i < count; ) {
+                if (mRamp.needsTick()) {
+                    mRamp.setTarget(tick(), mControlRate);
+                }
+                int n = std::min(mRamp.getRemaining(), count - i);
+                mRamp.fill(output + i, n);
+                i += n;
+            }
+        } else if (isSmoothing()) {
+            renderBlockForWaveform<true>(output, count);
+        } else {
+            renderBlockForWaveform<false>(output, count);
+        }
+    }
+    
 private:
+    // ═══════════════════════════════════════════════════════════════════
+    // Waveform kernels
+    // ═══════════════════════════════════════════════════════════════════
+    
+    bool isSmoothing() const {
+        return mSmoothingCutoff < mSampleRate * 0.4;
+    }
+    
+    // One value of waveform W at phase, then advance the phase by increment.
+    // State is passed by reference so the block loop can keep it in registers.
+    template <Waveform W>
+    SampleType step(double& phase, double increment, SampleType& held, FastRandom& random) const {
+        SampleType output;
+        if constexpr (W == Waveform::SINE) {
+            output = static_cast<SampleType>(DSPUtilities::sinTurns(phase));
+        } else if constexpr (W == Waveform::TRIANGLE) {
+            // Rising from -1 to 1, then falling from 1 to -1
+            output = static_cast<SampleType>(phase < 0.5 ? 4.0 * phase - 1.0 : 3.0 - 4.0 * phase);
+        } else if constexpr (W == Waveform::SAW) {
+            // Rising from -1 to 1
+            output = static_cast<SampleType>(2.0 * phase - 1.0);
+        } else if constexpr (W == Waveform::SQUARE) {
+            output = phase < 0.5 ? SampleType(1) : SampleType(-1);
+        } else if constexpr (W == Waveform::SAMPLE_AND_HOLD) {
+            output = held;
+        } else {
+            output = static_cast<SampleType>(random.nextBipolar());
+        }
+        
+        phase += increment;
+        if (phase >= 1.0) {
+            phase -= 1.0;
+            // For S&H, grab a new random value on phase wrap
+            if constexpr (W == Waveform::SAMPLE_AND_HOLD) {
+                held = static_cast<SampleType>(random.nextBipolar());
+            }
+        }
+        return output;
+    }
+    
+    template <Waveform W, bool Smoothed>
+    void renderBlock(SampleType* output, int count) {
+        double phase = mPhase;
+        SampleType held = mSavedRandom;
+        SampleType smoothed = mSmoothedValue;
+        const SampleType coeff = mSmoothingCoeff;
+        FastRandom random = mRandom;
+        const double increment = mPhaseIncrement;
+        for (int i = 0; i < count; ++i) {
+            SampleType value = step<W>(phase, increment, held, random);
+            if constexpr (Smoothed) {
+                smoothed += (value - smoothed) * coeff;
+                value = smoothed;
+            }
+            output[i] = value;
+        }
+        mPhase = phase;
+        mSavedRandom = held;
+        mSmoothedValue = smoothed;
+        mRandom = random;
+    }
+    
+    // One control tick: the waveform advanced by mControlRate samples, with
+    // the smoother run at the tick rate
+    SampleType tick() {
+        const double increment = mPhaseIncrement * mControlRate;
+        SampleType value = SampleType(0);
+        switch (mWaveform) {
+            case Waveform::SINE:            value = step<Waveform::SINE>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::TRIANGLE:        value = step<Waveform::TRIANGLE>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::SAW:             value = step<Waveform::SAW>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::SQUARE:          value = step<Waveform::SQUARE>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::SAMPLE_AND_HOLD:
+            case Waveform::RANDOM:          value = step<Waveform::SAMPLE_AND_HOLD>(mPhase, increment, mSavedRandom, mRandom); break;
+            case Waveform::NOISE:           value = step<Waveform::NOISE>(mPhase, increment, mSavedRandom, mRandom); break;
+        }
+        if (isSmoothing()) {
+            mSmoothedValue += (value - mSmoothedValue) * mTickSmoothingCoeff;
+            return mSmoothedValue;
+        }
+        return value;
+    }
+    
+    template <bool Smoothed>
+    void renderBlockForWaveform(SampleType* output, int count) {
+        switch (mWaveform) {
+            case Waveform::SINE:            renderBlock<Waveform::SINE, Smoothed>(output, count); break;
+            case Waveform::TRIANGLE:        renderBlock<Waveform::TRIANGLE, Smoothed>(output, count); break;
+            case Waveform::SAW:             renderBlock<Waveform::SAW, Smoothed>(output, count); break;
+            case Waveform::SQUARE:          renderBlock<Waveform::SQUARE, Smoothed>(output, count); break;
+            case Waveform::SAMPLE_AND_HOLD:
+            case Waveform::RANDOM:          renderBlock<Waveform::SAMPLE_AND_HOLD, Smoothed>(output, count); break;
+            case Waveform::NOISE:           renderBlock<Waveform::NOISE, Smoothed>(output, count); break;
+        }
+    }
+    
+    // Free: rate in Hz. Tempo sync: one cycle per beatsPerCycle() beats.
     void updateEffectiveRate() {
         double effectiveRate = mRate;
         
-        if (mSyncMode == SyncMode::TEMPO_SYNC || mSyncMode == SyncMode::BEAT_SYNC) {
+        if (isTempoSynced()) {
             double beatsPerSecond = mTempo / 60.0;
-            
-            switch (mBeatDivision) {
-                case BeatDivision::FOUR_BARS:
-                    effectiveRate = beatsPerSecond / 16.0;
-                    break;
-                case BeatDivision::TWO_BARS:
-                    effectiveRate = beatsPerSecond / 8.0;
-                    break;
-                case BeatDivision::WHOLE:
-                    effectiveRate = beatsPerSecond / 4.0;
-                    break;
-                case BeatDivision::HALF:
-                case BeatDivision::DOTTED_HALF:
-                    effectiveRate = beatsPerSecond / 2.0;
-                    break;
-                case BeatDivision::QUARTER:
-                case BeatDivision::DOTTED_QUARTER:
-                    effectiveRate = beatsPerSecond;
-                    break;
-                case BeatDivision::EIGHTH:
-                case BeatDivision::DOTTED_EIGHTH:
-                    effectiveRate = beatsPerSecond * 2.0;
-                    break;
-                case BeatDivision::SIXTEENTH:
-                case BeatDivision::SIXTEENTH_DOT:
-                    effectiveRate = beatsPerSecond * 4.0;
-                    break;
-                case BeatDivision::THIRTY_SECOND:
-                case BeatDivision::THIRTYSECOND:
-                    effectiveRate = beatsPerSecond * 8.0;
-                    break;
-                case BeatDivision::HALF_TRIPLET:
-                case BeatDivision::TRIPLET_HALF:
-                    effectiveRate = beatsPerSecond * 3.0 / 4.0;
-                    break;
-                case BeatDivision::QUARTER_DOT:
-                    effectiveRate = beatsPerSecond * 2.0 / 3.0;
-                    break;
-                case BeatDivision::QUARTER_TRIPLET:
-                case BeatDivision::TRIPLET_QUARTER:
-                    effectiveRate = beatsPerSecond * 1.5;
-                    break;
-                case BeatDivision::EIGHTH_DOT:
-                    effectiveRate = beatsPerSecond * 4.0 / 3.0;
-                    break;
-                case BeatDivision::EIGHTH_TRIPLET:
-                case BeatDivision::TRIPLET_EIGHTH:
-                    effectiveRate = beatsPerSecond * 3.0;
-                    break;
-                case BeatDivision::SIXTEENTH_TRIPLET:
-                    effectiveRate = beatsPerSecond * 6.0;
-                    break;
-            }
+            effectiveRate = beatsPerSecond / beatsPerCycle(mBeatDivision);
         }
         
         mPhaseIncrement = effectiveRate / mSampleRate;
@@ -313,11 +473,12 @@ private:
     void updateSmoothingCoeff() {
         // One-pole lowpass coefficient
         double fc = mSmoothingCutoff / mSampleRate;
-        mSmoothingCoeff = 1.0 - std::exp(-2.0 * std::numbers::pi * fc);
+        mSmoothingCoeff = static_cast<SampleType>(1.0 - std::exp(-2.0 * std::numbers::pi * fc));
+        mTickSmoothingCoeff = static_cast<SampleType>(1.0 - std::exp(-2.0 * std::numbers::pi * fc * mControlRate));
     }
     
     double mSampleRate;
-    double mPhase;
+    double mPhase;              // Read phase, offset included
     double mPhaseIncrement;
     double mRate;
     Waveform mWaveform;
@@ -330,13 +491,20 @@ private:
     int mDelaySamples;
     int mDelayCounter;
     double mSmoothingCutoff;
-    double mSmoothingCoeff = 1.0;
+    SampleType mSmoothingCoeff = SampleType(1);
+    SampleType mTickSmoothingCoeff = SampleType(1);
+    
+    // Control-rate mode
+    int mControlRate = ControlRate::kAudioRate;
+    ControlRampT<SampleType> mRamp;
     
     // For S&H
-    double mSavedRandom;
-    double mSmoothedValue;
-    std::mt19937 mRandomGen;
-    std::uniform_real_distribution<double> mRandomDist;
+    SampleType mSavedRandom;
+    SampleType mSmoothedValue;
+    FastRandom mRandom;
 };
 
+using LFO = LFOT<double>;
+using LFOFloat = LFOT<float>;
+
 #endif // __cplusplus
@@ -8,6 +8,9 @@
 //  Phase 5: Stochastic Cloud Engine (Xenakis-inspired)
 //  Per-grain randomization for pitch, timing, formant, pan, and amplitude
 //
+//  Templated on sample type: phase accumulators and grain statistics stay
+//  double for pitch accuracy; pulsaret waveforms are evaluated in SampleType.
+//
 
 #pragma once
 
@@ -57,7 +60,8 @@ struct GrainState {
     double ampMultiplier = 1.0;       // Amplitude variation (linear)
 };
 
-class PulsarOscillator {
+template <typename SampleType>
+class PulsarOscillatorT {
 public:
     // Pulsaret waveform shapes
     enum class Shape {
@@ -67,7 +71,7 @@ public:
         TRIANGLE
     };
     
-    PulsarOscillator(double sampleRate = 44100.0)
+    PulsarOscillatorT(double sampleRate = 44100.0)
         : mSampleRate(sampleRate)
         , mPhase(0.0)
         , mPhaseIncrement(0.0)
@@ -78,6 +82,7 @@ public:
         , mCurrentGrain()
         , mRng(0)
         , mInGrain(false)
+        , mGrainStarted(false)
         , mAsyncPhase(0.0)
         , mAsyncPhaseIncrement(0.0)
         , mTimingJitterCounter(0.0)
@@ -195,6 +200,12 @@ public:
     // Get current grain state (for external use - formant/pan applied by voice)
     GrainState getCurrentGrainState() const { return mCurrentGrain; }
     
+    // True only for the process() call in which a new grain was randomized.
+    // Lets the voice latch per-grain state (formant and pan scatter) at grain rate.
+    bool grainStarted() const { return mGrainStarted; }
+    double getGrainFormantOffset() const { return mCurrentGrain.formantOffsetHz; }
+    double getGrainPanOffset() const { return mCurrentGrain.panOffset; }
+    
     // Seed the RNG for reproducible results
     void seedRNG(unsigned int seed) {
         mRng.seed(seed);
@@ -204,19 +215,21 @@ public:
         mPhase = 0.0;
         mAsyncPhase = 0.0;
         mInGrain = false;
+        mGrainStarted = false;
         mTimingJitterCounter = 0.0;
         mCurrentGrain = GrainState();
     }
     
     // Process one sample
-    double process() {
-        double output = 0.0;
+    SampleType process() {
+        SampleType output = SampleType(0);
+        mGrainStarted = false;
         
         // Handle timing jitter countdown
         if (mTimingJitterCounter > 0) {
             mTimingJitterCounter -= 1.0;
             advancePhases();
-            return 0.0;
+            return SampleType(0);
         }
         
         // Get the current phase for grain window detection
@@ -230,13 +243,14 @@ public:
         // Detect grain start: entering grain window when we weren't in one
         if (inGrainWindow && !mInGrain) {
             mInGrain = true;
+            mGrainStarted = true;
             randomizeGrain();
             
             // Apply timing jitter (delays grain start)
             if (mCurrentGrain.timingOffsetSamples > 0) {
                 mTimingJitterCounter = mCurrentGrain.timingOffsetSamples;
                 advancePhases();
-                return 0.0;
+                return SampleType(0);
             }
         } else if (!inGrainWindow && mInGrain) {
             // Exiting grain window
@@ -246,7 +260,7 @@ public:
         // Generate output if in grain window
         if (inGrainWindow) {
             // Normalize phase within pulsaret (0 to 1)
-            double pulsaretPhase = grainPhase / mDutyCycle;
+            SampleType pulsaretPhase = static_cast<SampleType>(grainPhase / mDutyCycle);
             
             switch (mShape) {
                 case Shape::GAUSSIAN:
@@ -264,7 +278,7 @@ public:
             }
             
             // Apply amplitude scatter
-            output *= mCurrentGrain.ampMultiplier;
+            output *= static_cast<SampleType>(mCurrentGrain.ampMultiplier);
         }
         
         // Advance phases
@@ -273,7 +287,7 @@ public:
         return output;
     }
     
-    void processBlock(double* output, int numSamples) {
+    void processBlock(SampleType* output, int numSamples) {
         for (int i = 0; i < numSamples; ++i) {
             output[i] = process();
         }
@@ -357,35 +371,37 @@ private:
     }
     
     // Gaussian window (bell curve)
-    double generateGaussian(double phase) {
+    SampleType generateGaussian(SampleType phase) {
         // Map 0-1 to -3 to +3 standard deviations
-        double x = (phase - 0.5) * 6.0;
-        return std::exp(-0.5 * x * x);
+        SampleType x = (phase - SampleType(0.5)) * SampleType(6);
+        return std::exp(SampleType(-0.5) * x * x);
     }
     
     // Raised cosine (Hann-like envelope * sine carrier)
-    double generateRaisedCosine(double phase) {
+    SampleType generateRaisedCosine(SampleType phase) {
         // Hann window
-        double envelope = 0.5 * (1.0 - std::cos(2.0 * std::numbers::pi * phase));
+        SampleType envelope = SampleType(0.5) * (SampleType(1) - std::cos(kTwoPi * phase));
         // Sine carrier at the fundamental
-        double carrier = std::sin(2.0 * std::numbers::pi * phase);
+        SampleType carrier = std::sin(kTwoPi * phase);
         return envelope * carrier;
     }
     
     // Full sine wave within the pulsaret
-    double generateSine(double phase) {
-        return std::sin(2.0 * std::numbers::pi * phase);
+    SampleType generateSine(SampleType phase) {
+        return std::sin(kTwoPi * phase);
     }
     
     // Triangle wave within the pulsaret
-    double generateTriangle(double phase) {
-        if (phase < 0.5) {
-            return 4.0 * phase - 1.0;
+    SampleType generateTriangle(SampleType phase) {
+        if (phase < SampleType(0.5)) {
+            return SampleType(4) * phase - SampleType(1);
         } else {
-            return 3.0 - 4.0 * phase;
+            return SampleType(3) - SampleType(4) * phase;
         }
     }
     
+    static constexpr SampleType kTwoPi = SampleType(2.0 * std::numbers::pi);
+    
     double mSampleRate;
     double mPhase;
     double mPhaseIncrement;
@@ -398,6 +414,7 @@ private:
     GrainState mCurrentGrain;
     StochasticDistribution mRng;
     bool mInGrain;
+    bool mGrainStarted;
     
     // Async mode (grain density independent of pitch)
     double mAsyncPhase;
@@ -407,4 +424,7 @@ private:
     double mTimingJitterCounter;
 };
 
+using PulsarOscillator = PulsarOscillatorT<double>;
+using PulsarOscillatorFloat = PulsarOscillatorT<float>;
+
 #endif // __cplusplus
@@ -138,9 +138,39 @@ public:
     
     bool isEvenStep() const { return mIsEvenStep; }
     
+    // Length of one ramp cycle in quarter-note beats
+    static double beatsPerCycle(BeatDivision division) {
+        switch (division) {
+            case BeatDivision::FOUR_BARS:         return 16.0;
+            case BeatDivision::TWO_BARS:          return 8.0;
+            case BeatDivision::WHOLE:             return 4.0;
+            case BeatDivision::HALF_DOT:          return 3.0;
+            case BeatDivision::HALF:              return 2.0;
+            case BeatDivision::HALF_TRIPLET:      return 4.0 / 3.0;
+            case BeatDivision::QUARTER_DOT:       return 1.5;
+            case BeatDivision::QUARTER:           return 1.0;
+            case BeatDivision::QUARTER_TRIPLET:   return 2.0 / 3.0;
+            case BeatDivision::EIGHTH_DOT:        return 0.75;
+            case BeatDivision::EIGHTH:            return 0.5;
+            case BeatDivision::EIGHTH_TRIPLET:    return 1.0 / 3.0;
+            case BeatDivision::SIXTEENTH_DOT:     return 0.375;
+            case BeatDivision::SIXTEENTH:         return 0.25;
+            case BeatDivision::SIXTEENTH_TRIPLET: return 1.0 / 6.0;
+            case BeatDivision::THIRTYSECOND:      return 0.125;
+        }
+        return 1.0;
+    }
+    
+    // Set the phase (and cycle count / swing parity) to where a ramp started
+    // at beat 0 would be at beatPosition. In BEAT_SYNC mode one cycle spans
+    // the beat division; a free-running ramp treats one cycle as one beat.
     void syncToBeatPosition(double beatPosition) {
-        // Set phase based on beat position
-        mPhase = std::fmod(beatPosition, 1.0);
+        double length = (mSyncMode == SyncMode::BEAT_SYNC) ? beatsPerCycle(mBeatDivision) : 1.0;
+        double cycles = beatPosition / length;
+        double whole = std::floor(cycles);
+        mPhase = cycles - whole;
+        mCycleCount = static_cast<int>(whole);
+        mIsEvenStep = (mCycleCount % 2) == 0;
     }
     
     // Process one sample, returns struct with phase info
@@ -178,57 +208,7 @@ private:
         if (mSyncMode == SyncMode::BEAT_SYNC) {
             // Convert beat division to Hz based on tempo
             double beatsPerSecond = mTempo / 60.0;
-            
-            switch (mBeatDivision) {
-                case BeatDivision::FOUR_BARS:
-                    effectiveRate = beatsPerSecond / 16.0;
-                    break;
-                case BeatDivision::TWO_BARS:
-                    effectiveRate = beatsPerSecond / 8.0;
-                    break;
-                case BeatDivision::WHOLE:
-                    effectiveRate = beatsPerSecond / 4.0;
-                    break;
-                case BeatDivision::HALF_DOT:
-                    effectiveRate = beatsPerSecond / 3.0;
-                    break;
-                case BeatDivision::HALF:
-                    effectiveRate = beatsPerSecond / 2.0;
-                    break;
-                case BeatDivision::HALF_TRIPLET:
-                    effectiveRate = beatsPerSecond * 3.0 / 4.0;
-                    break;
-                case BeatDivision::QUARTER_DOT:
-                    effectiveRate = beatsPerSecond * 2.0 / 3.0;
-                    break;
-                case BeatDivision::QUARTER:
-                    effectiveRate = beatsPerSecond;
-                    break;
-                case BeatDivision::QUARTER_TRIPLET:
-                    effectiveRate = beatsPerSecond * 1.5;
-                    break;
-                case BeatDivision::EIGHTH_DOT:
-                    effectiveRate = beatsPerSecond * 4.0 / 3.0;
-                    break;
-                case BeatDivision::EIGHTH:
-                    effectiveRate = beatsPerSecond * 2.0;
-                    break;
-                case BeatDivision::EIGHTH_TRIPLET:
-                    effectiveRate = beatsPerSecond * 3.0;
-                    break;
-                case BeatDivision::SIXTEENTH_DOT:
-                    effectiveRate = beatsPerSecond * 8.0 / 3.0;
-                    break;
-                case BeatDivision::SIXTEENTH:
-                    effectiveRate = beatsPerSecond * 4.0;
-                    break;
-                case BeatDivision::SIXTEENTH_TRIPLET:
-                    effectiveRate = beatsPerSecond * 6.0;
-                    break;
-                case BeatDivision::THIRTYSECOND:
-                    effectiveRate = beatsPerSecond * 8.0;
-                    break;
-            }
+            effectiveRate = beatsPerSecond / beatsPerCycle(mBeatDivision);
         }
         
         mPhaseIncrement = effectiveRate / mSampleRate;
@@ -0,0 +1,170 @@
+//
+//  ControlRate.h
+//  VoxCore
+//
+//  Control-rate evaluation for modulation sources. A source running at
+//  control rate computes one value every N samples (a control tick) and
+//  hands consumers a linear ramp from the previous tick value to the new one,
+//  so per-sample cost drops to one add. N = 1 is audio rate and leaves every
+//  source on its original per-sample path.
+//
+//  The rate is a quality setting: kControlRateChoices lists the values the
+//  plugin exposes, from best (audio rate) to cheapest.
+//
+//  Sources with visible curvature between ticks (the chaos attractors) use
+//  ControlCubicT instead: Catmull-Rom through the last four tick values, one
+//  tick behind the newest value.
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <algorithm>
+
+struct ControlRate {
+    static constexpr int kAudioRate = 1;
+    static constexpr int kMaxSamplesPerTick = 64;
+    static constexpr int kNumChoices = 5;
+    static constexpr int kChoices[kNumChoices] = { 1, 8, 16, 32, 64 };
+
+    // Samples per tick for a quality index (0 = audio rate ... 4 = every 64)
+    static int samplesForChoice(int index) {
+        return kChoices[std::max(0, std::min(kNumChoices - 1, index))];
+    }
+
+    static int clampSamples(int samplesPerTick) {
+        return std::max(kAudioRate, std::min(kMaxSamplesPerTick, samplesPerTick));
+    }
+};
+
+// Linear ramp between control ticks. setTarget() starts a ramp of N samples;
+// the last sample of the ramp lands exactly on the target so rounding never
+// accumulates across ticks.
+template <typename T>
+class ControlRampT {
+public:
+    void reset(T value) {
+        mValue = value;
+        mTarget = value;
+        mStep = T(0);
+        mRemaining = 0;
+    }
+
+    bool needsTick() const { return mRemaining == 0; }
+    int getRemaining() const { return mRemaining; }
+    T getValue() const { return mValue; }
+    T getTarget() const { return mTarget; }
+
+    void setTarget(T target, int samples) {
+        mTarget = target;
+        mStep = (target - mValue) / static_cast<T>(samples);
+        mRemaining = samples;
+    }
+
+    // Next ramp value; only call while getRemaining() > 0
+    T next() {
+        if (--mRemaining == 0) {
+            mValue = mTarget;
+        } else {
+            mValue += mStep;
+        }
+        return mValue;
+    }
+
+    // Skip count <= getRemaining() samples and return the value reached;
+    // lands exactly on the target at the end of the ramp
+    T skip(int count) {
+        if (count >= mRemaining) {
+            mValue = mTarget;
+            mRemaining = 0;
+        } else {
+            mValue += mStep * static_cast<T>(count);
+            mRemaining -= count;
+        }
+        return mValue;
+    }
+
+    // Write count <= getRemaining() ramp values; same values as next()
+    void fill(T* output, int count) {
+        T value = mValue;
+        const T step = mStep;
+        const int ramped = (count == mRemaining) ? count - 1 : count;
+        for (int i = 0; i < ramped; ++i) {
+            value += step;
+            output[i] = value;
+        }
+        if (ramped < count) {
+            value = mTarget;
+            output[ramped] = value;
+        }
+        mValue = value;
+        mRemaining -= count;
+    }
+
+private:
+    T mValue = T(0);
+    T mTarget = T(0);
+    T mStep = T(0);
+    int mRemaining = 0;
+};
+
+using ControlRamp = ControlRampT<double>;
+
+// Catmull-Rom interpolation between control ticks. pushTarget() adds the
+// newest tick value and starts a segment between the two values before it,
+// so the output lags the source by one tick in exchange for a continuous
+// slope. Like ControlRampT, the last sample of a segment lands exactly on
+// its end value.
+template <typename T>
+class ControlCubicT {
+public:
+    void reset(T value) {
+        mP0 = mP1 = mP2 = mP3 = value;
+        mA = mB = mC = T(0);
+        mValue = value;
+        mT = T(0);
+        mStep = T(0);
+        mRemaining = 0;
+    }
+
+    bool needsTick() const { return mRemaining == 0; }
+    int getRemaining() const { return mRemaining; }
+    T getValue() const { return mValue; }
+
+    void pushTarget(T target, int samples) {
+        mP0 = mP1;
+        mP1 = mP2;
+        mP2 = mP3;
+        mP3 = target;
+        mA = T(-0.5) * mP0 + T(1.5) * mP1 - T(1.5) * mP2 + T(0.5) * mP3;
+        mB = mP0 - T(2.5) * mP1 + T(2) * mP2 - T(0.5) * mP3;
+        mC = T(0.5) * (mP2 - mP0);
+        mT = T(0);
+        mStep = T(1) / static_cast<T>(samples);
+        mRemaining = samples;
+    }
+
+    // Next interpolated value; only call while getRemaining() > 0
+    T next() {
+        if (--mRemaining == 0) {
+            mValue = mP2;
+        } else {
+            mT += mStep;
+            mValue = ((mA * mT + mB) * mT + mC) * mT + mP1;
+        }
+        return mValue;
+    }
+
+private:
+    T mP0 = T(0), mP1 = T(0), mP2 = T(0), mP3 = T(0);
+    T mA = T(0), mB = T(0), mC = T(0);
+    T mValue = T(0);
+    T mT = T(0);
+    T mStep = T(0);
+    int mRemaining = 0;
+};
+
+using ControlCubic = ControlCubicT<double>;
+
+#endif // __cplusplus
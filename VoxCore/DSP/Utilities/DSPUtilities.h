@@ -5,8 +5,13 @@
 //  Created by Mark Pauley on 5/18/25.
 //
 
+#pragma once
+
 #ifdef __cplusplus
 
+#include <cstdint>
+#include <cmath>
+
 struct DSPUtilities {
 public:
     static inline float clamp(float value, float min, float max) {
@@ -31,6 +36,62 @@ public:
             return a / b;
         }
     }
+
+    // sin(2*pi*phase) for phase in [0, 1) without a libm call. The phase is
+    // folded onto a quarter wave, then a degree-13 odd Taylor polynomial is
+    // evaluated on [-pi/2, pi/2]: max error < 1e-9, exact at 0 and the peaks.
+    static inline double sinTurns(double phase) {
+        // sin(2*pi*p) = -sin(2*pi*r), r = p - 0.5 in [-0.5, 0.5); fold |r| > 0.25
+        double r = phase - 0.5;
+        double a = std::abs(r);
+        double q = std::copysign(0.25 - std::abs(0.25 - a), r);
+        double z = q * 6.283185307179586;
+        double z2 = z * z;
+        double p = 1.6059043836821613e-10;
+        p = p * z2 - 2.505210838544172e-08;
+        p = p * z2 + 2.7557319223985893e-06;
+        p = p * z2 - 0.0001984126984126984;
+        p = p * z2 + 0.008333333333333333;
+        p = p * z2 - 0.16666666666666666;
+        p = p * z2 + 1.0;
+        return -(z * p);
+    }
+};
+
+// Compact xorshift64* generator for the render thread: 8 bytes of state,
+// no allocation and no std::random_device syscall at construction.
+struct FastRandom {
+    explicit FastRandom(uint64_t seed = 0x9E3779B97F4A7C15ull) { setSeed(seed); }
+
+    // Any seed is accepted; it is scrambled with splitmix64 so nearby seeds
+    // (voice indices, addresses) give unrelated streams and zero never sticks.
+    void setSeed(uint64_t seed) {
+        uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        mState = z ? z : 0x9E3779B97F4A7C15ull;
+    }
+
+    uint64_t next() {
+        mState ^= mState >> 12;
+        mState ^= mState << 25;
+        mState ^= mState >> 27;
+        return mState * 0x2545F4914F6CDD1Dull;
+    }
+
+    // Uniform in [0, 1) with 53 bits of resolution
+    double nextUnipolar() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    // Uniform in [-1, 1)
+    double nextBipolar() {
+        return nextUnipolar() * 2.0 - 1.0;
+    }
+
+private:
+    uint64_t mState = 0;
 };
 
 #endif
@@ -0,0 +1,147 @@
+//
+//  ParameterSlots.h
+//  VoxCore
+//
+//  Wait-free parameter handoff between control threads (UI, state restore)
+//  and the render thread. Raw values live in a dense array of atomics indexed
+//  by parameter address, so loads and stores never lock or allocate.
+//
+//  A control-thread write() also sets the address's bit in a changed mask.
+//  At a block boundary the render thread takes the mask (one exchange per 64
+//  addresses) and re-applies only those addresses on top of its own
+//  parameter set. Values the render thread applied itself (automation, via
+//  store()) are never overwritten by an older copy of the whole set, as a
+//  published snapshot would do.
+//
+//  Ordering: a write stores the value before setting its bit (release), and
+//  takeChanges() clears the bits before the caller loads the values
+//  (acquire), so every address taken is read at its newest value or later.
+//  A write landing after the take sets its bit again and is picked up at the
+//  next boundary.
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+// Addresses written by control threads since the last takeChanges()
+struct ParameterChanges {
+    static constexpr int kWords = 2;
+
+    std::array<uint64_t, kWords> bits{};
+
+    bool empty() const {
+        for (uint64_t word : bits) {
+            if (word != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool contains(int address) const {
+        return address >= 0 && address < kWords * 64 &&
+               ((bits[address >> 6] >> (address & 63)) & 1) != 0;
+    }
+
+    // First changed address >= from, or -1
+    int next(int from) const {
+        for (int w = std::max(0, from) >> 6; w < kWords; ++w) {
+            uint64_t word = bits[w];
+            if (w == (from >> 6) && from > 0) {
+                word &= ~uint64_t(0) << (from & 63);
+            }
+            if (word != 0) {
+                return w * 64 + std::countr_zero(word);
+            }
+        }
+        return -1;
+    }
+};
+
+class ParameterSlots {
+public:
+    static constexpr int kNumSlots = ParameterChanges::kWords * 64;
+
+    ParameterSlots() {
+        for (std::atomic<float>& value : mValues) {
+            value.store(0.0f, std::memory_order_relaxed);
+        }
+    }
+
+    // A copy takes the values and changed mask as they are; never copy slots
+    // other threads are writing
+    ParameterSlots(const ParameterSlots& other) {
+        *this = other;
+    }
+
+    ParameterSlots& operator=(const ParameterSlots& other) {
+        for (int i = 0; i < kNumSlots; ++i) {
+            mValues[i].store(other.mValues[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (int w = 0; w < ParameterChanges::kWords; ++w) {
+            mChanged[w].store(other.mChanged[w].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    static bool isValid(uint64_t address) {
+        return address < static_cast<uint64_t>(kNumSlots);
+    }
+
+    // Any thread; 0 for addresses out of range
+    float load(uint64_t address) const {
+        return isValid(address) ? mValues[address].load(std::memory_order_relaxed) : 0.0f;
+    }
+
+    // Render thread: record a value the render side has already applied
+    bool store(uint64_t address, float value) {
+        if (!isValid(address)) {
+            return false;
+        }
+        mValues[address].store(value, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Control threads: record a value for the render thread to pick up
+    bool write(uint64_t address, float value) {
+        if (!store(address, value)) {
+            return false;
+        }
+        mChanged[address >> 6].fetch_or(uint64_t(1) << (address & 63), std::memory_order_release);
+        return true;
+    }
+
+    bool hasChanges() const {
+        for (const std::atomic<uint64_t>& word : mChanged) {
+            if (word.load(std::memory_order_relaxed) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Render thread: take (and clear) the addresses written since the last
+    // call; load() them afterwards
+    ParameterChanges takeChanges() {
+        ParameterChanges changes;
+        for (int w = 0; w < ParameterChanges::kWords; ++w) {
+            if (mChanged[w].load(std::memory_order_relaxed) != 0) {
+                changes.bits[w] = mChanged[w].exchange(0, std::memory_order_acquire);
+            }
+        }
+        return changes;
+    }
+
+private:
+    std::array<std::atomic<float>, kNumSlots> mValues;
+    std::array<std::atomic<uint64_t>, ParameterChanges::kWords> mChanged{};
+};
+
+#endif // __cplusplus
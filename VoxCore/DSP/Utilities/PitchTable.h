@@ -0,0 +1,78 @@
+//
+//  PitchTable.h
+//  VoxCore
+//
+//  Log-frequency pitch math for the voice without libm pow calls. Pitch is
+//  carried in semitones (or cents) and turned into a frequency ratio with
+//  exp2(): the octave part is written straight into the exponent bits of a
+//  double and the remainder in [-0.5, 0.5] octave goes through a degree-6
+//  polynomial. Whole octaves are exact; anything else is within 0.001 cents
+//  (relative error < 6e-7), far below the ~5 cent pitch JND.
+//
+//  MIDI notes 0-127 come from a table built once with std::pow, so note
+//  frequencies are bit-identical to the reference formula.
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+struct PitchTable {
+    static constexpr int kNumNotes = 128;
+    static constexpr double kMaxErrorCents = 0.001;
+
+    // 2^x. Whole octaves are exact; |x| beyond +-1022 saturates.
+    static inline double exp2(double x) {
+        x = x < -1022.0 ? -1022.0 : (x > 1023.0 ? 1023.0 : x);
+        double octave = std::floor(x + 0.5);
+        double f = x - octave;  // [-0.5, 0.5]
+        // Taylor series of e^(f ln 2); truncation error < 2e-7 on the interval
+        double p = 1.5403530393381606e-04;
+        p = p * f + 1.3333558146428443e-03;
+        p = p * f + 9.6181291076284772e-03;
+        p = p * f + 5.5504108664821580e-02;
+        p = p * f + 2.4022650695910071e-01;
+        p = p * f + 6.9314718055994531e-01;
+        p = p * f + 1.0;
+        uint64_t bits = static_cast<uint64_t>(static_cast<int64_t>(octave) + 1023) << 52;
+        return p * std::bit_cast<double>(bits);
+    }
+
+    // Frequency ratio of an interval in semitones
+    static inline double semitonesToRatio(double semitones) {
+        return exp2(semitones * (1.0 / 12.0));
+    }
+
+    // Frequency ratio of an interval in cents
+    static inline double centsToRatio(double cents) {
+        return exp2(cents * (1.0 / 1200.0));
+    }
+
+    // Equal-tempered frequency of a MIDI note (A4 = 69 = 440 Hz); table
+    // lookup for 0-127
+    static inline double noteToFrequency(int noteNumber) {
+        if (noteNumber >= 0 && noteNumber < kNumNotes) {
+            return noteFrequencies()[noteNumber];
+        }
+        return 440.0 * semitonesToRatio(noteNumber - 69);
+    }
+
+private:
+    static const std::array<double, kNumNotes>& noteFrequencies() {
+        static const std::array<double, kNumNotes> table = [] {
+            std::array<double, kNumNotes> frequencies{};
+            for (int note = 0; note < kNumNotes; ++note) {
+                frequencies[note] = 440.0 * std::pow(2.0, (note - 69) / 12.0);
+            }
+            return frequencies;
+        }();
+        return table;
+    }
+};
+
+#endif // __cplusplus
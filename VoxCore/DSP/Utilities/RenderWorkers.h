@@ -0,0 +1,318 @@
+//
+//  RenderWorkers.h
+//  VoxCore
+//
+//  Fixed pool of render worker threads for fork-join work on the render
+//  thread. The threads are created by setThreadCount() (not on the render
+//  thread); run() then hands a batch of numbered tasks to the caller and the
+//  workers without allocating or taking a lock.
+//
+//  Handoff: one 64-bit word carries a generation and the batch's task
+//  counter. run() publishes a new generation; idle workers spin on the word
+//  for kSpinCount polls and then sleep in a C++20 atomic wait, so a steady
+//  stream of render spans never reaches the kernel. Tasks are claimed one at
+//  a time with a compare-exchange, the caller works through the batch too,
+//  and run() returns once every task has finished (the caller spins, then
+//  waits, on the pending count).
+//
+//  Which thread runs a task varies from batch to batch; callers that need
+//  deterministic results give each task its own output and combine them in
+//  task order afterwards. The thread index passed to a task (0 = caller)
+//  selects per-thread scratch.
+//
+//  run() blocks the render thread until the workers finish, so the workers
+//  must be scheduled like it. Each new worker runs a setup hook before its
+//  first task, and setThreadCount() returns once every worker has run it.
+//  The default hook gives the worker a real-time policy for the render
+//  period: the Mach time-constraint policy on Apple platforms and SCHED_FIFO
+//  elsewhere. A host with an audio workgroup passes a hook that joins the
+//  worker to it instead.
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+#include <mach/thread_policy.h>
+#include <pthread.h>
+#elif defined(__unix__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+class RenderWorkers {
+public:
+    // Task callback: context, task index (0 to taskCount - 1), thread index
+    using Task = void (*)(void* context, int task, int thread);
+
+    // Worker setup hook, run on each new worker thread (index 1 and up)
+    // before its first task; returns whether the thread now runs on the
+    // render thread's real-time schedule
+    using ThreadSetup = bool (*)(void* context, int thread);
+
+    static constexpr int kMaxThreads = 16;      // Caller included
+    static constexpr int kMaxTasks = 0xFFFF;
+    static constexpr int kSpinCount = 4096;     // Polls before sleeping
+
+    // Render period the default setup schedules workers for (512 samples at
+    // 44.1 kHz), and the share of it a worker may compute
+    static constexpr double kDefaultRealtimePeriod = 512.0 / 44100.0;
+    static constexpr double kRealtimeComputeFraction = 0.5;
+
+    RenderWorkers() = default;
+
+    ~RenderWorkers() {
+        stopWorkers();
+    }
+
+    RenderWorkers(const RenderWorkers&) = delete;
+    RenderWorkers& operator=(const RenderWorkers&) = delete;
+
+    // Threads taking part in run(), the caller included (1 = no workers).
+    // Starts or stops worker threads and returns once every new worker has
+    // run the setup hook; not for the render thread.
+    void setThreadCount(int count) {
+        count = std::max(1, std::min(kMaxThreads, count));
+        if (count == getThreadCount()) {
+            return;
+        }
+        stopWorkers();
+        startWorkers(count);
+    }
+
+    int getThreadCount() const {
+        return static_cast<int>(mWorkers.size()) + 1;
+    }
+
+    // Setup hook for new workers (nullptr restores the default real-time
+    // policy). Running workers are restarted with it.
+    void setThreadSetup(ThreadSetup setup, void* context) {
+        mThreadSetup = setup;
+        mThreadSetupContext = context;
+        restartWorkers();
+    }
+
+    // Render period (seconds per render call) of the default real-time
+    // policy; 0 leaves workers at default priority. Running workers are
+    // restarted with it.
+    void setRealtimePeriod(double seconds) {
+        mRealtimePeriod = std::max(0.0, seconds);
+        restartWorkers();
+    }
+
+    double getRealtimePeriod() const {
+        return mRealtimePeriod;
+    }
+
+    // Workers whose setup succeeded (running on the real-time schedule)
+    int getRealtimeWorkerCount() const {
+        return mRealtimeWorkers.load();
+    }
+
+    // Give the calling thread a real-time policy for a render period of
+    // periodSeconds; false if the platform or the process's limits refuse
+    static bool promoteToRealtime(double periodSeconds) {
+        if (periodSeconds <= 0.0) {
+            return false;
+        }
+#if defined(__APPLE__)
+        mach_timebase_info_data_t timebase;
+        if (mach_timebase_info(&timebase) != KERN_SUCCESS) {
+            return false;
+        }
+        const double ticksPerSecond = 1.0e9 * timebase.denom / timebase.numer;
+        thread_time_constraint_policy_data_t policy;
+        policy.period = static_cast<uint32_t>(periodSeconds * ticksPerSecond);
+        policy.computation = static_cast<uint32_t>(periodSeconds * kRealtimeComputeFraction * ticksPerSecond);
+        policy.constraint = policy.period;
+        policy.preemptible = true;
+        return thread_policy_set(pthread_mach_thread_np(pthread_self()), THREAD_TIME_CONSTRAINT_POLICY,
+                                 reinterpret_cast<thread_policy_t>(&policy),
+                                 THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
+#elif defined(__unix__)
+        // Audio threads on these systems typically run just below the top
+        // FIFO priorities
+        sched_param param{};
+        param.sched_priority = std::max(sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO) - 10);
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+        return false;
+#endif
+    }
+
+    // Run task(context, t, thread) for every t in [0, taskCount) across the
+    // caller and the workers; returns when all tasks are done
+    void run(Task task, void* context, int taskCount) {
+        taskCount = std::min(taskCount, kMaxTasks);
+        if (mWorkers.empty() || taskCount <= 1) {
+            for (int t = 0; t < taskCount; ++t) {
+                task(context, t, 0);
+            }
+            return;
+        }
+
+        // Every claim of the previous batch has finished, so no worker reads
+        // the task fields until the new word below is published
+        mTask = task;
+        mContext = context;
+        mPending.store(taskCount, std::memory_order_relaxed);
+        const uint64_t generation = (mClaim.load(std::memory_order_relaxed) >> 32) + 1;
+        mClaim.store((generation << 32) | (static_cast<uint64_t>(taskCount) << 16));
+        if (mSleeping.load() > 0) {
+            mClaim.notify_all();
+        }
+
+        runTasks(0);
+        waitForTasks();
+    }
+
+private:
+    static constexpr uint64_t kFieldMask = 0xFFFF;
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __builtin_arm_yield();
+#endif
+    }
+
+    void startWorkers(int count) {
+        mStop.store(false);
+        mRealtimeWorkers.store(0);
+        mStartedWorkers.store(0);
+        // Workers start from the current generation even if they first run
+        // after later batches have been published
+        const uint64_t generation = mClaim.load() >> 32;
+        mWorkers.reserve(count - 1);
+        for (int thread = 1; thread < count; ++thread) {
+            mWorkers.emplace_back([this, thread, generation] {
+                setupWorker(thread);
+                workerLoop(thread, generation);
+            });
+        }
+        for (int started = mStartedWorkers.load(); started < count - 1; started = mStartedWorkers.load()) {
+            mStartedWorkers.wait(started);
+        }
+    }
+
+    void restartWorkers() {
+        const int count = getThreadCount();
+        if (count > 1) {
+            stopWorkers();
+            startWorkers(count);
+        }
+    }
+
+    void setupWorker(int thread) {
+        const bool realtime = mThreadSetup ? mThreadSetup(mThreadSetupContext, thread)
+                                           : promoteToRealtime(mRealtimePeriod);
+        if (realtime) {
+            mRealtimeWorkers.fetch_add(1);
+        }
+        mStartedWorkers.fetch_add(1);
+        mStartedWorkers.notify_all();
+    }
+
+    // Claim and run tasks of the current batch until none are left
+    void runTasks(int thread) {
+        uint64_t claim = mClaim.load(std::memory_order_acquire);
+        for (;;) {
+            const int next = static_cast<int>(claim & kFieldMask);
+            const int count = static_cast<int>((claim >> 16) & kFieldMask);
+            if (next >= count) {
+                return;
+            }
+            if (!mClaim.compare_exchange_weak(claim, claim + 1, std::memory_order_acq_rel)) {
+                continue;
+            }
+            mTask(mContext, next, thread);
+            if (mPending.fetch_sub(1, std::memory_order_acq_rel) == 1 && mCallerWaiting.load()) {
+                mPending.notify_one();
+            }
+            claim = mClaim.load(std::memory_order_acquire);
+        }
+    }
+
+    void waitForTasks() {
+        for (int spin = 0; spin < kSpinCount; ++spin) {
+            if (mPending.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+            cpuRelax();
+        }
+        mCallerWaiting.store(true);
+        for (int pending = mPending.load(); pending != 0; pending = mPending.load()) {
+            mPending.wait(pending);
+        }
+        mCallerWaiting.store(false);
+    }
+
+    void workerLoop(int thread, uint64_t generation) {
+        for (;;) {
+            uint64_t claim = mClaim.load(std::memory_order_acquire);
+            for (int spin = 0; spin < kSpinCount && (claim >> 32) == generation; ++spin) {
+                cpuRelax();
+                claim = mClaim.load(std::memory_order_acquire);
+            }
+            while ((claim >> 32) == generation) {
+                mSleeping.fetch_add(1);
+                mClaim.wait(claim);
+                mSleeping.fetch_sub(1);
+                claim = mClaim.load(std::memory_order_acquire);
+            }
+            generation = claim >> 32;
+            if (mStop.load()) {
+                return;
+            }
+            runTasks(thread);
+        }
+    }
+
+    void stopWorkers() {
+        if (mWorkers.empty()) {
+            return;
+        }
+        mStop.store(true);
+        mClaim.store(((mClaim.load() >> 32) + 1) << 32);
+        mClaim.notify_all();
+        for (std::thread& worker : mWorkers) {
+            worker.join();
+        }
+        mWorkers.clear();
+    }
+
+    std::vector<std::thread> mWorkers;
+
+    // Worker setup (set between thread starts)
+    ThreadSetup mThreadSetup = nullptr;
+    void* mThreadSetupContext = nullptr;
+    double mRealtimePeriod = kDefaultRealtimePeriod;
+    std::atomic<int> mStartedWorkers{0};
+    std::atomic<int> mRealtimeWorkers{0};
+
+    // Current batch (written by run() between batches)
+    Task mTask = nullptr;
+    void* mContext = nullptr;
+
+    std::atomic<uint64_t> mClaim{0};    // generation << 32 | count << 16 | next
+    std::atomic<int> mPending{0};       // Tasks of the batch not yet finished
+    std::atomic<int> mSleeping{0};      // Workers in the atomic wait
+    std::atomic<bool> mCallerWaiting{false};
+    std::atomic<bool> mStop{false};
+};
+
+#endif // __cplusplus
@@ -0,0 +1,322 @@
+//
+//  ExpressionRouter.h
+//  VoxCore
+//
+//  Routes MPE and MIDI 2.0 per-note expression to the notes of a voice pool.
+//
+//  MPE splits the 16 channels into zones. The lower zone's master is
+//  channel 0 (MIDI channel 1) with member channels 1..L; the upper zone's
+//  master is channel 15 with members 15-U..14. Every sounding note gets a
+//  member channel of its own, and that channel's pitch bend, channel
+//  pressure and CC74 (timbre) shape only that note. Bends on a master
+//  channel, or on a channel outside every zone, still bend the whole pool.
+//  Zones come from the MPE Configuration Message (RPN 6 on a master
+//  channel) or setZones(); with no zone configured every channel behaves as
+//  it did before MPE.
+//
+//  Notes are keyed by (channel, note): the same note number held on two
+//  member channels is two notes with voices of their own, and a note-off or
+//  expression reaches only the voices its channel started. All lookups are
+//  table lookups: channel -> sounding note is an array index, and (channel,
+//  note) -> voices is the allocator's per-note list. Channel expression is
+//  kept per channel and applied right after the note-on, since MPE senders
+//  set a member channel's bend, pressure and timbre before starting its
+//  note. A released note keeps following its channel until the channel
+//  starts another note.
+//
+//  MIDI 2.0 per-note messages (per-note pitch bend, poly pressure,
+//  per-note controller 74) address the (channel, note) directly and need no
+//  zone.
+//
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include "VoicePool.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+template <typename PoolType>
+class ExpressionRouterT {
+public:
+    static constexpr int kNumChannels = 16;
+    static constexpr int kNumNotes = 128;
+    static constexpr int kLowerMaster = 0;
+    static constexpr int kUpperMaster = 15;
+
+    static constexpr double kDefaultMasterBendRange = 2.0;    // semitones
+    static constexpr double kDefaultMemberBendRange = 48.0;   // semitones (MPE default)
+
+    // Controllers and registered parameters handled here
+    static constexpr int kTimbreController = 74;
+    static constexpr int kBendSensitivityRPN = 0;
+    static constexpr int kMPEConfigurationRPN = 6;
+    static constexpr int kNoteBendSensitivityRPN = 7;         // MIDI 2.0 per-note bend
+
+    ExpressionRouterT() {
+        mChannelZone.fill(-1);
+        reset();
+    }
+
+    // Forget sounding notes and channel expression; zones and bend ranges
+    // are kept
+    void reset() {
+        mChannelNote.fill(-1);
+        mChannelBend.fill(0.0);
+        mChannelPressure.fill(0.0);
+        mChannelTimbre.fill(0.0);
+        mRPNMsb.fill(kNullRPN);
+        mRPNLsb.fill(kNullRPN);
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // Zones and bend ranges
+    // ═══════════════════════════════════════════════════════════════
+
+    // Member channels of the lower and upper zone (0 = zone off). Two
+    // active zones share the 14 channels between their masters.
+    void setZones(int lowerMembers, int upperMembers) {
+        mLowerMembers = std::max(0, std::min(15, lowerMembers));
+        mUpperMembers = std::max(0, std::min(15 - mLowerMembers, upperMembers));
+        if (mLowerMembers > 0 && mUpperMembers > 0) {
+            mUpperMembers = std::min(mUpperMembers, 14 - mLowerMembers);
+        }
+        updateChannelZones();
+    }
+
+    int getLowerZoneMembers() const { return mLowerMembers; }
+    int getUpperZoneMembers() const { return mUpperMembers; }
+
+    // Zone a member channel belongs to (0 = lower, 1 = upper), -1 for master
+    // and non-MPE channels
+    int getMemberZone(int channel) const {
+        return validChannel(channel) ? mChannelZone[channel] : -1;
+    }
+
+    bool isMemberChannel(int channel) const {
+        return getMemberZone(channel) >= 0;
+    }
+
+    // Bend range of master and non-MPE channels (the plugin's bend range)
+    void setMasterBendRange(double semitones) { mMasterBendRange = semitones; }
+    double getMasterBendRange() const { return mMasterBendRange; }
+
+    // Bend range of a zone's member channels (RPN 0 on a member channel)
+    void setMemberBendRange(int zone, double semitones) {
+        mMemberBendRange[zone & 1] = semitones;
+    }
+    double getMemberBendRange(int zone) const { return mMemberBendRange[zone & 1]; }
+
+    // Range of MIDI 2.0 per-note pitch bend (RPN 7)
+    void setNoteBendRange(double semitones) { mNoteBendRange = semitones; }
+    double getNoteBendRange() const { return mNoteBendRange; }
+
+    // Note a channel is sounding (or last sounded), or -1
+    int getChannelNote(int channel) const {
+        return validChannel(channel) ? mChannelNote[channel] : -1;
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // Channel messages
+    // ═══════════════════════════════════════════════════════════════
+
+    // Returns the pool's voice index for the note, or -1
+    int noteOn(PoolType& pool, int channel, int32_t note, double velocity) {
+        const int voice = pool.noteOn(note, velocity, noteChannel(channel));
+        if (!validChannel(channel) || !validNote(note)) {
+            return voice;
+        }
+
+        const int zone = mChannelZone[channel];
+        if (zone >= 0) {
+            mChannelNote[channel] = static_cast<int16_t>(note);
+            pool.setNotePitchBend(note, channel, mChannelBend[channel] * mMemberBendRange[zone]);
+            pool.setPolyAftertouch(note, channel, mChannelPressure[channel]);
+            pool.setNoteTimbre(note, channel, mChannelTimbre[channel]);
+        }
+        return voice;
+    }
+
+    // Releases only the note started on this channel
+    void noteOff(PoolType& pool, int channel, int32_t note) {
+        pool.noteOff(note, noteChannel(channel));
+    }
+
+    // Bend -1 to +1
+    void pitchBend(PoolType& pool, int channel, double bend) {
+        const int zone = getMemberZone(channel);
+        if (zone < 0) {
+            pool.setPitchBend(bend * mMasterBendRange);
+            return;
+        }
+        mChannelBend[channel] = bend;
+        if (mChannelNote[channel] >= 0) {
+            pool.setNotePitchBend(mChannelNote[channel], channel, bend * mMemberBendRange[zone]);
+        }
+    }
+
+    // Pressure 0 to 1; member channels only
+    void channelPressure(PoolType& pool, int channel, double pressure) {
+        if (!isMemberChannel(channel)) {
+            return;
+        }
+        mChannelPressure[channel] = pressure;
+        if (mChannelNote[channel] >= 0) {
+            pool.setPolyAftertouch(mChannelNote[channel], channel, pressure);
+        }
+    }
+
+    // Timbre 0 to 1 (0.5 neutral, as 7-bit 64 or 32-bit 0x80000000 scale
+    // to); member channels only
+    void timbre(PoolType& pool, int channel, double value) {
+        if (!isMemberChannel(channel)) {
+            return;
+        }
+        mChannelTimbre[channel] = 2.0 * value - 1.0;
+        if (mChannelNote[channel] >= 0) {
+            pool.setNoteTimbre(mChannelNote[channel], channel, mChannelTimbre[channel]);
+        }
+    }
+
+    // MIDI 1.0 control change (7-bit value): CC74 timbre and the RPN
+    // select / data entry sequence
+    void controlChange(PoolType& pool, int channel, int controller, int value) {
+        if (!validChannel(channel)) {
+            return;
+        }
+        switch (controller) {
+            case kTimbreController:
+                timbre(pool, channel, value / 128.0);   // 64 is exactly neutral
+                break;
+            case 101:   // RPN select MSB
+                mRPNMsb[channel] = static_cast<uint8_t>(value);
+                break;
+            case 100:   // RPN select LSB
+                mRPNLsb[channel] = static_cast<uint8_t>(value);
+                break;
+            case 99:    // NRPN select: data entry no longer addresses an RPN
+            case 98:
+                mRPNMsb[channel] = kNullRPN;
+                mRPNLsb[channel] = kNullRPN;
+                break;
+            case 6:     // Data entry MSB
+                if (mRPNMsb[channel] != kNullRPN || mRPNLsb[channel] != kNullRPN) {
+                    registeredParameter(pool, channel, (mRPNMsb[channel] << 7) | mRPNLsb[channel], value);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Registered parameter (bank << 7 | index) set to value (data MSB)
+    void registeredParameter(PoolType& pool, int channel, int parameter, int value) {
+        switch (parameter) {
+            case kBendSensitivityRPN:
+                // Master channels follow the plugin's bend range instead
+                if (isMemberChannel(channel)) {
+                    mMemberBendRange[mChannelZone[channel]] = value;
+                }
+                break;
+            case kMPEConfigurationRPN:
+                if (channel == kLowerMaster) {
+                    configureZone(0, value);
+                } else if (channel == kUpperMaster) {
+                    configureZone(1, value);
+                }
+                break;
+            case kNoteBendSensitivityRPN:
+                mNoteBendRange = value;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // MIDI 2.0 per-note messages
+    // ═══════════════════════════════════════════════════════════════
+
+    // Bend -1 to +1 over the per-note bend range
+    void notePitchBend(PoolType& pool, int channel, int32_t note, double bend) {
+        pool.setNotePitchBend(note, noteChannel(channel), bend * mNoteBendRange);
+    }
+
+    // Pressure 0 to 1 (MIDI 1.0 poly pressure too)
+    void notePressure(PoolType& pool, int channel, int32_t note, double pressure) {
+        pool.setPolyAftertouch(note, noteChannel(channel), pressure);
+    }
+
+    // Timbre 0 to 1 (0.5 neutral)
+    void noteTimbre(PoolType& pool, int channel, int32_t note, double value) {
+        pool.setNoteTimbre(note, noteChannel(channel), 2.0 * value - 1.0);
+    }
+
+private:
+    static constexpr uint8_t kNullRPN = 127;
+
+    static bool validChannel(int channel) {
+        return channel >= 0 && channel < kNumChannels;
+    }
+
+    static bool validNote(int32_t note) {
+        return note >= 0 && note < kNumNotes;
+    }
+
+    // Channel half of a note's (channel, note) key in the pool
+    static int noteChannel(int channel) {
+        return validChannel(channel) ? channel : VoiceAllocator::kAnyChannel;
+    }
+
+    // MPE Configuration Message: the zone gets members channels (0 turns
+    // it off), the other zone shrinks to fit, and bend ranges reset
+    void configureZone(int zone, int members) {
+        members = std::max(0, std::min(15, members));
+        if (zone == 0) {
+            mLowerMembers = members;
+            if (mUpperMembers > 0) {
+                mUpperMembers = std::max(0, std::min(mUpperMembers, 14 - members));
+            }
+        } else {
+            mUpperMembers = members;
+            if (mLowerMembers > 0) {
+                mLowerMembers = std::max(0, std::min(mLowerMembers, 14 - members));
+            }
+        }
+        mMemberBendRange.fill(kDefaultMemberBendRange);
+        updateChannelZones();
+    }
+
+    void updateChannelZones() {
+        mChannelZone.fill(-1);
+        for (int c = 1; c <= mLowerMembers; ++c) {
+            mChannelZone[c] = 0;
+        }
+        for (int c = kUpperMaster - mUpperMembers; c < kUpperMaster; ++c) {
+            mChannelZone[c] = 1;
+        }
+    }
+
+    int mLowerMembers = 0;
+    int mUpperMembers = 0;
+    std::array<int8_t, kNumChannels> mChannelZone{};
+
+    double mMasterBendRange = kDefaultMasterBendRange;
+    std::array<double, 2> mMemberBendRange{kDefaultMemberBendRange, kDefaultMemberBendRange};
+    double mNoteBendRange = kDefaultMemberBendRange;
+
+    // Channel -> note table and each channel's current expression
+    std::array<int16_t, kNumChannels> mChannelNote{};
+    std::array<double, kNumChannels> mChannelBend{};
+    std::array<double, kNumChannels> mChannelPressure{};
+    std::array<double, kNumChannels> mChannelTimbre{};     // -1 to +1
+    std::array<uint8_t, kNumChannels> mRPNMsb{};           // Selected RPN (127/127: none)
+    std::array<uint8_t, kNumChannels> mRPNLsb{};
+};
+
+using ExpressionRouter = ExpressionRouterT<VoicePool>;
+using VoxExpressionRouter = ExpressionRouterT<VoxEngine>;
+
+#endif // __cplusplus
@@ -5,19 +5,41 @@
 //  Voice Allocator for Polyphonic Synthesis
 //  Tracks which voices are active/free and manages allocation strategies
 //
+//  Lookups are constant time: a 128-entry table holds, per MIDI note, the
+//  head of the list of voices allocated to it (a unison group, ascending
+//  voice index), and the active voices are kept in a compact list in
+//  ascending index order, so render loops and MIDI handling never scan idle
+//  slots.
+//
+//  Each voice also records the MIDI channel that started it, so the same
+//  note number on two channels (MPE member channels) is two separate
+//  groups. Lookups by note alone (kAnyChannel) match every channel.
+//
+//  The voice count is set at construction (up to kMaxVoices); all per-voice
+//  state is allocated once there, never on the render thread.
+//
 
 #pragma once
 
 #ifdef __cplusplus
 
 #include <array>
+#include <vector>
 #include <cstdint>
 #include <algorithm>
 
 class VoiceAllocator {
 public:
     // Maximum number of voices supported
-    static constexpr int kMaxVoices = 16;
+    static constexpr int kMaxVoices = 256;
+    
+    // MIDI notes covered by the note table; notes outside 0-127 share one
+    // extra list
+    static constexpr int kNumNotes = 128;
+    
+    // Channel of voices allocated without one; as a lookup key it matches
+    // voices of every channel
+    static constexpr int kAnyChannel = -1;
     
     // Allocation modes
     enum class Mode {
@@ -29,7 +51,10 @@ public:
     
     // Constructor
     explicit VoiceAllocator(int voiceCount = 8)
-        : mVoiceCount(std::min(voiceCount, kMaxVoices))
+        : mVoices(std::max(1, std::min(voiceCount, kMaxVoices)))
+        , mNextInNote(mVoices.size(), -1)
+        , mActiveVoices(mVoices.size(), -1)
+        , mVoiceCount(static_cast<int>(mVoices.size()))
         , mMode(Mode::RoundRobin)
         , mNextRoundRobin(0)
         , mAllocationCounter(0)
@@ -52,13 +77,13 @@ public:
     }
     
     int getActiveVoiceCount() const {
-        int count = 0;
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mVoices[i].active) {
-                count++;
-            }
-        }
-        return count;
+        return mActiveCount;
+    }
+    
+    // Active voice at a position of the active list (0 to
+    // getActiveVoiceCount() - 1), in ascending voice index order
+    int getActiveVoice(int position) const {
+        return mActiveVoices[position];
     }
     
     int getFreeVoiceCount() const {
@@ -68,6 +93,11 @@ public:
     // Allocate a voice for a note
     // Returns voice index (0 to voiceCount-1) or -1 if no voice available
     int allocate(int32_t note) {
+        return allocate(note, kAnyChannel);
+    }
+    
+    // Allocate a voice for a note started on a channel
+    int allocate(int32_t note, int channel) {
         int voiceIndex = -1;
         
         switch (mMode) {
@@ -86,8 +116,10 @@ public:
         }
         
         if (voiceIndex >= 0) {
+            addActive(voiceIndex, note);
             mVoices[voiceIndex].active = true;
             mVoices[voiceIndex].note = note;
+            mVoices[voiceIndex].channel = channel;
             mVoices[voiceIndex].age = mAllocationCounter++;
             mLastAllocatedVoice = voiceIndex;
         }
@@ -98,21 +130,48 @@ public:
     // Deallocate a voice
     void deallocate(int voiceIndex) {
         if (voiceIndex >= 0 && voiceIndex < mVoiceCount) {
+            if (mVoices[voiceIndex].active) {
+                removeActive(voiceIndex, mVoices[voiceIndex].note);
+            }
             mVoices[voiceIndex].active = false;
             mVoices[voiceIndex].releaseAge = mAllocationCounter++;
             mLastReleasedVoice = voiceIndex;
         }
     }
     
-    // Find voice playing a specific note
+    // Find voice playing a specific note (the lowest index of its group)
     // Returns voice index or -1 if not found
     int findVoicePlayingNote(int32_t note) const {
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mVoices[i].active && mVoices[i].note == note) {
-                return i;
-            }
+        return findVoicePlayingNote(note, kAnyChannel);
+    }
+    
+    // The same for the note started on a channel
+    int findVoicePlayingNote(int32_t note, int channel) const {
+        return matchNote(mNoteHead[noteList(note)], note, channel);
+    }
+    
+    // Next voice of the same note's group after voiceIndex, or -1
+    int findNextVoicePlayingNote(int32_t note, int voiceIndex) const {
+        return findNextVoicePlayingNote(note, kAnyChannel, voiceIndex);
+    }
+    
+    int findNextVoicePlayingNote(int32_t note, int channel, int voiceIndex) const {
+        return matchNote(mNextInNote[voiceIndex], note, channel);
+    }
+    
+    // Call fn(voiceIndex) for every voice allocated to a note, in ascending
+    // voice order
+    template <typename Fn>
+    void forEachVoicePlayingNote(int32_t note, Fn&& fn) const {
+        forEachVoicePlayingNote(note, kAnyChannel, fn);
+    }
+    
+    // The same for the note started on a channel
+    template <typename Fn>
+    void forEachVoicePlayingNote(int32_t note, int channel, Fn&& fn) const {
+        for (int i = findVoicePlayingNote(note, channel); i >= 0; i = findNextVoicePlayingNote(note, channel, i)) {
+            fn(i);
         }
-        return -1;
     }
     
     // Check if a voice is active
@@ -131,6 +190,15 @@ public:
         return -1;
     }
     
+    // Get channel for a voice (kAnyChannel if inactive or allocated without
+    // one)
+    int getChannelForVoice(int voiceIndex) const {
+        if (voiceIndex >= 0 && voiceIndex < mVoiceCount && mVoices[voiceIndex].active) {
+            return mVoices[voiceIndex].channel;
+        }
+        return kAnyChannel;
+    }
+    
     // Get allocation age for a voice (higher = newer)
     uint64_t getAgeForVoice(int voiceIndex) const {
         if (voiceIndex >= 0 && voiceIndex < mVoiceCount) {
@@ -144,8 +212,9 @@ public:
         int oldest = -1;
         uint64_t oldestAge = UINT64_MAX;
         
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mVoices[i].active && mVoices[i].age < oldestAge) {
+        for (int n = 0; n < mActiveCount; ++n) {
+            int i = mActiveVoices[n];
+            if (mVoices[i].age < oldestAge) {
                 oldestAge = mVoices[i].age;
                 oldest = i;
             }
@@ -158,8 +227,9 @@ public:
         int newest = -1;
         uint64_t newestAge = 0;
         
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mVoices[i].active && mVoices[i].age >= newestAge) {
+        for (int n = 0; n < mActiveCount; ++n) {
+            int i = mActiveVoices[n];
+            if (mVoices[i].age >= newestAge) {
                 newestAge = mVoices[i].age;
                 newest = i;
             }
@@ -169,12 +239,17 @@ public:
     
     // Reset all allocations
     void reset() {
-        for (int i = 0; i < kMaxVoices; ++i) {
+        for (int i = 0; i < mVoiceCount; ++i) {
             mVoices[i].active = false;
             mVoices[i].note = -1;
+            mVoices[i].channel = kAnyChannel;
             mVoices[i].age = 0;
             mVoices[i].releaseAge = 0;
         }
+        mNoteHead.fill(-1);
+        std::fill(mNextInNote.begin(), mNextInNote.end(), -1);
+        std::fill(mActiveVoices.begin(), mActiveVoices.end(), -1);
+        mActiveCount = 0;
         mNextRoundRobin = 0;
         mAllocationCounter = 0;
         mLastAllocatedVoice = -1;
@@ -186,10 +261,73 @@ private:
     struct VoiceState {
         bool active = false;
         int32_t note = -1;
+        int channel = kAnyChannel;
         uint64_t age = 0;         // When allocated (higher = newer)
         uint64_t releaseAge = 0;  // When released (for LastPlayed mode)
     };
     
+    // Note table list for a note
+    static int noteList(int32_t note) {
+        return (note >= 0 && note < kNumNotes) ? note : kNumNotes;
+    }
+    
+    // First voice from voiceIndex on along its note list that plays note on
+    // channel (only the shared out-of-range list holds other notes)
+    int matchNote(int voiceIndex, int32_t note, int channel) const {
+        while (voiceIndex >= 0 && (mVoices[voiceIndex].note != note ||
+                                   (channel != kAnyChannel && mVoices[voiceIndex].channel != channel))) {
+            voiceIndex = mNextInNote[voiceIndex];
+        }
+        return voiceIndex;
+    }
+    
+    // Insert into the active list (keeping index order) and the note table
+    void addActive(int voiceIndex, int32_t note) {
+        if (!mVoices[voiceIndex].active) {
+            int n = mActiveCount++;
+            for (; n > 0 && mActiveVoices[n - 1] > voiceIndex; --n) {
+                mActiveVoices[n] = mActiveVoices[n - 1];
+            }
+            mActiveVoices[n] = voiceIndex;
+        } else {
+            removeNote(voiceIndex, mVoices[voiceIndex].note);
+        }
+        insertNote(voiceIndex, note);
+    }
+    
+    void removeActive(int voiceIndex, int32_t note) {
+        int n = 0;
+        while (mActiveVoices[n] != voiceIndex) {
+            ++n;
+        }
+        for (--mActiveCount; n < mActiveCount; ++n) {
+            mActiveVoices[n] = mActiveVoices[n + 1];
+        }
+        mActiveVoices[mActiveCount] = -1;
+        removeNote(voiceIndex, note);
+    }
+    
+    // Note lists stay sorted by voice index (unison groups are short)
+    void insertNote(int voiceIndex, int32_t note) {
+        int* link = &mNoteHead[noteList(note)];
+        while (*link >= 0 && *link < voiceIndex) {
+            link = &mNextInNote[*link];
+        }
+        mNextInNote[voiceIndex] = *link;
+        *link = voiceIndex;
+    }
+    
+    void removeNote(int voiceIndex, int32_t note) {
+        int* link = &mNoteHead[noteList(note)];
+        while (*link >= 0 && *link != voiceIndex) {
+            link = &mNextInNote[*link];
+        }
+        if (*link == voiceIndex) {
+            *link = mNextInNote[voiceIndex];
+            mNextInNote[voiceIndex] = -1;
+        }
+    }
+    
     // Allocate using round-robin strategy
     int allocateRoundRobin() {
         // Start from next round-robin position
@@ -245,7 +383,11 @@ private:
         return allocateLowest();
     }
     
-    std::array<VoiceState, kMaxVoices> mVoices;
+    std::vector<VoiceState> mVoices;
+    std::array<int, kNumNotes + 1> mNoteHead{};    // First voice per note list
+    std::vector<int> mNextInNote;                  // Next voice in the same list
+    std::vector<int> mActiveVoices;                // Ascending voice indices
+    int mActiveCount = 0;
     int mVoiceCount;
     Mode mMode;
     int mNextRoundRobin;
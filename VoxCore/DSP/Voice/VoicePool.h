@@ -7,6 +7,59 @@
 //
 //  Phase 3: Voice Constellation - choir-like voice spreading
 //
+//  Templated on sample type like VoxVoiceT. VoicePool renders in double
+//  (reference), VoicePoolFloat in single precision. VoxEngine selects the
+//  render engine at build time via VOX_FLOAT_ENGINE.
+//
+//  Shared LFO: when the per-voice LFO is free running (no retrigger) and
+//  deterministic (sine/triangle/saw/square), one pool-level LFO owns the phase
+//  accumulator. Voices reading it at the same offset take its rendered values
+//  directly; voices with a phase-spread offset render their span's values in
+//  one block, read at the shared phase plus their offset, so all voices stay
+//  phase-coherent even after sitting idle and none runs its LFO per sample.
+//
+//  Voice storage: the voice count is fixed at construction (1 to kMaxVoices)
+//  and the voices live contiguously in one preallocated vector, built once
+//  in the constructor - no per-voice heap objects, nothing allocated while
+//  rendering. Render cost follows the active voices, not the pool size.
+//
+//  Block render: each voice renders its envelopes a segment at a time
+//  (ADSREnvelopeT::processBlock). The SoA EnvelopeBankT backend, which
+//  advances a group's envelopes together, is opt-in
+//  (setEnvelopeBankEnabled): it measured slower than the segment renderer on
+//  2-wide SIMD and no faster end to end. The two paths render identically,
+//  and at audio rate both match process() exactly.
+//
+//  Per-voice drift and chaos: one DriftBankT and one ChaosBankT lane per
+//  voice (banks of kVoicesPerBank lanes), ticked together every
+//  kVoiceModulationTick samples. Each active
+//  voice ramps its pitch and formant offsets to its lanes' new values over
+//  the tick. Render spans never cross a tick, so at audio rate process()
+//  and processBlock() stay sample-identical. Nothing runs while all four
+//  voiceDrift/voiceChaos depths are 0.
+//
+//  Render groups: each render span the active voices are split into fixed
+//  groups of kVoicesPerTask, in active list order. Each group renders into
+//  its own bus with its own envelope bank, and the buses are summed in group
+//  order; process() sums its voices in the same groups. With no render
+//  threads the caller renders the groups in turn; parallel render (opt-in,
+//  setRenderThreadCount) hands them to the calling thread and its workers
+//  through RenderWorkers. The grouping never depends on the thread count, so
+//  neither does the output.
+//
+//  Voice stealing: a stolen voice is not cut off. Its state is copied into a
+//  preallocated ghost slot that keeps rendering it under a linear fade of
+//  kStealFadeSeconds while the voice itself starts the new note; ghosts are
+//  added after the voices, on the calling thread. Faintest stealing ranks
+//  voices by their current output level (notes in their attack count at
+//  their peak), taking released voices first.
+//
+//  Global modulation (opt-in, setGlobalModulationEnabled): the pool owns a
+//  GlobalModulation and renders it once per render span into its block
+//  buffers; every active voice adds the same buffers to its pitch, formant,
+//  vowel morph and duty cycle, and the stereo render adds the pan buffer
+//  to each voice's pan.
+//
 
 #pragma once
 
@@ -14,21 +67,58 @@
 
 #include "VoiceAllocator.h"
 #include "VoxVoice.h"
+#include "EnvelopeBank.h"
+#include "DriftBank.h"
+#include "ChaosBank.h"
+#include "RenderWorkers.h"
 #include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
 #include <random>
 
-class VoicePool {
+template <typename SampleType>
+class VoicePoolT {
 public:
+    using VoiceType = VoxVoiceT<SampleType>;
+    using LFOType = typename VoiceType::LFOType;
+    using Sample = SampleType;
+    
     // Maximum voices supported
     static constexpr int kMaxVoices = VoiceAllocator::kMaxVoices;
     
+    // Voices per drift and chaos bank; larger pools tick their voices in
+    // groups of this many
+    static constexpr int kVoicesPerBank = 16;
+    
+    // Render groups: voices per task (one bus and envelope bank each), with
+    // an amp + mod envelope lane per voice
+    static constexpr int kVoicesPerTask = 4;
+    using TaskEnvelopeBankType = EnvelopeBankT<SampleType, 2 * kVoicesPerTask>;
+    static_assert(TaskEnvelopeBankType::kBlockSize <= VoiceType::kRenderChunk,
+                  "voices render one envelope bank block per chunk");
+    
     // Voice stealing modes
     enum class StealingMode {
-        Oldest,    // Steal the oldest active voice
-        Quietest   // Steal the voice with lowest velocity
+        Oldest,        // Steal the oldest active voice
+        Quietest,      // Steal the voice with lowest velocity
+        SoonestSilent, // Steal the voice predicted to fall silent first
+        Faintest       // Steal the voice with the lowest output level, released voices first
     };
     
+    // Stolen voices fade out over this long in a ghost slot; one slot per
+    // voice a single note can steal (the unison maximum)
+    static constexpr double kStealFadeSeconds = 0.005;
+    static constexpr int kGhostVoices = 8;
+    
+    // Output level below which a voice counts as silent for prediction
+    static constexpr double kSilenceThreshold = 0.0001;
+    
+    // Per-voice drift and chaos: one lane per voice, ticked every N samples
+    using DriftBankType = DriftBankT<kVoicesPerBank>;
+    using ChaosBankType = ChaosBankT<kVoicesPerBank>;
+    static constexpr int kVoiceModulationTick = 32;
+    
     // Phase 3.6: Constellation modes
     enum class ConstellationMode {
         Unison,    // All spreads = 0 (tight, fat sound)
@@ -38,10 +128,15 @@ public:
     };
     
     // Constructor
-    VoicePool(int voiceCount = 8, double sampleRate = 44100.0)
-        : mVoiceCount(std::min(voiceCount, kMaxVoices))
+    VoicePoolT(int voiceCount = 8, double sampleRate = 44100.0)
+        : mVoiceCount(std::max(1, std::min(voiceCount, kMaxVoices)))
         , mSampleRate(sampleRate)
-        , mAllocator(voiceCount)
+        , mVoiceVelocities(mVoiceCount, 0.0)
+        , mAllocator(mVoiceCount)
+        , mAmpLane(mVoiceCount, -1)
+        , mModLane(mVoiceCount, -1)
+        , mSharedLFO(sampleRate)
+        , mGlobalModulation(sampleRate)
         , mStealingEnabled(true)
         , mStealingMode(StealingMode::Oldest)
         , mConstellationMode(ConstellationMode::Unison)
@@ -54,33 +149,97 @@ public:
         , mRandomGenerator(std::random_device{}())
         , mRandomDist(-1.0, 1.0)
     {
+        // Bank b holds voices 16b..16b+15; seeding it with b gives every
+        // voice its own lane stream regardless of the pool size
+        const int bankCount = (mVoiceCount + kVoicesPerBank - 1) / kVoicesPerBank;
+        mDriftBanks.reserve(bankCount);
+        mChaosBanks.reserve(bankCount);
+        for (int b = 0; b < bankCount; ++b) {
+            mDriftBanks.emplace_back(sampleRate);
+            mDriftBanks[b].seed(b);
+            mChaosBanks.emplace_back(sampleRate);
+            mChaosBanks[b].seed(b);
+        }
+        mFinishedVoices.reserve(mVoiceCount);
+        mVoiceFinished.assign(mVoiceCount, 0);
+        mTaskBanks.resize(1);
+        mTaskBuses.assign(taskCountFor(mVoiceCount) * 2 * kTaskBusSize, SampleType(0));
+        
+        configureSharedLFO();
+        configureVoiceModulation();
         // Initialize all voices with their index for LFO phase spreading
-        for (int i = 0; i < kMaxVoices; ++i) {
-            mVoices[i] = std::make_unique<VoxVoice>(sampleRate);
-            mVoices[i]->setVoiceIndex(i);  // Set voice index for phase spreading
-            mVoiceVelocities[i] = 0.0;
-            mUnisonGroupNote[i] = -1;  // Track which note this voice is part of (for unison)
+        mVoices.reserve(mVoiceCount);
+        for (int i = 0; i < mVoiceCount; ++i) {
+            mVoices.emplace_back(sampleRate);
+            mVoices[i].setVoiceIndex(i);  // Set voice index for phase spreading
         }
+        mGhostVoices.reserve(kGhostVoices);
+        for (int g = 0; g < kGhostVoices; ++g) {
+            mGhostVoices.emplace_back(sampleRate);
+        }
+        mGhostRemaining.assign(kGhostVoices, 0);
+        mStealFadeSamples = stealFadeSamplesFor(sampleRate);
     }
     
+    // The pool owns its voices; copying one would duplicate every voice
+    VoicePoolT(const VoicePoolT&) = delete;
+    VoicePoolT& operator=(const VoicePoolT&) = delete;
+    VoicePoolT(VoicePoolT&&) = default;
+    VoicePoolT& operator=(VoicePoolT&&) = default;
+    
     // Set sample rate for all voices
     void setSampleRate(double sampleRate) {
         mSampleRate = sampleRate;
         for (int i = 0; i < mVoiceCount; ++i) {
-            mVoices[i]->setSampleRate(sampleRate);
+            mVoices[i].setSampleRate(sampleRate);
         }
+        mSharedLFO.setSampleRate(sampleRate);
+        for (DriftBankType& bank : mDriftBanks) bank.setSampleRate(sampleRate);
+        for (ChaosBankType& bank : mChaosBanks) bank.setSampleRate(sampleRate);
+        mGlobalModulation.setSampleRate(sampleRate);
+        mStealFadeSamples = stealFadeSamplesFor(sampleRate);
     }
     
-    // Set parameters for all voices (applies constellation spreads)
+    // Set parameters for all voices. Only the parameter groups that differ
+    // from the current parameters are rebuilt, in the pool and in each
+    // voice; the voices keep their constellation offsets.
     void setParameters(const VoxVoiceParameters& params) {
+        setParameters(params, VoxParameterGroups::changed(mParameters, params));
+    }
+    
+    // Set parameters, rebuilding the given groups (VoxParameterGroups::kAll
+    // for a full rebuild)
+    void setParameters(const VoxVoiceParameters& params, uint32_t groups) {
         mParameters = params;
-        applyConstellationToAllVoices();
+        if (groups & VoxParameterGroups::kLFO) {
+            configureSharedLFO();
+            mGlobalModulation.setControlRate(mParameters.modControlRate);
+        }
+        if (groups & VoxParameterGroups::kVoiceModulation) {
+            configureVoiceModulation();
+        }
+        for (int i = 0; i < mVoiceCount; ++i) {
+            VoiceType& voice = mVoices[i];
+            VoxVoiceParameters voiceParams = mParameters;
+            voiceParams.lfoPhaseSpread = voice.getLFOPhaseOffset();
+            voice.setParameters(voiceParams, groups);
+            if (groups & VoxParameterGroups::kLFO) {
+                voice.setLFOPhaseOffset(voice.getLFOPhaseOffset());
+            }
+        }
     }
     
     VoxVoiceParameters getParameters() const {
         return mParameters;
     }
     
+    // Phase 5: Stochastic cloud parameters, applied to every voice's oscillator
+    void setStochasticParams(const StochasticParams& params) {
+        for (int i = 0; i < mVoiceCount; ++i) {
+            mVoices[i].setStochasticParams(params);
+        }
+    }
+    
     // ═══════════════════════════════════════════════════════════════
     // Phase 3: Voice Constellation Parameters
     // ═══════════════════════════════════════════════════════════════
@@ -135,6 +294,50 @@ public:
         return mLFOPhaseSpread;
     }
     
+    // Shared LFO for free-running voices (on by default; only takes effect
+    // while lfoRetrigger is off and the waveform is deterministic)
+    void setSharedLFOEnabled(bool enabled) {
+        mSharedLFOEnabled = enabled;
+    }
+    
+    bool isSharedLFOEnabled() const {
+        return mSharedLFOEnabled;
+    }
+    
+    bool isUsingSharedLFO() const {
+        return mSharedLFOEnabled && !mParameters.lfoRetrigger &&
+               mParameters.lfoWaveform >= static_cast<int>(LFOType::Waveform::SINE) &&
+               mParameters.lfoWaveform <= static_cast<int>(LFOType::Waveform::SQUARE);
+    }
+    
+    // Global modulation, rendered once per span and shared by every voice
+    // (off by default)
+    void setGlobalModulationEnabled(bool enabled) {
+        if (enabled != mGlobalModulationEnabled) {
+            mGlobalModulationEnabled = enabled;
+            if (!enabled) {
+                // Restore the unmodulated vowel morph
+                applyConstellationToAllVoices();
+            }
+        }
+    }
+    
+    bool isGlobalModulationEnabled() const {
+        return mGlobalModulationEnabled;
+    }
+    
+    void setGlobalModulationAmounts(const GlobalModulationAmounts& amounts) {
+        mGlobalModulation.setRoutingAmounts(amounts);
+    }
+    
+    GlobalModulation& getGlobalModulation() { return mGlobalModulation; }
+    const GlobalModulation& getGlobalModulation() const { return mGlobalModulation; }
+    
+    // Per-voice drift/chaos runs while any of its depths is non-zero
+    bool isUsingVoiceModulation() const {
+        return usesVoiceDrift() || usesVoiceChaos();
+    }
+    
     // Phase 3.6: Constellation Mode (acts as preset)
     void setConstellationMode(ConstellationMode mode) {
         mConstellationMode = mode;
@@ -163,19 +366,33 @@ public:
     // Get number of currently active voices
     int getActiveVoiceCount() const {
         int count = 0;
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mVoices[i]->isActive()) {
+        for (int n = 0; n < mAllocator.getActiveVoiceCount(); ++n) {
+            if (mVoices[mAllocator.getActiveVoice(n)].isActive()) {
                 count++;
             }
         }
         return count;
     }
     
-    // Check if a specific note is currently active
+    // Voices predicted to still be sounding samplesAhead samples from now
+    // (ignoring new notes) - lets a scheduler budget render cost in advance
+    int getPredictedActiveVoiceCount(int samplesAhead) const {
+        int count = 0;
+        for (int n = 0; n < mAllocator.getActiveVoiceCount(); ++n) {
+            const VoiceType& voice = mVoices[mAllocator.getActiveVoice(n)];
+            if (voice.isActive() && voice.getSamplesUntilSilent(kSilenceThreshold) > samplesAhead) {
+                count++;
+            }
+        }
+        return count;
+    }
+    
+    // Check if a specific note is currently active (note table lookup)
     bool isNoteActive(int32_t note) const {
-        int voiceIndex = mAllocator.findVoicePlayingNote(note);
-        if (voiceIndex >= 0 && voiceIndex < mVoiceCount) {
-            return mVoices[voiceIndex]->isActive();
+        for (int i = mAllocator.findVoicePlayingNote(note); i >= 0; i = mAllocator.findNextVoicePlayingNote(note, i)) {
+            if (mVoices[i].isActive()) {
+                return true;
+            }
         }
         return false;
     }
@@ -189,6 +406,16 @@ public:
         return mAllocator.getAllocationMode();
     }
     
+    // Advance block-render envelopes in the SoA envelope bank instead of per
+    // voice (off by default; identical output)
+    void setEnvelopeBankEnabled(bool enabled) {
+        mEnvelopeBankEnabled = enabled;
+    }
+    
+    bool isEnvelopeBankEnabled() const {
+        return mEnvelopeBankEnabled;
+    }
+    
     // Voice stealing control
     void setStealingEnabled(bool enabled) {
         mStealingEnabled = enabled;
@@ -209,17 +436,21 @@ public:
     // Note on - returns voice index or -1 if no voice available
     // With unison voices > 1, triggers multiple voices for a single note
     int noteOn(int32_t note, double velocity) {
+        return noteOn(note, velocity, VoiceAllocator::kAnyChannel);
+    }
+    
+    // Note on for a channel: the note is keyed by (channel, note), so the
+    // same note number on another channel gets voices of its own
+    int noteOn(int32_t note, double velocity, int channel) {
         // Check if this note is already playing - retrigger it
-        int existingVoice = mAllocator.findVoicePlayingNote(note);
-        if (existingVoice >= 0) {
+        int group = mAllocator.findVoicePlayingNote(note, channel);
+        if (group >= 0) {
             // Retrigger all unison voices for this note
-            for (int i = 0; i < mVoiceCount; ++i) {
-                if (mUnisonGroupNote[i] == note) {
-                    mVoices[i]->noteOn(note, velocity);
-                    mVoiceVelocities[i] = velocity;
-                }
-            }
-            return existingVoice;
+            mAllocator.forEachVoicePlayingNote(note, channel, [&](int i) {
+                mVoices[i].noteOn(note, velocity);
+                mVoiceVelocities[i] = velocity;
+            });
+            return group;
         }
         
         // For unison mode, allocate multiple voices
@@ -227,14 +458,15 @@ public:
         int voicesAllocated = 0;
         
         for (int u = 0; u < mUnisonVoices && voicesAllocated < mVoiceCount; ++u) {
-            int voiceIndex = mAllocator.allocate(note);
+            int voiceIndex = mAllocator.allocate(note, channel);
             
             // If no free voice and stealing is enabled, steal one
             if (voiceIndex < 0 && mStealingEnabled) {
                 voiceIndex = stealVoice();
                 if (voiceIndex >= 0) {
+                    fadeOutStolenVoice(voiceIndex);
                     mAllocator.deallocate(voiceIndex);
-                    voiceIndex = mAllocator.allocate(note);
+                    voiceIndex = mAllocator.allocate(note, channel);
                     if (voiceIndex < 0) {
                         voiceIndex = stealVoice();
                     }
@@ -244,11 +476,11 @@ public:
             if (voiceIndex >= 0) {
                 if (firstVoiceIndex < 0) firstVoiceIndex = voiceIndex;
                 
-                mVoices[voiceIndex]->reset();
+                mVoices[voiceIndex].reset();
                 applyConstellationToVoice(voiceIndex, u, mUnisonVoices);
-                mVoices[voiceIndex]->noteOn(note, velocity);
+                mVoices[voiceIndex].noteOn(note, velocity);
+                startVoiceModulation(voiceIndex);
                 mVoiceVelocities[voiceIndex] = velocity;
-                mUnisonGroupNote[voiceIndex] = note;
                 voicesAllocated++;
             } else {
                 break;  // No more voices available
@@ -260,127 +492,637 @@ public:
     
     // Note off - releases all unison voices playing this note
     void noteOff(int32_t note) {
+        noteOff(note, VoiceAllocator::kAnyChannel);
+    }
+    
+    // Note off for the note started on a channel
+    void noteOff(int32_t note, int channel) {
         // Release all voices in the unison group for this note
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mUnisonGroupNote[i] == note) {
-                mVoices[i]->noteOff(note);
-                // Don't deallocate yet - wait for envelope to reach idle
-            }
-        }
+        mAllocator.forEachVoicePlayingNote(note, channel, [&](int i) {
+            mVoices[i].noteOff(note);
+            // Don't deallocate yet - wait for envelope to reach idle
+        });
     }
     
     // Release all notes
     void allNotesOff() {
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mVoices[i]->isActive()) {
-                mVoices[i]->noteOff();
+        for (int n = 0; n < mAllocator.getActiveVoiceCount(); ++n) {
+            VoiceType& voice = mVoices[mAllocator.getActiveVoice(n)];
+            if (voice.isActive()) {
+                voice.noteOff();
             }
         }
     }
     
+    // ═══════════════════════════════════════════════════════════════
+    // Host transport (tempo-synced LFOs)
+    // ═══════════════════════════════════════════════════════════════
+    
+    void setTempo(double bpm) {
+        for (int i = 0; i < mVoiceCount; ++i) {
+            mVoices[i].setTempo(bpm);
+        }
+        mSharedLFO.setTempo(bpm);
+        mGlobalModulation.setTempo(bpm);
+    }
+    
+    // Lock tempo-synced LFOs to the host beat position of the next rendered
+    // sample. Free-running voices (and the shared LFO) follow the beat grid;
+    // retriggered LFOs keep their note-relative phase.
+    void syncToBeatPosition(double beatPosition) {
+        if (mGlobalModulationEnabled) {
+            mGlobalModulation.syncToBeatPosition(beatPosition);
+        }
+        if (!mParameters.lfoTempoSync || mParameters.lfoRetrigger) {
+            return;
+        }
+        mSharedLFO.syncToBeatPosition(beatPosition);
+        for (int i = 0; i < mVoiceCount; ++i) {
+            mVoices[i].getLFO().syncToBeatPosition(beatPosition);
+        }
+    }
+    
     // Set pitch bend (affects all voices)
     void setPitchBend(double semitones) {
         for (int i = 0; i < mVoiceCount; ++i) {
-            mVoices[i]->setPitchBend(semitones);
+            mVoices[i].setPitchBend(semitones);
         }
     }
     
-    // Set polyphonic aftertouch for a specific note (Phase 2.5)
+    // Set polyphonic aftertouch for a specific note (Phase 2.5); pressure
+    // reaches every voice of the note's unison group
     void setPolyAftertouch(int32_t note, double pressure) {
-        int voiceIndex = mAllocator.findVoicePlayingNote(note);
-        if (voiceIndex >= 0 && voiceIndex < mVoiceCount) {
-            mVoices[voiceIndex]->setAftertouch(pressure);
-        }
+        setPolyAftertouch(note, VoiceAllocator::kAnyChannel, pressure);
+    }
+    
+    void setPolyAftertouch(int32_t note, int channel, double pressure) {
+        mAllocator.forEachVoicePlayingNote(note, channel, [&](int i) {
+            mVoices[i].setAftertouch(pressure);
+        });
+    }
+    
+    // Per-note pitch bend (semitones) and timbre (-1 to +1) for a note's
+    // unison group; the note lookup is the allocator's per-note list. The
+    // channel overloads reach only the note started on that channel.
+    void setNotePitchBend(int32_t note, double semitones) {
+        setNotePitchBend(note, VoiceAllocator::kAnyChannel, semitones);
+    }
+    
+    void setNotePitchBend(int32_t note, int channel, double semitones) {
+        mAllocator.forEachVoicePlayingNote(note, channel, [&](int i) {
+            mVoices[i].setNotePitchBend(semitones);
+        });
+    }
+    
+    void setNoteTimbre(int32_t note, double timbre) {
+        setNoteTimbre(note, VoiceAllocator::kAnyChannel, timbre);
+    }
+    
+    void setNoteTimbre(int32_t note, int channel, double timbre) {
+        mAllocator.forEachVoicePlayingNote(note, channel, [&](int i) {
+            mVoices[i].setTimbre(timbre);
+        });
     }
     
     // Reset all voices immediately
     void reset() {
         for (int i = 0; i < mVoiceCount; ++i) {
-            mVoices[i]->reset();
+            mVoices[i].reset();
         }
         mAllocator.reset();
+        mSharedLFO.reset();
+        for (DriftBankType& bank : mDriftBanks) bank.reset();
+        for (ChaosBankType& bank : mChaosBanks) bank.reset();
+        mVoiceModCountdown = 0;
+        std::fill(mGhostRemaining.begin(), mGhostRemaining.end(), 0);
     }
     
-    // Process one sample - sums all active voices
-    double process() {
-        double output = 0.0;
+    // Process one sample - sums all active voices, group by group as the
+    // block render's buses do
+    SampleType process() {
+        SampleType output = SampleType(0);
+        SampleType group = SampleType(0);
+        beginVoiceModulationSpan(1);
+        beginSharedLFOSpan(1);
+        const GlobalModulationBlock* global = beginGlobalModulationSpan(1);
         
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mVoices[i]->isActive()) {
-                output += mVoices[i]->process();
+        const int activeCount = mAllocator.getActiveVoiceCount();
+        for (int n = 0; n < activeCount; ++n) {
+            if (n > 0 && n % kVoicesPerTask == 0) {
+                output += group;
+                group = SampleType(0);
+            }
+            const int i = mAllocator.getActiveVoice(n);
+            VoiceType& voice = mVoices[i];
+            if (voice.isActive()) {
+                routeSharedLFO(voice);
+                voice.setGlobalModulation(global);
+                group += voice.process();
+                voice.setSharedLFOValues(nullptr);
+                voice.setGlobalModulation(nullptr);
                 
                 // Check if voice has finished (envelope reached idle)
-                // Return voice to pool
-                if (!mVoices[i]->isActive()) {
-                    mAllocator.deallocate(i);
-                    mUnisonGroupNote[i] = -1;
+                if (!voice.isActive()) {
+                    mFinishedVoices.push_back(i);
                 }
             }
         }
         
+        output += group;
+        
+        // Return finished voices to the pool
+        releaseFinishedVoices();
+        
+        // Stolen voices fading out
+        for (int g = 0; g < kGhostVoices; ++g) {
+            if (mGhostRemaining[g] > 0) {
+                VoiceType& ghost = mGhostVoices[g];
+                routeSharedLFO(ghost);
+                ghost.setGlobalModulation(global);
+                const SampleType sample = ghost.process();
+                ghost.setSharedLFOValues(nullptr);
+                ghost.setGlobalModulation(nullptr);
+                output += sample * stealFadeGain(--mGhostRemaining[g]);
+                if (!ghost.isActive()) {
+                    mGhostRemaining[g] = 0;
+                }
+            }
+        }
         return output;
     }
     
-    // Process a block of samples
-    void processBlock(double* output, int numSamples) {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = process();
+    // Process a block of samples in chunks. Per chunk, each active voice
+    // renders its envelopes, source and output stage and is summed in voice
+    // order. At audio rate (modControlRate 1) the result matches numSamples
+    // calls to process(); with control-rate ticks the block render evaluates
+    // the modulation routing once per tick and ramps between ticks, while
+    // process() still routes every sample, so the two differ slightly. With the
+    // envelope bank enabled, the amp and mod envelopes of each group of
+    // kVoicesPerTask voices are instead gathered into a bank and advanced
+    // together, and each voice renders from the bank's lanes; voices with a
+    // delayed trigger pending keep their own per-sample envelope path.
+    void processBlock(SampleType* output, int numSamples) {
+        std::fill_n(output, numSamples, SampleType(0));
+        renderVoices(output, nullptr, numSamples);
+    }
+    
+    // Process stereo: the same chunked render, with each voice panning itself
+    // (constellation pan, per-grain pan scatter, global pan modulation) into
+    // the left/right sums with cached constant-power gains
+    void processBlockStereo(SampleType* left, SampleType* right, int numSamples) {
+        std::fill_n(left, numSamples, SampleType(0));
+        std::fill_n(right, numSamples, SampleType(0));
+        renderVoices(left, right, numSamples);
+    }
+    
+    // Threads rendering voice groups in processBlock/processBlockStereo. 0
+    // (the default) renders every group on the calling thread; 1 or more
+    // render them on count threads (the caller plus count - 1 workers). The
+    // buses are summed in group order either way, so the output is identical
+    // for every count.
+    // Workers are put on the render thread's real-time schedule (see
+    // setRenderPeriod and setRenderThreadSetup) before this returns.
+    // Starts threads and allocates; not for the render thread.
+    void setRenderThreadCount(int count) {
+        mRenderThreadCount = std::max(0, std::min(RenderWorkers::kMaxThreads, count));
+        if (mRenderThreadCount == 0) {
+            mRenderWorkers.reset();
+            mTaskBanks.resize(1);
+            return;
+        }
+        if (!mRenderWorkers) {
+            mRenderWorkers = std::make_unique<RenderWorkers>();
+            mRenderWorkers->setRealtimePeriod(mRenderPeriod);
+            mRenderWorkers->setThreadSetup(mRenderThreadSetup, mRenderThreadSetupContext);
         }
+        mRenderWorkers->setThreadCount(mRenderThreadCount);
+        mTaskBanks.resize(mRenderThreadCount);
     }
     
-    // Process stereo with pan spread applied
-    void processBlockStereo(double* left, double* right, int numSamples) {
-        for (int s = 0; s < numSamples; ++s) {
-            double leftSum = 0.0;
-            double rightSum = 0.0;
-            
-            for (int i = 0; i < mVoiceCount; ++i) {
-                if (mVoices[i]->isActive()) {
-                    double sample = mVoices[i]->process();
-                    
-                    // Apply pan (constant-power panning)
-                    double pan = mVoices[i]->getPan();  // -1 (left) to +1 (right)
-                    double panAngle = (pan + 1.0) * 0.25 * 3.14159265359;  // 0 to π/2
-                    double leftGain = std::cos(panAngle);
-                    double rightGain = std::sin(panAngle);
-                    
-                    leftSum += sample * leftGain;
-                    rightSum += sample * rightGain;
-                    
-                    // Check if voice has finished
-                    if (!mVoices[i]->isActive()) {
-                        mAllocator.deallocate(i);
-                        mUnisonGroupNote[i] = -1;
-                    }
-                }
-            }
-            
-            left[s] = leftSum;
-            right[s] = rightSum;
+    int getRenderThreadCount() const {
+        return mRenderThreadCount;
+    }
+    
+    // Seconds per render call (maximum frames / sample rate) that render
+    // workers are given a real-time policy for; 0 leaves them at default
+    // priority. Restarts running workers; not for the render thread.
+    void setRenderPeriod(double seconds) {
+        mRenderPeriod = std::max(0.0, seconds);
+        if (mRenderWorkers) {
+            mRenderWorkers->setRealtimePeriod(mRenderPeriod);
         }
     }
     
+    // Hook run on each new render worker in place of the real-time policy,
+    // e.g. to join the host's audio workgroup (nullptr restores the policy).
+    // Restarts running workers; not for the render thread.
+    void setRenderThreadSetup(RenderWorkers::ThreadSetup setup, void* context) {
+        mRenderThreadSetup = setup;
+        mRenderThreadSetupContext = context;
+        if (mRenderWorkers) {
+            mRenderWorkers->setThreadSetup(setup, context);
+        }
+    }
+    
+    // Render workers running on the real-time schedule
+    int getRealtimeRenderThreadCount() const {
+        return mRenderWorkers ? mRenderWorkers->getRealtimeWorkerCount() : 0;
+    }
+    
     // Get access to the allocator for advanced queries
     const VoiceAllocator& getAllocator() const {
         return mAllocator;
     }
     
     // Get a voice by index (for voice stealing etc.)
-    VoxVoice* getVoice(int index) {
+    VoiceType* getVoice(int index) {
         if (index >= 0 && index < mVoiceCount) {
-            return mVoices[index].get();
+            return &mVoices[index];
         }
         return nullptr;
     }
     
-    const VoxVoice* getVoice(int index) const {
+    const VoiceType* getVoice(int index) const {
         if (index >= 0 && index < mVoiceCount) {
-            return mVoices[index].get();
+            return &mVoices[index];
         }
         return nullptr;
     }
     
 private:
+    // Deallocate the voices a render loop found idle. Render loops walk the
+    // allocator's active list directly, so they collect finished voices
+    // rather than removing them mid-loop.
+    void releaseFinishedVoices() {
+        for (int i : mFinishedVoices) {
+            mAllocator.deallocate(i);
+        }
+        mFinishedVoices.clear();
+    }
+    
+    // Add every active voice into output (mono, right == nullptr) or into
+    // output/right (stereo), one envelope-bank chunk at a time
+    void renderVoices(SampleType* output, SampleType* right, int numSamples) {
+        for (int done = 0; done < numSamples; ) {
+            int count = beginVoiceModulationSpan(std::min(TaskEnvelopeBankType::kBlockSize, numSamples - done));
+            beginSharedLFOSpan(count);
+            const GlobalModulationBlock* global = beginGlobalModulationSpan(count);
+            
+            SampleType* left = output + done;
+            SampleType* spanRight = right ? right + done : nullptr;
+            const int activeCount = mAllocator.getActiveVoiceCount();
+            renderVoiceTasks(left, spanRight, count, global);
+            
+            for (int n = 0; n < activeCount; ++n) {
+                const int i = mAllocator.getActiveVoice(n);
+                if (mVoiceFinished[i]) {
+                    mVoiceFinished[i] = 0;
+                    mFinishedVoices.push_back(i);
+                }
+            }
+            releaseFinishedVoices();
+            renderGhostVoices(left, spanRight, count, global);
+            done += count;
+        }
+    }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Stolen voice fade-out
+    // ═══════════════════════════════════════════════════════════════
+    
+    static int stealFadeSamplesFor(double sampleRate) {
+        return std::max(1, static_cast<int>(kStealFadeSeconds * sampleRate + 0.5));
+    }
+    
+    // Fade gain with remaining samples left after this one: reaches 0 on the
+    // last sample of the fade
+    SampleType stealFadeGain(int remaining) const {
+        return static_cast<SampleType>(static_cast<double>(remaining) / mStealFadeSamples);
+    }
+    
+    // Move a voice about to be stolen into a ghost slot: a free slot, or the
+    // one closest to the end of its fade
+    void fadeOutStolenVoice(int index) {
+        if (!mVoices[index].isActive()) {
+            return;
+        }
+        int slot = 0;
+        for (int g = 1; g < kGhostVoices; ++g) {
+            if (mGhostRemaining[g] < mGhostRemaining[slot]) {
+                slot = g;
+            }
+        }
+        mGhostVoices[slot] = mVoices[index];
+        mGhostRemaining[slot] = mStealFadeSamples;
+    }
+    
+    // Add the fading ghosts over one span, each rendered into scratch and
+    // scaled by its fade ramp
+    void renderGhostVoices(SampleType* output, SampleType* right, int count,
+                           const GlobalModulationBlock* global) {
+        for (int g = 0; g < kGhostVoices; ++g) {
+            if (mGhostRemaining[g] == 0) {
+                continue;
+            }
+            VoiceType& ghost = mGhostVoices[g];
+            const int samples = std::min(count, mGhostRemaining[g]);
+            std::fill_n(mGhostLeft.data(), samples, SampleType(0));
+            routeSharedLFO(ghost);
+            ghost.setGlobalModulation(global);
+            int rendered;
+            if (right) {
+                std::fill_n(mGhostRight.data(), samples, SampleType(0));
+                rendered = ghost.processBlockStereoAddWhileActive(mGhostLeft.data(), mGhostRight.data(), samples);
+            } else {
+                rendered = ghost.processBlockAddWhileActive(mGhostLeft.data(), samples);
+            }
+            ghost.setSharedLFOValues(nullptr);
+            ghost.setGlobalModulation(nullptr);
+            
+            int remaining = mGhostRemaining[g];
+            for (int i = 0; i < rendered; ++i) {
+                const SampleType gain = stealFadeGain(--remaining);
+                output[i] += mGhostLeft[i] * gain;
+                if (right) {
+                    right[i] += mGhostRight[i] * gain;
+                }
+            }
+            mGhostRemaining[g] = (rendered < samples) ? 0 : remaining;
+        }
+    }
+    
+    // Render active-list positions [first, last) (one group of voices) over
+    // one span; with the envelope bank enabled their envelopes
+    // are advanced together in the bank. Voices that finish are flagged in
+    // mVoiceFinished.
+    template <typename Bank>
+    void renderVoiceGroup(Bank& bank, int first, int last, SampleType* output, SampleType* right, int count,
+                          const GlobalModulationBlock* global) {
+        if (mEnvelopeBankEnabled) {
+            bank.clear();
+            for (int n = first; n < last; ++n) {
+                const int i = mAllocator.getActiveVoice(n);
+                mAmpLane[i] = -1;
+                if (mVoices[i].isActive() && !mVoices[i].hasPendingTrigger()) {
+                    mAmpLane[i] = bank.addLane(mVoices[i].getAmpEnvelope());
+                    mModLane[i] = bank.addLane(mVoices[i].getModEnvelope(), mAmpLane[i]);
+                }
+            }
+            bank.process(count);
+        } else {
+            for (int n = first; n < last; ++n) {
+                mAmpLane[mAllocator.getActiveVoice(n)] = -1;
+            }
+        }
+        
+        for (int n = first; n < last; ++n) {
+            const int i = mAllocator.getActiveVoice(n);
+            VoiceType& voice = mVoices[i];
+            if (voice.isActive()) {
+                routeSharedLFO(voice);
+                voice.setGlobalModulation(global);
+            }
+            if (mAmpLane[i] >= 0) {
+                bank.store(mAmpLane[i], voice.getAmpEnvelope());
+                bank.store(mModLane[i], voice.getModEnvelope());
+                const int active = bank.getActiveSamples(mAmpLane[i]);
+                const SampleType* ampEnv = bank.output(mAmpLane[i]);
+                const SampleType* modEnv = bank.output(mModLane[i]);
+                if (right) {
+                    voice.processBlockStereoAddWithEnvelopes(output, right, active,
+                                                             ampEnv, modEnv, Bank::stride());
+                } else {
+                    voice.processBlockAddWithEnvelopes(output, active,
+                                                       ampEnv, modEnv, Bank::stride());
+                }
+            } else if (voice.isActive()) {
+                if (right) {
+                    voice.processBlockStereoAddWhileActive(output, right, count);
+                } else {
+                    voice.processBlockAddWhileActive(output, count);
+                }
+            } else {
+                continue;
+            }
+            voice.setSharedLFOValues(nullptr);
+            voice.setGlobalModulation(nullptr);
+            
+            if (!voice.isActive()) {
+                mVoiceFinished[i] = 1;
+            }
+        }
+    }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Render groups
+    // ═══════════════════════════════════════════════════════════════
+    
+    static constexpr int kTaskBusSize = TaskEnvelopeBankType::kBlockSize;
+    
+    static int taskCountFor(int voices) {
+        return (voices + kVoicesPerTask - 1) / kVoicesPerTask;
+    }
+    
+    SampleType* taskBus(int task) {
+        return mTaskBuses.data() + task * 2 * kTaskBusSize;
+    }
+    
+    // One span of every group (across the render threads, if any), then the
+    // buses summed in task order
+    void renderVoiceTasks(SampleType* output, SampleType* right, int count,
+                          const GlobalModulationBlock* global) {
+        const int tasks = taskCountFor(mAllocator.getActiveVoiceCount());
+        mTaskStereo = right != nullptr;
+        mTaskSamples = count;
+        mTaskGlobal = global;
+        if (mRenderWorkers) {
+            mRenderWorkers->run(&VoicePoolT::runRenderTask, this, tasks);
+        } else {
+            for (int t = 0; t < tasks; ++t) {
+                renderTask(t, 0);
+            }
+        }
+        
+        for (int t = 0; t < tasks; ++t) {
+            const SampleType* bus = taskBus(t);
+            for (int i = 0; i < count; ++i) {
+                output[i] += bus[i];
+            }
+            if (right) {
+                bus += kTaskBusSize;
+                for (int i = 0; i < count; ++i) {
+                    right[i] += bus[i];
+                }
+            }
+        }
+    }
+    
+    static void runRenderTask(void* context, int task, int thread) {
+        static_cast<VoicePoolT*>(context)->renderTask(task, thread);
+    }
+    
+    // Render one group of voices into its own (cleared) bus
+    void renderTask(int task, int thread) {
+        SampleType* left = taskBus(task);
+        SampleType* right = mTaskStereo ? left + kTaskBusSize : nullptr;
+        std::fill_n(left, mTaskSamples, SampleType(0));
+        if (right) {
+            std::fill_n(right, mTaskSamples, SampleType(0));
+        }
+        const int first = task * kVoicesPerTask;
+        const int last = std::min(mAllocator.getActiveVoiceCount(), first + kVoicesPerTask);
+        renderVoiceGroup(mTaskBanks[thread], first, last, left, right, mTaskSamples, mTaskGlobal);
+    }
+    
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Shared LFO
+    // ═══════════════════════════════════════════════════════════════
+    
+    // The shared LFO runs the voices' LFO settings at offset 0
+    void configureSharedLFO() {
+        mSharedLFO.setRate(mParameters.lfoRate);
+        mSharedLFO.setWaveform(static_cast<typename LFOType::Waveform>(mParameters.lfoWaveform));
+        mSharedLFO.setControlRate(mParameters.modControlRate);
+        mSharedLFO.setSyncMode(mParameters.lfoTempoSync ? LFOType::SyncMode::TEMPO_SYNC : LFOType::SyncMode::FREE);
+        mSharedLFO.setBeatDivision(static_cast<typename LFOType::BeatDivision>(mParameters.lfoBeatDivision));
+    }
+    
+    // Advance the shared accumulator over the next count samples (<= one
+    // render chunk), remembering its phase at the start of the span
+    void beginSharedLFOSpan(int count) {
+        mSharedLFOActive = isUsingSharedLFO();
+        if (mSharedLFOActive) {
+            mSharedLFOBasePhase = mSharedLFO.getBasePhase();
+            mSharedLFOSpan = count;
+            mSharedLFO.processBlock(mSharedLFOBuffer.data(), count);
+        }
+    }
+    
+    // Point a voice at the shared values, render its offset values from the
+    // shared phase, or leave it on its own LFO (retrigger, per-voice rate)
+    void routeSharedLFO(VoiceType& voice) {
+        LFOType& lfo = voice.getLFO();
+        if (!mSharedLFOActive || !lfo.sharesShapeWith(mSharedLFO)) {
+            voice.setSharedLFOValues(nullptr);
+        } else if (lfo.getPhaseOffset() == mSharedLFO.getPhaseOffset()) {
+            voice.setSharedLFOValues(mSharedLFOBuffer.data());
+        } else {
+            voice.renderSharedLFOAtOffset(mSharedLFOBasePhase, mSharedLFOSpan);
+        }
+    }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Global modulation
+    // ═══════════════════════════════════════════════════════════════
+    
+    // Render the next count samples of global modulation; nullptr while
+    // global modulation is off
+    const GlobalModulationBlock* beginGlobalModulationSpan(int count) {
+        if (!mGlobalModulationEnabled) {
+            return nullptr;
+        }
+        mGlobalModulation.processBlock(count);
+        return &mGlobalModulation.getBlock();
+    }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Per-voice drift and chaos
+    // ═══════════════════════════════════════════════════════════════
+    
+    bool usesVoiceDrift() const {
+        return mParameters.voiceDriftToPitch != 0.0 || mParameters.voiceDriftToFormant != 0.0;
+    }
+    
+    bool usesVoiceChaos() const {
+        return mParameters.voiceChaosToPitch != 0.0 || mParameters.voiceChaosToFormant != 0.0;
+    }
+    
+    void configureVoiceModulation() {
+        int driftMode = std::max(0, std::min(static_cast<int>(DriftGenerator::Mode::Entropy), mParameters.voiceDriftMode));
+        int chaosType = std::max(0, std::min(static_cast<int>(ChaosGenerator::ChaosType::Rossler), mParameters.voiceChaosType));
+        for (size_t b = 0; b < mDriftBanks.size(); ++b) {
+            const int lanes = mVoiceCount - static_cast<int>(b) * kVoicesPerBank;
+            mDriftBanks[b].setMode(static_cast<DriftGenerator::Mode>(driftMode));
+            mDriftBanks[b].setRate(mParameters.voiceDriftRate);
+            mDriftBanks[b].setEntropyHalfLife(mParameters.voiceDriftHalfLife);
+            mDriftBanks[b].setLaneCount(lanes);
+            mChaosBanks[b].setType(static_cast<ChaosGenerator::ChaosType>(chaosType));
+            mChaosBanks[b].setRate(mParameters.voiceChaosRate);
+            mChaosBanks[b].setLaneCount(lanes);
+        }
+        
+        // Turning the depths off drops the voices' offsets right away
+        if (!isUsingVoiceModulation() && mVoiceModActive) {
+            for (int i = 0; i < mVoiceCount; ++i) {
+                mVoices[i].clearVoiceModulation();
+            }
+            mVoiceModActive = false;
+            mVoiceModCountdown = 0;
+        }
+    }
+    
+    // A voice's pitch (semitones) and formant (Hz) offsets from its lanes
+    double voicePitchModulation(int index) const {
+        double cents = 0.0;
+        if (usesVoiceDrift()) cents += driftValue(index) * mParameters.voiceDriftToPitch;
+        if (usesVoiceChaos()) cents += chaosValue(index) * mParameters.voiceChaosToPitch;
+        return cents / 100.0;
+    }
+    
+    double voiceFormantModulation(int index) const {
+        double hz = 0.0;
+        if (usesVoiceDrift()) hz += driftValue(index) * mParameters.voiceDriftToFormant;
+        if (usesVoiceChaos()) hz += chaosValue(index) * mParameters.voiceChaosToFormant;
+        return hz;
+    }
+    
+    double driftValue(int index) const {
+        return mDriftBanks[index / kVoicesPerBank].getValue(index % kVoicesPerBank);
+    }
+    
+    double chaosValue(int index) const {
+        return mChaosBanks[index / kVoicesPerBank].getValue(index % kVoicesPerBank);
+    }
+    
+    // Tick the banks when a tick is due and clip the next render span to the
+    // samples left before the following tick
+    int beginVoiceModulationSpan(int count) {
+        if (!isUsingVoiceModulation()) {
+            return count;
+        }
+        if (mVoiceModCountdown == 0) {
+            if (usesVoiceDrift()) {
+                for (DriftBankType& bank : mDriftBanks) bank.process(kVoiceModulationTick);
+            }
+            if (usesVoiceChaos()) {
+                for (ChaosBankType& bank : mChaosBanks) bank.process(kVoiceModulationTick);
+            }
+            for (int n = 0; n < mAllocator.getActiveVoiceCount(); ++n) {
+                const int i = mAllocator.getActiveVoice(n);
+                if (mVoices[i].isActive()) {
+                    mVoices[i].setVoiceModulation(voicePitchModulation(i), voiceFormantModulation(i),
+                                                   kVoiceModulationTick);
+                }
+            }
+            mVoiceModActive = true;
+            mVoiceModCountdown = kVoiceModulationTick;
+        }
+        count = std::min(count, mVoiceModCountdown);
+        mVoiceModCountdown -= count;
+        return count;
+    }
+    
+    // Note start: Entropy lanes restart, and the voice jumps to its lanes'
+    // current offsets instead of ramping from the previous note's
+    void startVoiceModulation(int index) {
+        if (!isUsingVoiceModulation()) {
+            return;
+        }
+        mDriftBanks[index / kVoicesPerBank].retrigger(index % kVoicesPerBank);
+        mVoices[index].resetVoiceModulation(voicePitchModulation(index), voiceFormantModulation(index));
+    }
+    
     // Find a voice to steal based on current stealing mode
     int stealVoice() {
         switch (mStealingMode) {
@@ -389,17 +1131,43 @@ private:
                 
             case StealingMode::Quietest:
                 return findQuietestVoice();
+                
+            case StealingMode::SoonestSilent:
+                return findSoonestSilentVoice();
+                
+            case StealingMode::Faintest:
+                return findFaintestVoice();
         }
         return -1;
     }
     
+    // Find the voice predicted to go silent first (released voices near the
+    // end of their tails); falls back to the oldest voice if all are held
+    int findSoonestSilentVoice() {
+        int soonest = -1;
+        int soonestSamples = VoiceType::EnvelopeType::kNeverSilent;
+        
+        for (int n = 0; n < mAllocator.getActiveVoiceCount(); ++n) {
+            const int i = mAllocator.getActiveVoice(n);
+            if (mVoices[i].isActive()) {
+                int samples = mVoices[i].getSamplesUntilSilent(kSilenceThreshold);
+                if (samples < soonestSamples) {
+                    soonestSamples = samples;
+                    soonest = i;
+                }
+            }
+        }
+        return soonest >= 0 ? soonest : mAllocator.getOldestActiveVoice();
+    }
+    
     // Find the voice with the lowest velocity
     int findQuietestVoice() {
         int quietest = -1;
         double quietestVelocity = 2.0;  // Higher than max possible
         
-        for (int i = 0; i < mVoiceCount; ++i) {
-            if (mVoices[i]->isActive() && mVoiceVelocities[i] < quietestVelocity) {
+        for (int n = 0; n < mAllocator.getActiveVoiceCount(); ++n) {
+            const int i = mAllocator.getActiveVoice(n);
+            if (mVoices[i].isActive() && mVoiceVelocities[i] < quietestVelocity) {
                 quietestVelocity = mVoiceVelocities[i];
                 quietest = i;
             }
@@ -407,6 +1175,31 @@ private:
         return quietest;
     }
     
+    // Find the voice with the lowest current output level, preferring
+    // released voices so held notes are only taken when nothing is fading
+    int findFaintestVoice() {
+        int faintest = -1;
+        bool faintestReleasing = false;
+        double faintestLevel = 0.0;
+        
+        for (int n = 0; n < mAllocator.getActiveVoiceCount(); ++n) {
+            const int i = mAllocator.getActiveVoice(n);
+            const VoiceType& voice = mVoices[i];
+            if (!voice.isActive()) {
+                continue;
+            }
+            const bool releasing = voice.isReleasing();
+            const double level = voice.getStealingLevel();
+            if (faintest < 0 || (releasing && !faintestReleasing) ||
+                (releasing == faintestReleasing && level < faintestLevel)) {
+                faintest = i;
+                faintestReleasing = releasing;
+                faintestLevel = level;
+            }
+        }
+        return faintest >= 0 ? faintest : mAllocator.getOldestActiveVoice();
+    }
+    
     // Get current spread values (mode presets modify these when set)
     void getEffectiveSpreads(double& detune, double& timeOffset, double& formantOffset, 
                             double& pan, double& lfoPhase) const {
@@ -503,26 +1296,71 @@ private:
         VoxVoiceParameters voiceParams = mParameters;
         voiceParams.lfoPhaseSpread = lfoPhaseOffset;
         
-        mVoices[voiceIndex]->setParameters(voiceParams);
-        mVoices[voiceIndex]->setDetuneOffset(detuneOffset);
-        mVoices[voiceIndex]->setTimeOffset(timeOffsetValue);
-        mVoices[voiceIndex]->setFormantOffset(formantOffsetValue);
-        mVoices[voiceIndex]->setPan(panValue);
-        mVoices[voiceIndex]->setLFOPhaseOffset(lfoPhaseOffset);
+        mVoices[voiceIndex].setParameters(voiceParams);
+        mVoices[voiceIndex].setDetuneOffset(detuneOffset);
+        mVoices[voiceIndex].setTimeOffset(timeOffsetValue);
+        mVoices[voiceIndex].setFormantOffset(formantOffsetValue);
+        mVoices[voiceIndex].setPan(panValue);
+        mVoices[voiceIndex].setLFOPhaseOffset(lfoPhaseOffset);
     }
     
     int mVoiceCount;
     double mSampleRate;
     VoxVoiceParameters mParameters;
     
-    std::array<std::unique_ptr<VoxVoice>, kMaxVoices> mVoices;
-    std::array<double, kMaxVoices> mVoiceVelocities;
-    std::array<int32_t, kMaxVoices> mUnisonGroupNote;  // Track unison groups
+    std::vector<VoiceType> mVoices;             // Contiguous, mVoiceCount voices
+    std::vector<double> mVoiceVelocities;
     VoiceAllocator mAllocator;
     
+    // Block render: batched envelopes (opt-in) and each voice's lanes in the
+    // bank
+    bool mEnvelopeBankEnabled = false;
+    std::vector<int> mAmpLane;
+    std::vector<int> mModLane;
+    std::vector<int> mFinishedVoices;           // Idle after this render span
+    std::vector<uint8_t> mVoiceFinished;        // Per voice, set by render groups
+    
+    // Render groups: worker threads (none by default), an envelope bank per
+    // thread and a stereo bus per task
+    int mRenderThreadCount = 0;
+    std::unique_ptr<RenderWorkers> mRenderWorkers;
+    double mRenderPeriod = RenderWorkers::kDefaultRealtimePeriod;
+    RenderWorkers::ThreadSetup mRenderThreadSetup = nullptr;
+    void* mRenderThreadSetupContext = nullptr;
+    std::vector<TaskEnvelopeBankType> mTaskBanks;
+    std::vector<SampleType> mTaskBuses;
+    bool mTaskStereo = false;
+    int mTaskSamples = 0;
+    const GlobalModulationBlock* mTaskGlobal = nullptr;
+    
+    // Shared LFO for free-running voices
+    LFOType mSharedLFO;
+    std::array<SampleType, VoiceType::kRenderChunk> mSharedLFOBuffer{};
+    double mSharedLFOBasePhase = 0.0;
+    int mSharedLFOSpan = 0;
+    bool mSharedLFOEnabled = true;
+    bool mSharedLFOActive = false;
+    
+    // Per-voice drift and chaos lanes, kVoicesPerBank voices per bank
+    std::vector<DriftBankType> mDriftBanks;
+    std::vector<ChaosBankType> mChaosBanks;
+    int mVoiceModCountdown = 0;
+    bool mVoiceModActive = false;
+    
+    // Global modulation, one render per span for all voices
+    GlobalModulation mGlobalModulation;
+    bool mGlobalModulationEnabled = false;
+    
     bool mStealingEnabled;
     StealingMode mStealingMode;
     
+    // Stolen voices fading out: a voice copy per slot, samples of fade left
+    std::vector<VoiceType> mGhostVoices;
+    std::vector<int> mGhostRemaining;
+    int mStealFadeSamples = 1;
+    std::array<SampleType, VoiceType::kRenderChunk> mGhostLeft{};
+    std::array<SampleType, VoiceType::kRenderChunk> mGhostRight{};
+    
     // Phase 3: Constellation parameters
     ConstellationMode mConstellationMode;
     double mDetuneSpread;      // 0-50 cents
@@ -537,4 +1375,19 @@ private:
     mutable std::uniform_real_distribution<double> mRandomDist;
 };
 
+using VoicePool = VoicePoolT<double>;
+using VoicePoolFloat = VoicePoolT<float>;
+
+// Build-time render engine selection. Define VOX_FLOAT_ENGINE=1 to render the
+// whole voice chain in single precision (the AU output format).
+#ifndef VOX_FLOAT_ENGINE
+#define VOX_FLOAT_ENGINE 0
+#endif
+
+#if VOX_FLOAT_ENGINE
+using VoxEngine = VoicePoolFloat;
+#else
+using VoxEngine = VoicePool;
+#endif
+
 #endif // __cplusplus
@@ -5,6 +5,16 @@
 //  Vox Pulsar Synthesis Voice
 //  Combines PulsarOscillator + FormantFilter + ADSR Envelope + Per-Voice LFO
 //
+//  Templated on sample type. Parameters, pitch, and modulation sums are
+//  computed in double; the audio path (oscillator output, filter, envelopes,
+//  LFO value) runs in SampleType. VoxVoice is the double-precision reference
+//  and VoxVoiceFloat the single-precision render path.
+//
+//  Parameter changes are applied per group (VoxParameterGroups): only the
+//  subsystems whose fields changed rebuild their coefficients, so one
+//  automated parameter costs one subsystem update per voice instead of a
+//  full voice rebuild.
+//
 
 #pragma once
 
@@ -12,9 +22,16 @@
 
 #include "PulsarOscillator.h"
 #include "FormantFilter.h"
+#include "AirFilter.h"
 #include "ADSREnvelope.h"
 #include "LFO.h"
+#include "ControlRate.h"
+#include "PitchTable.h"
+#include "DSPUtilities.h"
+#include "GlobalModulation.h"
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
 
 // Voice parameters structure
@@ -33,8 +50,14 @@ struct VoxVoiceParameters {
     double formant2Q = 10.0;         // Q factor
     double vowelMorph = 0.0;         // 0.0 to 1.0 (A-E-I-O-U)
     double formantMix = 1.0;         // 0.0 = dry, 1.0 = full formant
+    double air = 0.0;                // 0.0 = bright (bypass) to 1.0 = dark
     bool useVowelMorph = true;       // Use vowel morph or manual formants
     
+    // 2-D vowel space (overrides vowel morph / manual formants when enabled)
+    bool useVowelSpace = false;
+    double vowelX = 0.5;             // 0.0 = front (I/E) to 1.0 = back (U/O)
+    double vowelY = 1.0;             // 0.0 = close (I/U) to 1.0 = open (A)
+    
     // Amp Envelope
     double ampAttack = 0.01;         // seconds
     double ampDecay = 0.1;           // seconds
@@ -55,6 +78,9 @@ struct VoxVoiceParameters {
     double lfoPhaseOffset = 0.0;     // 0.0 to 1.0 (represents 0-360°)
     bool lfoRetrigger = true;        // Retrigger LFO on note on
     double lfoPhaseSpread = 0.0;     // 0.0 to 1.0 (spread across voices)
+    int modControlRate = 1;          // Samples per modulation tick (1 = audio rate, up to 64)
+    bool lfoTempoSync = false;       // Rate from host tempo and lfoBeatDivision instead of lfoRate
+    int lfoBeatDivision = 5;         // LFO::BeatDivision index (5 = quarter note)
     
     // Per-Voice Mod Envelope (Phase 2.2)
     double modAttack = 0.01;         // seconds
@@ -67,12 +93,16 @@ struct VoxVoiceParameters {
     double lfoToFormant1 = 0.0;      // Hz (bipolar: ±amount)
     double lfoToFormant2 = 0.0;      // Hz (bipolar: ±amount)
     double lfoToDutyCycle = 0.0;     // normalized 0-1 (bipolar: ±amount)
+    double lfoToVowelX = 0.0;        // vowel space units (bipolar: ±amount)
+    double lfoToVowelY = 0.0;        // vowel space units (bipolar: ±amount)
     
     // Modulation Routing - Mod Envelope Destinations (Phase 2.3)
     double modEnvToPitch = 0.0;      // semitones (unipolar: 0 to +amount)
     double modEnvToFormant1 = 0.0;   // Hz (unipolar: 0 to +amount)
     double modEnvToFormant2 = 0.0;   // Hz (unipolar: 0 to +amount)
     double modEnvToDutyCycle = 0.0;  // normalized (unipolar: 0 to +amount)
+    double modEnvToVowelX = 0.0;     // vowel space units (unipolar: 0 to +amount)
+    double modEnvToVowelY = 0.0;     // vowel space units (unipolar: 0 to +amount)
     
     // Velocity Sensitivity (Phase 2.4)
     double velocitySensitivity = 1.0;  // 0.0 = no effect, 1.0 = full velocity scaling
@@ -83,14 +113,102 @@ struct VoxVoiceParameters {
     double aftertouchToFormant1 = 0.0;   // Hz at full pressure
     double aftertouchToFormant2 = 0.0;   // Hz at full pressure
     double aftertouchToLFOAmount = 0.0;  // Additional LFO depth at full pressure
+    
+    // Per-Note Timbre Routing (MPE CC74 / MIDI 2.0 per-note controller)
+    double timbreToFormant1 = 0.0;       // Hz (bipolar: ±amount)
+    double timbreToFormant2 = 0.0;       // Hz (bipolar: ±amount)
+    double timbreToVowelMorph = 0.0;     // morph units (bipolar: ±amount)
+    
+    // Per-Voice Drift and Chaos (VoicePool lanes; every voice wanders on its own)
+    int voiceDriftMode = 0;              // DriftGenerator::Mode index (0=RandomWalk, 1=Breath, 2=Tide, 3=Entropy)
+    double voiceDriftRate = 0.01;        // Hz (0.001 to 0.1)
+    double voiceDriftHalfLife = 2.0;     // seconds, Entropy mode (0.1 to 3600)
+    double voiceDriftToPitch = 0.0;      // cents (bipolar: ±amount)
+    double voiceDriftToFormant = 0.0;    // Hz on F1 and F2 in every formant mode (bipolar: ±amount)
+    int voiceChaosType = 0;              // ChaosGenerator::ChaosType index (0=Lorenz, 1=Henon, 2=Rossler)
+    double voiceChaosRate = 1.0;         // 0.1 to 10
+    double voiceChaosToPitch = 0.0;      // cents (bipolar: ±amount)
+    double voiceChaosToFormant = 0.0;    // Hz on F1 and F2 in every formant mode (bipolar: ±amount)
 };
 
-class VoxVoice {
+// Parameter groups: bit masks naming the subsystems a VoxVoiceParameters
+// field feeds. Fields outside every group (levels, pitch offsets, routing
+// depths, velocity and aftertouch amounts) are read from the stored
+// parameters at note-on or render time and need no rebuild.
+struct VoxParameterGroups {
+    static constexpr uint32_t kOscillator = 1u << 0;        // Duty cycle, pulsaret shape
+    static constexpr uint32_t kFormant = 1u << 1;           // Formant filter and vowel
+    static constexpr uint32_t kAir = 1u << 2;
+    static constexpr uint32_t kAmpEnvelope = 1u << 3;
+    static constexpr uint32_t kModEnvelope = 1u << 4;
+    static constexpr uint32_t kLFO = 1u << 5;               // Per-voice LFO and control rate
+    static constexpr uint32_t kGlide = 1u << 6;
+    static constexpr uint32_t kVoiceModulation = 1u << 7;   // VoicePool drift and chaos lanes
+    static constexpr uint32_t kAll = 0xFFFFFFFFu;
+
+    // Groups with at least one field that differs between a and b
+    static uint32_t changed(const VoxVoiceParameters& a, const VoxVoiceParameters& b) {
+        uint32_t groups = 0;
+        if (a.dutyCycle != b.dutyCycle || a.pulsaretShape != b.pulsaretShape) {
+            groups |= kOscillator;
+        }
+        if (a.formant1Freq != b.formant1Freq || a.formant2Freq != b.formant2Freq ||
+            a.formant1Q != b.formant1Q || a.formant2Q != b.formant2Q ||
+            a.vowelMorph != b.vowelMorph || a.formantMix != b.formantMix ||
+            a.useVowelMorph != b.useVowelMorph || a.useVowelSpace != b.useVowelSpace ||
+            a.vowelX != b.vowelX || a.vowelY != b.vowelY ||
+            a.timbreToVowelMorph != b.timbreToVowelMorph) {
+            groups |= kFormant;
+        }
+        if (a.air != b.air) {
+            groups |= kAir;
+        }
+        if (a.ampAttack != b.ampAttack || a.ampDecay != b.ampDecay ||
+            a.ampSustain != b.ampSustain || a.ampRelease != b.ampRelease) {
+            groups |= kAmpEnvelope;
+        }
+        if (a.modAttack != b.modAttack || a.modDecay != b.modDecay ||
+            a.modSustain != b.modSustain || a.modRelease != b.modRelease) {
+            groups |= kModEnvelope;
+        }
+        if (a.lfoRate != b.lfoRate || a.lfoWaveform != b.lfoWaveform ||
+            a.lfoPhaseOffset != b.lfoPhaseOffset || a.lfoRetrigger != b.lfoRetrigger ||
+            a.lfoPhaseSpread != b.lfoPhaseSpread || a.modControlRate != b.modControlRate ||
+            a.lfoTempoSync != b.lfoTempoSync || a.lfoBeatDivision != b.lfoBeatDivision) {
+            groups |= kLFO;
+        }
+        if (a.glideEnabled != b.glideEnabled || a.glideTime != b.glideTime) {
+            groups |= kGlide;
+        }
+        if (a.voiceDriftMode != b.voiceDriftMode || a.voiceDriftRate != b.voiceDriftRate ||
+            a.voiceDriftHalfLife != b.voiceDriftHalfLife || a.voiceDriftToPitch != b.voiceDriftToPitch ||
+            a.voiceDriftToFormant != b.voiceDriftToFormant || a.voiceChaosType != b.voiceChaosType ||
+            a.voiceChaosRate != b.voiceChaosRate || a.voiceChaosToPitch != b.voiceChaosToPitch ||
+            a.voiceChaosToFormant != b.voiceChaosToFormant) {
+            groups |= kVoiceModulation;
+        }
+        return groups;
+    }
+};
+
+template <typename SampleType>
+class VoxVoiceT {
 public:
-    VoxVoice(double sampleRate = 44100.0)
+    using OscillatorType = PulsarOscillatorT<SampleType>;
+    using FilterType = FormantFilterT<SampleType>;
+    using EnvelopeType = ADSREnvelopeT<SampleType>;
+    using LFOType = LFOT<SampleType>;
+    using AirType = AirFilterT<SampleType>;
+    
+    // Block renders run the per-sample source stage into scratch buffers of
+    // this many samples, then the fused output stage over the whole chunk
+    static constexpr int kRenderChunk = 64;
+    
+    VoxVoiceT(double sampleRate = 44100.0)
         : mSampleRate(sampleRate)
         , mPulsarOsc(sampleRate)
         , mFormantFilter(sampleRate)
+        , mAirFilter(sampleRate)
         , mAmpEnvelope(sampleRate)
         , mModEnvelope(sampleRate)
         , mLFO(sampleRate)
@@ -111,6 +229,7 @@ public:
         mSampleRate = sampleRate;
         mPulsarOsc.setSampleRate(sampleRate);
         mFormantFilter.setSampleRate(sampleRate);
+        mAirFilter.setSampleRate(sampleRate);
         mAmpEnvelope.setSampleRate(sampleRate);
         mModEnvelope.setSampleRate(sampleRate);
         mLFO.setSampleRate(sampleRate);
@@ -118,60 +237,87 @@ public:
     }
     
     void setParameters(const VoxVoiceParameters& params) {
+        setParameters(params, VoxParameterGroups::kAll);
+    }
+    
+    // Store params and rebuild only the subsystems in groups
+    // (VoxParameterGroups); the caller vouches that fields outside them are
+    // unchanged or need no rebuild
+    void setParameters(const VoxVoiceParameters& params, uint32_t groups) {
         mParams = params;
         
         // Apply to pulsar oscillator
-        mPulsarOsc.setDutyCycle(params.dutyCycle);
-        mPulsarOsc.setShape(static_cast<PulsarOscillator::Shape>(params.pulsaretShape));
+        if (groups & VoxParameterGroups::kOscillator) {
+            mPulsarOsc.setDutyCycle(params.dutyCycle);
+            mPulsarOsc.setShape(static_cast<typename OscillatorType::Shape>(params.pulsaretShape));
+        }
         
         // Apply to formant filter
-        if (params.useVowelMorph) {
-            mFormantFilter.setVowelMorph(params.vowelMorph);
-        } else {
-            mFormantFilter.setFormant1Frequency(params.formant1Freq);
-            mFormantFilter.setFormant2Frequency(params.formant2Freq);
+        if (groups & VoxParameterGroups::kFormant) {
+            if (params.useVowelSpace) {
+                mFormantFilter.setVowelPosition(params.vowelX, params.vowelY);
+            } else if (params.useVowelMorph) {
+                mFormantFilter.setVowelMorph(params.vowelMorph);
+            } else {
+                mFormantFilter.setFormant1Frequency(params.formant1Freq);
+                mFormantFilter.setFormant2Frequency(params.formant2Freq);
+            }
+            mFormantFilter.setFormant1Q(params.formant1Q);
+            mFormantFilter.setFormant2Q(params.formant2Q);
+            
+            // Calculate formant mix gains
+            double formantGain = params.formantMix;
+            double dryGain = 1.0 - params.formantMix;
+            mFormantFilter.setFormant1Gain(formantGain);
+            mFormantFilter.setFormant2Gain(formantGain * 0.7);  // F2 slightly lower
+            mFormantFilter.setDryGain(dryGain);
+        }
+        if (groups & VoxParameterGroups::kAir) {
+            mAirFilter.setAir(params.air);
         }
-        mFormantFilter.setFormant1Q(params.formant1Q);
-        mFormantFilter.setFormant2Q(params.formant2Q);
-        
-        // Calculate formant mix gains
-        double formantGain = params.formantMix;
-        double dryGain = 1.0 - params.formantMix;
-        mFormantFilter.setFormant1Gain(formantGain);
-        mFormantFilter.setFormant2Gain(formantGain * 0.7);  // F2 slightly lower
-        mFormantFilter.setDryGain(dryGain);
         
         // Apply to amp envelope
-        mAmpEnvelope.setAttackTime(params.ampAttack);
-        mAmpEnvelope.setDecayTime(params.ampDecay);
-        mAmpEnvelope.setSustainLevel(params.ampSustain);
-        mAmpEnvelope.setReleaseTime(params.ampRelease);
+        if (groups & VoxParameterGroups::kAmpEnvelope) {
+            mAmpEnvelope.setAttackTime(params.ampAttack);
+            mAmpEnvelope.setDecayTime(params.ampDecay);
+            mAmpEnvelope.setSustainLevel(params.ampSustain);
+            mAmpEnvelope.setReleaseTime(params.ampRelease);
+        }
         
         // Apply to mod envelope (Phase 2.2)
-        mModEnvelope.setAttackTime(params.modAttack);
-        mModEnvelope.setDecayTime(params.modDecay);
-        mModEnvelope.setSustainLevel(params.modSustain);
-        mModEnvelope.setReleaseTime(params.modRelease);
+        if (groups & VoxParameterGroups::kModEnvelope) {
+            mModEnvelope.setAttackTime(params.modAttack);
+            mModEnvelope.setDecayTime(params.modDecay);
+            mModEnvelope.setSustainLevel(params.modSustain);
+            mModEnvelope.setReleaseTime(params.modRelease);
+        }
         
         // Apply to LFO
-        mLFO.setRate(params.lfoRate);
-        mLFO.setWaveform(static_cast<LFO::Waveform>(params.lfoWaveform));
-        
-        // Calculate effective phase offset including voice spread
-        double effectivePhaseOffset = params.lfoPhaseOffset;
-        if (params.lfoPhaseSpread > 0.0) {
-            // Spread phase across voices (assuming max 8 voices)
-            effectivePhaseOffset += (mVoiceIndex / 8.0) * params.lfoPhaseSpread;
-            effectivePhaseOffset = std::fmod(effectivePhaseOffset, 1.0);
+        if (groups & VoxParameterGroups::kLFO) {
+            mLFO.setRate(params.lfoRate);
+            mLFO.setWaveform(static_cast<typename LFOType::Waveform>(params.lfoWaveform));
+            mLFO.setControlRate(params.modControlRate);
+            mLFO.setSyncMode(params.lfoTempoSync ? LFOType::SyncMode::TEMPO_SYNC : LFOType::SyncMode::FREE);
+            mLFO.setBeatDivision(static_cast<typename LFOType::BeatDivision>(params.lfoBeatDivision));
+            
+            // Calculate effective phase offset including voice spread
+            double effectivePhaseOffset = params.lfoPhaseOffset;
+            if (params.lfoPhaseSpread > 0.0) {
+                // Spread phase across voices (assuming max 8 voices)
+                effectivePhaseOffset += (mVoiceIndex / 8.0) * params.lfoPhaseSpread;
+                effectivePhaseOffset = std::fmod(effectivePhaseOffset, 1.0);
+            }
+            mLFO.setPhaseOffset(effectivePhaseOffset);
+            
+            // Set retrigger mode
+            mLFO.setRetriggerMode(params.lfoRetrigger ? 
+                LFOType::RetriggerMode::NOTE_ON : LFOType::RetriggerMode::FREE);
         }
-        mLFO.setPhaseOffset(effectivePhaseOffset);
-        
-        // Set retrigger mode
-        mLFO.setRetriggerMode(params.lfoRetrigger ? 
-            LFO::RetriggerMode::NOTE_ON : LFO::RetriggerMode::FREE);
         
         // Update glide coefficient
-        updateGlideCoeff();
+        if (groups & VoxParameterGroups::kGlide) {
+            updateGlideCoeff();
+        }
     }
     
     VoxVoiceParameters getParameters() const {
@@ -190,12 +336,15 @@ public:
         // Store raw velocity for mod envelope scaling
         mRawVelocity = clampedVelocity;
         
+        // A new note starts at its own gain; only later level changes ramp
+        mOutputGain = outputGainTarget();
+        
         mTargetNote = noteNumber;
         mTargetFrequency = noteToFrequency(noteNumber);
         
         // Apply pitch bend
         if (std::abs(mParams.pitchBendSemitones) > 0.001) {
-            mTargetFrequency *= std::pow(2.0, mParams.pitchBendSemitones / 12.0);
+            mTargetFrequency *= PitchTable::semitonesToRatio(mParams.pitchBendSemitones);
         }
         
         // Apply detune (Hz)
@@ -203,7 +352,7 @@ public:
         
         // Phase 3.1: Apply detune offset (cents)
         if (std::abs(mDetuneOffset) > 0.001) {
-            mTargetFrequency *= std::pow(2.0, mDetuneOffset / 1200.0);
+            mTargetFrequency *= PitchTable::centsToRatio(mDetuneOffset);
         }
         
         // Handle glide
@@ -231,8 +380,10 @@ public:
         }
         // else: envelope will be triggered in process() after offset countdown
         
-        // Reset aftertouch on new note (Phase 2.5)
+        // Reset aftertouch and per-note expression on new note
         mAftertouch = 0.0;
+        mNotePitchBend = 0.0;
+        mTimbre = 0.0;
         
         mNoteOn = true;
     }
@@ -247,6 +398,11 @@ public:
         }
     }
     
+    // Host tempo for a tempo-synced LFO
+    void setTempo(double bpm) {
+        mLFO.setTempo(bpm);
+    }
+    
     // Set pitch bend in semitones
     void setPitchBend(double semitones) {
         mParams.pitchBendSemitones = std::max(-12.0, std::min(12.0, semitones));
@@ -254,34 +410,295 @@ public:
         // Recalculate target frequency if note is playing
         if (mTargetNote >= 0) {
             mTargetFrequency = noteToFrequency(mTargetNote);
-            mTargetFrequency *= std::pow(2.0, mParams.pitchBendSemitones / 12.0);
+            mTargetFrequency *= PitchTable::semitonesToRatio(mParams.pitchBendSemitones);
             mTargetFrequency += mParams.detuneHz;
         }
     }
     
     // Check if voice is active (making sound)
     bool isActive() const {
-        return mAmpEnvelope.getState() != ADSREnvelope::State::IDLE;
+        return mAmpEnvelope.getState() != EnvelopeType::State::IDLE;
+    }
+    
+    // Predicted samples until this voice's output level (amp envelope x
+    // velocity x master) falls below threshold for good; kNeverSilent while
+    // the note is held or a delayed trigger is pending
+    int getSamplesUntilSilent(double threshold = 0.0001) const {
+        if (mTimeOffsetCounter > 0) {
+            return EnvelopeType::kNeverSilent;
+        }
+        double gain = mVelocity * mParams.masterVolume;
+        if (gain <= 0.0) {
+            return 0;
+        }
+        return mAmpEnvelope.getSamplesUntilSilent(threshold / gain);
+    }
+    
+    // Output level for voice stealing: amp envelope x velocity x master as
+    // of the last rendered sample. A note still in its attack (or waiting on
+    // a delayed trigger) counts at its peak, so a note that has just started
+    // is not mistaken for the faintest.
+    double getStealingLevel() const {
+        const double gain = mVelocity * mParams.masterVolume;
+        if (mTimeOffsetCounter > 0 || mAmpEnvelope.getState() == EnvelopeType::State::ATTACK) {
+            return gain;
+        }
+        return static_cast<double>(mAmpEnvelope.getCurrentLevel()) * gain;
+    }
+    
+    // True once the note is released and the amp envelope is in its tail
+    bool isReleasing() const {
+        return mAmpEnvelope.getState() == EnvelopeType::State::RELEASE;
     }
     
     // Reset voice
     void reset() {
         mPulsarOsc.reset();
         mFormantFilter.reset();
+        mFormantFilter.setGrainFormantOffset(0.0);
+        mGrainPan = 0.0;
+        mAirFilter.reset();
         mAmpEnvelope.reset();
         mModEnvelope.reset();  // Reset mod envelope (Phase 2.2)
         mLFO.reset();
         mCurrentNote = -1;
         mTargetNote = -1;
         mNoteOn = false;
-        mCurrentLFOValue = 0.0;
-        mCurrentModEnvValue = 0.0;
+        mCurrentLFOValue = SampleType(0);
+        mCurrentModEnvValue = SampleType(0);
         mTimeOffsetCounter = 0;  // Phase 3.2
     }
     
     // Process one sample
-    double process() {
-        // Phase 3.2: Handle time offset countdown
+    SampleType process() {
+        SampleType dry, env;
+        SampleType signal = renderSource(dry, env);
+        
+        // Output stage: formant/dry mix, Air, amp envelope, velocity x master
+        mOutputGain = outputGainTarget();
+        signal += dry * mFormantFilter.getDryGain();
+        signal = mAirFilter.process(signal);
+        signal *= env;
+        signal *= mOutputGain;
+        
+        return signal;
+    }
+    
+    // Process a block of samples
+    void processBlock(SampleType* output, int numSamples) {
+        renderBlock(output, numSamples, false, false);
+    }
+    
+    // Process and add to buffer (for mixing multiple voices)
+    void processBlockAdd(SampleType* output, int numSamples) {
+        renderBlock(output, numSamples, true, false);
+    }
+    
+    // Add to buffer until the amp envelope goes idle, matching how the pool
+    // skips inactive voices per sample. Returns the number of samples rendered.
+    int processBlockAddWhileActive(SampleType* output, int numSamples) {
+        return renderBlock(output, numSamples, true, true);
+    }
+    
+    // Add one chunk (count <= kRenderChunk) to the buffer using envelope
+    // values rendered outside the voice (the pool's EnvelopeBank), read at
+    // ampEnv[i * stride] and modEnv[i * stride]. The caller has already
+    // advanced this voice's envelopes, so count is the number of samples the
+    // amp envelope stayed active. Only valid with no delayed trigger pending.
+    void processBlockAddWithEnvelopes(SampleType* output, int count,
+                                      const SampleType* ampEnv, const SampleType* modEnv,
+                                      int stride) {
+        count = renderWithEnvelopes(count, ampEnv, modEnv, stride);
+        applyOutputStage<true>(output, count);
+    }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Stereo block render
+    // ═══════════════════════════════════════════════════════════════
+    
+    // Same renders as the mono block calls, panned into left/right with
+    // constant-power gains. The pan is the voice's constellation pan plus the
+    // current grain's pan scatter (latched at grain onset) plus the pool's
+    // global pan modulation; gains are only recomputed when that sum changes.
+    void processBlockStereo(SampleType* left, SampleType* right, int numSamples) {
+        renderBlock(left, numSamples, false, false, right);
+    }
+    
+    void processBlockStereoAdd(SampleType* left, SampleType* right, int numSamples) {
+        renderBlock(left, numSamples, true, false, right);
+    }
+    
+    int processBlockStereoAddWhileActive(SampleType* left, SampleType* right, int numSamples) {
+        return renderBlock(left, numSamples, true, true, right);
+    }
+    
+    void processBlockStereoAddWithEnvelopes(SampleType* left, SampleType* right, int count,
+                                            const SampleType* ampEnv, const SampleType* modEnv,
+                                            int stride) {
+        count = renderWithEnvelopes(count, ampEnv, modEnv, stride);
+        applyStereoOutputStage<true>(left, right, count);
+    }
+    
+    // True while a time-offset (Phase 3.2) trigger is counting down
+    bool hasPendingTrigger() const { return mTimeOffsetCounter > 0; }
+    
+    // Get current envelope state
+    typename EnvelopeType::State getEnvelopeState() const {
+        return mAmpEnvelope.getState();
+    }
+    
+    // Get current note
+    int getCurrentNote() const { return mCurrentNote; }
+    
+    // Voice index (for LFO phase spreading)
+    void setVoiceIndex(int index) { 
+        mVoiceIndex = index;
+        // Reapply parameters to update phase offset
+        setParameters(mParams);
+    }
+    int getVoiceIndex() const { return mVoiceIndex; }
+    
+    // Get current LFO value (for monitoring/visualization)
+    SampleType getLFOValue() const { return mCurrentLFOValue; }
+    
+    // Phase 5: Stochastic cloud parameters for this voice's oscillator
+    void setStochasticParams(const StochasticParams& params) {
+        mPulsarOsc.setStochasticParams(params);
+    }
+    StochasticParams getStochasticParams() const { return mPulsarOsc.getStochasticParams(); }
+    void seedRNG(unsigned int seed) { mPulsarOsc.seedRNG(seed); }
+    
+    // Formant scatter currently latched into the filter (Hz)
+    double getGrainFormantOffset() const { return mFormantFilter.getGrainFormantOffset(); }
+    
+    // Pan scatter of the current grain, latched at its onset (-1 to +1)
+    double getGrainPanOffset() const { return mGrainPan; }
+    
+    // Access to LFO for advanced control
+    LFOType& getLFO() { return mLFO; }
+    const LFOType& getLFO() const { return mLFO; }
+    
+    // Shared LFO (VoicePool): while set, each rendered sample takes its LFO
+    // value from values[] in order instead of running the voice's own LFO.
+    // The pool sets this per render span and clears it with nullptr.
+    void setSharedLFOValues(const SampleType* values) {
+        mSharedLFOValues = values;
+        mSharedLFOIndex = 0;
+    }
+    
+    // Shared LFO at this voice's phase offset (VoicePool): render the span's
+    // count (<= kRenderChunk) LFO values in one block, read at the shared
+    // accumulator's base phase plus the offset, and take them as shared
+    // values. Cleared like setSharedLFOValues().
+    void renderSharedLFOAtOffset(double basePhase, int count) {
+        mLFO.syncToBasePhase(basePhase);
+        mLFO.processBlock(mLFOBuffer.data(), count);
+        setSharedLFOValues(mLFOBuffer.data());
+    }
+    
+    // Global modulation (VoicePool): while set, each rendered sample adds the
+    // next entry of the block's active destination buffers. The pool sets
+    // this per render span and clears it with nullptr.
+    void setGlobalModulation(const GlobalModulationBlock* block) {
+        mGlobalModulation = block;
+        mGlobalModulationIndex = 0;
+    }
+    
+    // Per-voice drift and chaos (VoicePool): ramp the pitch (semitones) and
+    // formant (Hz) offsets to new values over the next samples samples
+    void setVoiceModulation(double pitchSemitones, double formantHz, int samples) {
+        mVoicePitchRamp.setTarget(pitchSemitones, samples);
+        mVoiceFormantRamp.setTarget(formantHz, samples);
+        mVoiceModulated = true;
+    }
+    
+    // Jump straight to the offsets (note start)
+    void resetVoiceModulation(double pitchSemitones, double formantHz) {
+        mVoicePitchRamp.reset(pitchSemitones);
+        mVoiceFormantRamp.reset(formantHz);
+        mVoiceModulated = true;
+    }
+    
+    void clearVoiceModulation() {
+        resetVoiceModulation(0.0, 0.0);
+        mVoiceModulated = false;
+    }
+    
+    // Get current mod envelope value (Phase 2.2)
+    SampleType getModEnvelopeValue() const { return mCurrentModEnvValue; }
+    
+    // Get mod envelope state (Phase 2.2)
+    typename EnvelopeType::State getModEnvelopeState() const { return mModEnvelope.getState(); }
+    
+    // Access to amp envelope (envelope bank gather/scatter)
+    EnvelopeType& getAmpEnvelope() { return mAmpEnvelope; }
+    const EnvelopeType& getAmpEnvelope() const { return mAmpEnvelope; }
+    
+    // Access to mod envelope for advanced control
+    EnvelopeType& getModEnvelope() { return mModEnvelope; }
+    const EnvelopeType& getModEnvelope() const { return mModEnvelope; }
+    
+    // Polyphonic aftertouch (Phase 2.5)
+    void setAftertouch(double pressure) {
+        mAftertouch = std::max(0.0, std::min(1.0, pressure));
+    }
+    double getAftertouch() const { return mAftertouch; }
+    
+    // Per-note pitch bend in semitones (MPE member channel, MIDI 2.0
+    // per-note bend), on top of the pool-wide bend; applied at modulation
+    // rate, so it slides without glide or retuning the target note
+    void setNotePitchBend(double semitones) {
+        mNotePitchBend = std::max(-96.0, std::min(96.0, semitones));
+    }
+    double getNotePitchBend() const { return mNotePitchBend; }
+    
+    // Per-note timbre (MPE CC74, MIDI 2.0 per-note controller), bipolar
+    // -1 to +1 around the neutral 0
+    void setTimbre(double timbre) {
+        mTimbre = std::max(-1.0, std::min(1.0, timbre));
+    }
+    double getTimbre() const { return mTimbre; }
+    
+    // ═══════════════════════════════════════════════════════════════
+    // Phase 3: Voice Constellation Parameters
+    // ═══════════════════════════════════════════════════════════════
+    
+    // Phase 3.1: Detune offset in cents
+    void setDetuneOffset(double cents) { mDetuneOffset = cents; }
+    double getDetuneOffset() const { return mDetuneOffset; }
+    
+    // Phase 3.2: Time offset in milliseconds (delay before note triggers)
+    void setTimeOffset(double ms) { mTimeOffsetMs = ms; }
+    double getTimeOffset() const { return mTimeOffsetMs; }
+    
+    // Phase 3.3: Formant offset in Hz
+    void setFormantOffset(double hz) { mFormantOffsetHz = hz; }
+    double getFormantOffset() const { return mFormantOffsetHz; }
+    
+    // Phase 3.4: Pan position (-1 = left, 0 = center, +1 = right)
+    void setPan(double pan) { mPan = std::max(-1.0, std::min(1.0, pan)); }
+    double getPan() const { return mPan; }
+    
+    // Phase 3.5: LFO phase offset (0.0 to 1.0, represents 0-360°)
+    void setLFOPhaseOffset(double offset) {
+        mLFOPhaseOffset = std::fmod(std::max(0.0, offset), 1.0);
+        mLFO.setPhaseOffset(mLFOPhaseOffset);
+    }
+    double getLFOPhaseOffset() const { return mLFOPhaseOffset; }
+    
+private:
+    // Per-sample source stage: modulation, oscillator, formant bands, and amp
+    // envelope. Returns the formant (wet) signal; the raw oscillator sample
+    // and envelope value are handed back for the output stage.
+    SampleType renderSource(SampleType& dry, SampleType& env) {
+        advanceTimeOffset();
+        SampleType modEnv = mModEnvelope.process();
+        env = mAmpEnvelope.process();
+        return renderModulatedSource(modEnv, dry);
+    }
+    
+    // Phase 3.2: Handle time offset countdown
+    void advanceTimeOffset() {
         if (mTimeOffsetCounter > 0) {
             mTimeOffsetCounter--;
             if (mTimeOffsetCounter == 0) {
@@ -294,10 +711,114 @@ public:
                 }
             }
         }
+    }
+    
+    // Source stage after the envelopes: glide, LFO, modulation routing,
+    // oscillator, and formant bands, given this sample's mod envelope value
+    SampleType renderModulatedSource(SampleType modEnv, SampleType& dry) {
+        advanceGlide(mGlideCoeff);
         
-        // Handle glide
+        // Process LFO (advance phase even when voice may not be modulating yet)
+        if (mSharedLFOValues) {
+            mCurrentLFOValue = mSharedLFOValues[mSharedLFOIndex++];
+        } else {
+            mCurrentLFOValue = mLFO.process();
+        }
+        
+        // Mod envelope value (Phase 2.2)
+        mCurrentModEnvValue = modEnv;
+        
+        // Per-voice drift and chaos offsets, ramped between pool ticks
+        double voicePitchMod = 0.0;
+        double voiceFormantMod = 0.0;
+        if (mVoiceModulated) {
+            voicePitchMod = nextVoiceModulation(mVoicePitchRamp);
+            voiceFormantMod = nextVoiceModulation(mVoiceFormantRamp);
+        }
+        
+        double frequency, duty;
+        evaluateModulation(voicePitchMod, voiceFormantMod,
+                           mGlobalModulation ? mGlobalModulationIndex++ : -1, frequency, duty);
+        mPulsarOsc.setFrequency(frequency);
+        mPulsarOsc.setDutyCycle(duty);
+        return renderOscillator(dry);
+    }
+    
+    // Source stage over a chunk (count <= kRenderChunk) whose mod envelope
+    // is already rendered at modEnv[i * stride]. At audio rate this is
+    // renderModulatedSource() per sample; with modControlRate > 1 the
+    // modulation is evaluated once per control tick (renderModulatedTick).
+    void renderModulatedChunk(const SampleType* modEnv, int stride, int count) {
+        const int tick = ControlRate::clampSamples(mParams.modControlRate);
+        if (tick == ControlRate::kAudioRate) {
+            for (int i = 0; i < count; ++i) {
+                mWetBuffer[i] = renderModulatedSource(modEnv[i * stride], mDryBuffer[i]);
+                mGrainPanBuffer[i] = mGrainPan;
+            }
+            return;
+        }
+        for (int pos = 0; pos < count; ) {
+            int n = std::min(tick, count - pos);
+            renderModulatedTick(modEnv[(pos + n - 1) * stride], pos, n);
+            pos += n;
+        }
+    }
+    
+    // Control-rate source stage for samples [start, start + n) of the chunk
+    // buffers (one tick). Glide, LFO, voice
+    // and global modulation advance by the whole tick and the routing sum
+    // (with its pow) is evaluated once for the tick's last sample; frequency
+    // and duty cycle then ramp linearly from their current values across the
+    // tick, and formant targets land once per tick (one coefficient update)
+    // while the inner loop runs only the oscillator and formant bands.
+    void renderModulatedTick(SampleType modEnvEnd, int start, int n) {
+        if (n != mTickGlideSamples) {
+            mTickGlideSamples = n;
+            mTickGlideCoeff = 1.0 - std::pow(1.0 - mGlideCoeff, n);
+        }
+        advanceGlide(mTickGlideCoeff);
+        
+        if (mSharedLFOValues) {
+            mSharedLFOIndex += n;
+            mCurrentLFOValue = mSharedLFOValues[mSharedLFOIndex - 1];
+        } else {
+            for (int i = 0; i < n; ++i) {
+                mCurrentLFOValue = mLFO.process();
+            }
+        }
+        mCurrentModEnvValue = modEnvEnd;
+        
+        double voicePitchMod = 0.0;
+        double voiceFormantMod = 0.0;
+        if (mVoiceModulated) {
+            voicePitchMod = skipVoiceModulation(mVoicePitchRamp, n);
+            voiceFormantMod = skipVoiceModulation(mVoiceFormantRamp, n);
+        }
+        int globalIndex = -1;
+        if (mGlobalModulation) {
+            mGlobalModulationIndex += n;
+            globalIndex = mGlobalModulationIndex - 1;
+        }
+        
+        double frequency, duty;
+        evaluateModulation(voicePitchMod, voiceFormantMod, globalIndex, frequency, duty);
+        mFrequencyRamp.reset(mPulsarOsc.getFrequency());
+        mFrequencyRamp.setTarget(frequency, n);
+        mDutyRamp.reset(mPulsarOsc.getDutyCycle());
+        mDutyRamp.setTarget(duty, n);
+        
+        for (int i = start; i < start + n; ++i) {
+            mPulsarOsc.setFrequency(mFrequencyRamp.next());
+            mPulsarOsc.setDutyCycle(mDutyRamp.next());
+            mWetBuffer[i] = renderOscillator(mDryBuffer[i]);
+            mGrainPanBuffer[i] = mGrainPan;
+        }
+    }
+    
+    // Glide toward the target frequency by one step of coeff
+    void advanceGlide(double coeff) {
         if (mParams.glideEnabled && std::abs(mCurrentFrequency - mTargetFrequency) > 0.1) {
-            mCurrentFrequency += (mTargetFrequency - mCurrentFrequency) * mGlideCoeff;
+            mCurrentFrequency += (mTargetFrequency - mCurrentFrequency) * coeff;
         } else if (std::abs(mCurrentFrequency - mTargetFrequency) > 0.1) {
             // Not gliding but frequency mismatch (pitch bend change)
             mCurrentFrequency = mTargetFrequency;
@@ -309,13 +830,13 @@ public:
                 mCurrentNote = mTargetNote;
             }
         }
-        
-        // Process LFO (advance phase even when voice may not be modulating yet)
-        mCurrentLFOValue = mLFO.process();
-        
-        // Process mod envelope (Phase 2.2)
-        mCurrentModEnvValue = mModEnvelope.process();
-        
+    }
+    
+    // Routing sum for the current LFO and mod envelope values: returns the
+    // oscillator frequency and duty cycle, and sets the formant filter.
+    // globalIndex is the sample of the pool's global block to add (-1: none).
+    void evaluateModulation(double voicePitchMod, double voiceFormantMod, int globalIndex,
+                            double& frequency, double& duty) {
         // ═══════════════════════════════════════════════════════════════
         // Phase 2.3 & 2.4: Apply Modulation Routing
         // ═══════════════════════════════════════════════════════════════
@@ -324,151 +845,276 @@ public:
         // At velocityToModEnv = 0: full mod env
         // At velocityToModEnv = 1: mod env scaled by raw velocity
         double velocityModScale = (1.0 - mParams.velocityToModEnv) + (mRawVelocity * mParams.velocityToModEnv);
-        double effectiveModEnv = mCurrentModEnvValue * velocityModScale;
+        double lfoValue = static_cast<double>(mCurrentLFOValue);
+        double effectiveModEnv = static_cast<double>(mCurrentModEnvValue) * velocityModScale;
         
         // Calculate effective LFO amount with aftertouch scaling (Phase 2.5)
         double effectiveLFOAmount = 1.0 + (mAftertouch * mParams.aftertouchToLFOAmount);
         
+        // Global modulation, rendered once per span by the pool
+        double globalPitchMod = 0.0;
+        double globalFormant1Mod = 0.0;
+        double globalFormant2Mod = 0.0;
+        double globalDutyMod = 0.0;
+        if (globalIndex >= 0) {
+            const GlobalModulationBlock& global = *mGlobalModulation;
+            const int g = globalIndex;
+            globalPitchMod = global.pitch[g];
+            globalFormant1Mod = global.formant1[g];
+            globalFormant2Mod = global.formant2[g];
+            globalDutyMod = global.dutyCycle[g];
+            if (global.vowelMorphActive && mParams.useVowelMorph && !mParams.useVowelSpace) {
+                mFormantFilter.setVowelMorph(mParams.vowelMorph + global.vowelMorph[g] +
+                                             mTimbre * mParams.timbreToVowelMorph);
+            }
+        }
+        if (mParams.timbreToVowelMorph != 0.0 && mParams.useVowelMorph && !mParams.useVowelSpace &&
+            (globalIndex < 0 || !mGlobalModulation->vowelMorphActive)) {
+            mFormantFilter.setVowelMorph(mParams.vowelMorph + mTimbre * mParams.timbreToVowelMorph);
+        }
+        
         // Calculate pitch modulation (in semitones)
         // LFO is bipolar (-1 to +1), mod env is unipolar (0 to 1), aftertouch is unipolar (0 to 1)
-        double pitchModSemitones = (mCurrentLFOValue * mParams.lfoToPitch * effectiveLFOAmount) + 
+        double pitchModSemitones = (lfoValue * mParams.lfoToPitch * effectiveLFOAmount) + 
                                    (effectiveModEnv * mParams.modEnvToPitch) +
-                                   (mAftertouch * mParams.aftertouchToPitch);  // Phase 2.5
+                                   (mAftertouch * mParams.aftertouchToPitch) +  // Phase 2.5
+                                   mNotePitchBend +
+                                   voicePitchMod + globalPitchMod;
         
         // Apply pitch modulation to frequency
-        double modulatedFrequency = mCurrentFrequency;
+        frequency = mCurrentFrequency;
         if (std::abs(pitchModSemitones) > 0.001) {
-            modulatedFrequency *= std::pow(2.0, pitchModSemitones / 12.0);
+            frequency *= PitchTable::semitonesToRatio(pitchModSemitones);
         }
-        mPulsarOsc.setFrequency(modulatedFrequency);
         
         // Calculate duty cycle modulation
-        double dutyMod = (mCurrentLFOValue * mParams.lfoToDutyCycle * effectiveLFOAmount) +
-                         (effectiveModEnv * mParams.modEnvToDutyCycle);
-        double modulatedDuty = std::max(0.01, std::min(1.0, mParams.dutyCycle + dutyMod));
-        mPulsarOsc.setDutyCycle(modulatedDuty);
+        double dutyMod = (lfoValue * mParams.lfoToDutyCycle * effectiveLFOAmount) +
+                         (effectiveModEnv * mParams.modEnvToDutyCycle) +
+                         globalDutyMod;
+        duty = std::max(0.01, std::min(1.0, mParams.dutyCycle + dutyMod));
         
         // Calculate formant modulation (including aftertouch - Phase 2.5)
         // Phase 3.3: Include formant offset from constellation
-        double formant1Mod = (mCurrentLFOValue * mParams.lfoToFormant1 * effectiveLFOAmount) +
+        double formant1Mod = (lfoValue * mParams.lfoToFormant1 * effectiveLFOAmount) +
                              (effectiveModEnv * mParams.modEnvToFormant1) +
                              (mAftertouch * mParams.aftertouchToFormant1) +
-                             mFormantOffsetHz;  // Constellation offset
-        double formant2Mod = (mCurrentLFOValue * mParams.lfoToFormant2 * effectiveLFOAmount) +
+                             (mTimbre * mParams.timbreToFormant1) +
+                             mFormantOffsetHz +  // Constellation offset
+                             voiceFormantMod + globalFormant1Mod;
+        double formant2Mod = (lfoValue * mParams.lfoToFormant2 * effectiveLFOAmount) +
                              (effectiveModEnv * mParams.modEnvToFormant2) +
                              (mAftertouch * mParams.aftertouchToFormant2) +
-                             (mFormantOffsetHz * 0.8);  // Slightly less offset for F2
+                             (mTimbre * mParams.timbreToFormant2) +
+                             (mFormantOffsetHz * 0.8) +  // Slightly less offset for F2
+                             voiceFormantMod + globalFormant2Mod;
         
-        // Apply formant modulation (only if using manual formants, not vowel morph)
-        if (!mParams.useVowelMorph) {
+        // Apply formant modulation. Manual formants take every source; vowel
+        // morph and vowel space set their own frequencies, and per-voice
+        // drift and chaos and global modulation move them as Hz offsets in
+        // the filter.
+        if (mParams.useVowelSpace) {
+            // 2-D vowel space: LFO and mod envelope move the XY position; the
+            // filter only recomputes (by grid lookup) when the position moves
+            double vowelX = mParams.vowelX +
+                            (lfoValue * mParams.lfoToVowelX * effectiveLFOAmount) +
+                            (effectiveModEnv * mParams.modEnvToVowelX);
+            double vowelY = mParams.vowelY +
+                            (lfoValue * mParams.lfoToVowelY * effectiveLFOAmount) +
+                            (effectiveModEnv * mParams.modEnvToVowelY);
+            mFormantFilter.setVowelPosition(vowelX, vowelY);
+            mFormantFilter.setFormantModulation(voiceFormantMod + globalFormant1Mod,
+                                                voiceFormantMod + globalFormant2Mod);
+        } else if (!mParams.useVowelMorph) {
             double modulatedF1 = std::max(80.0, std::min(4000.0, mParams.formant1Freq + formant1Mod));
             double modulatedF2 = std::max(200.0, std::min(6000.0, mParams.formant2Freq + formant2Mod));
             mFormantFilter.setFormant1Frequency(modulatedF1);
             mFormantFilter.setFormant2Frequency(modulatedF2);
+            mFormantFilter.setFormantModulation(0.0, 0.0);
+        } else {
+            mFormantFilter.setFormantModulation(voiceFormantMod + globalFormant1Mod,
+                                                voiceFormantMod + globalFormant2Mod);
         }
         
-        // ═══════════════════════════════════════════════════════════════
-        
+    }
+    
+    // Oscillator and formant bands for one sample (dry path is mixed in the
+    // output stage)
+    SampleType renderOscillator(SampleType& dry) {
         // Generate pulsar signal
-        double signal = mPulsarOsc.process();
+        SampleType signal = mPulsarOsc.process();
         
-        // Apply formant filter
-        signal = mFormantFilter.process(signal);
-        
-        // Apply amplitude envelope
-        double envValue = mAmpEnvelope.process();
-        signal *= envValue;
-        
-        // Apply velocity and master volume
-        signal *= mVelocity * mParams.masterVolume;
+        // Phase 5.3: Latch per-grain formant and pan scatter at grain onset
+        // only; the filter recomputes coefficients lazily, so this costs one
+        // update per grain instead of one per sample
+        if (mPulsarOsc.grainStarted()) {
+            mFormantFilter.setGrainFormantOffset(mPulsarOsc.getGrainFormantOffset());
+            mGrainPan = mPulsarOsc.getGrainPanOffset();
+        }
         
-        return signal;
+        dry = signal;
+        return mFormantFilter.processWet(signal);
     }
     
-    // Process a block of samples
-    void processBlock(double* output, int numSamples) {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = process();
-        }
+    // Next ramp sample, holding the last value if the pool's tick is late
+    static double nextVoiceModulation(ControlRamp& ramp) {
+        return ramp.getRemaining() > 0 ? ramp.next() : ramp.getValue();
     }
     
-    // Process and add to buffer (for mixing multiple voices)
-    void processBlockAdd(double* output, int numSamples) {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] += process();
-        }
+    // Ramp value n samples on (control-rate ticks)
+    static double skipVoiceModulation(ControlRamp& ramp, int n) {
+        return ramp.skip(std::min(n, ramp.getRemaining()));
     }
     
-    // Get current envelope state
-    ADSREnvelope::State getEnvelopeState() const {
-        return mAmpEnvelope.getState();
+    // Chunked block render; with right set, output is the left channel and
+    // the output stage pans into both
+    int renderBlock(SampleType* output, int numSamples, bool accumulate, bool stopWhenIdle,
+                    SampleType* right = nullptr) {
+        int done = 0;
+        while (done < numSamples) {
+            int count = std::min(kRenderChunk, numSamples - done);
+            int rendered = 0;
+            if (mTimeOffsetCounter == 0) {
+                // No pending delayed trigger: both envelopes render the chunk
+                // at block rate, branching only at segment boundaries
+                if (stopWhenIdle) {
+                    rendered = mAmpEnvelope.processBlockWhileActive(mEnvBuffer.data(), count);
+                } else {
+                    mAmpEnvelope.processBlock(mEnvBuffer.data(), count);
+                    rendered = count;
+                }
+                mModEnvelope.processBlock(mModEnvBuffer.data(), rendered);
+                renderModulatedChunk(mModEnvBuffer.data(), 1, rendered);
+            } else {
+                for (; rendered < count; ++rendered) {
+                    if (stopWhenIdle && !isActive()) {
+                        break;
+                    }
+                    mWetBuffer[rendered] = renderSource(mDryBuffer[rendered], mEnvBuffer[rendered]);
+                    mGrainPanBuffer[rendered] = mGrainPan;
+                }
+            }
+            
+            if (right) {
+                if (accumulate) {
+                    applyStereoOutputStage<true>(output + done, right + done, rendered);
+                } else {
+                    applyStereoOutputStage<false>(output + done, right + done, rendered);
+                }
+            } else if (accumulate) {
+                applyOutputStage<true>(output + done, rendered);
+            } else {
+                applyOutputStage<false>(output + done, rendered);
+            }
+            
+            done += rendered;
+            if (rendered < count) {
+                break;
+            }
+        }
+        return done;
     }
     
-    // Get current note
-    int getCurrentNote() const { return mCurrentNote; }
-    
-    // Voice index (for LFO phase spreading)
-    void setVoiceIndex(int index) { 
-        mVoiceIndex = index;
-        // Reapply parameters to update phase offset
-        setParameters(mParams);
+    // Source stage of processBlock*WithEnvelopes; returns the clamped count
+    int renderWithEnvelopes(int count, const SampleType* ampEnv, const SampleType* modEnv, int stride) {
+        count = std::min(count, kRenderChunk);
+        for (int i = 0; i < count; ++i) {
+            mEnvBuffer[i] = ampEnv[i * stride];
+        }
+        renderModulatedChunk(modEnv, stride, count);
+        return count;
     }
-    int getVoiceIndex() const { return mVoiceIndex; }
     
-    // Get current LFO value (for monitoring/visualization)
-    double getLFOValue() const { return mCurrentLFOValue; }
-    
-    // Access to LFO for advanced control
-    LFO& getLFO() { return mLFO; }
-    const LFO& getLFO() const { return mLFO; }
-    
-    // Get current mod envelope value (Phase 2.2)
-    double getModEnvelopeValue() const { return mCurrentModEnvValue; }
-    
-    // Get mod envelope state (Phase 2.2)
-    ADSREnvelope::State getModEnvelopeState() const { return mModEnvelope.getState(); }
-    
-    // Access to mod envelope for advanced control
-    ADSREnvelope& getModEnvelope() { return mModEnvelope; }
-    const ADSREnvelope& getModEnvelope() const { return mModEnvelope; }
-    
-    // Polyphonic aftertouch (Phase 2.5)
-    void setAftertouch(double pressure) {
-        mAftertouch = std::max(0.0, std::min(1.0, pressure));
+    // Stereo output stage: the mono output stage into a scratch buffer, then
+    // constant-power panning into left/right. Without grain pan scatter or
+    // global pan modulation the gains are constant across the chunk.
+    template <bool Accumulate>
+    void applyStereoOutputStage(SampleType* left, SampleType* right, int count) {
+        if (count <= 0) {
+            return;
+        }
+        applyOutputStage<false>(mMonoBuffer.data(), count);
+        
+        const double* globalPan = nullptr;
+        if (mGlobalModulation && mGlobalModulation->panActive) {
+            globalPan = mGlobalModulation->pan.data() + (mGlobalModulationIndex - count);
+        }
+        
+        // Scatter off: grain offsets are 0 from the first grain after it
+        if (!globalPan && mPulsarOsc.getPanScatter() <= 0.0 && mGrainPanBuffer[0] == 0.0) {
+            updatePanGains(mPan);
+            const SampleType leftGain = mLeftGain;
+            const SampleType rightGain = mRightGain;
+            for (int i = 0; i < count; ++i) {
+                SampleType y = mMonoBuffer[i];
+                left[i] = Accumulate ? left[i] + y * leftGain : y * leftGain;
+                right[i] = Accumulate ? right[i] + y * rightGain : y * rightGain;
+            }
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            double pan = mPan + mGrainPanBuffer[i];
+            if (globalPan) {
+                pan += globalPan[i];
+            }
+            updatePanGains(pan);
+            SampleType y = mMonoBuffer[i];
+            left[i] = Accumulate ? left[i] + y * mLeftGain : y * mLeftGain;
+            right[i] = Accumulate ? right[i] + y * mRightGain : y * mRightGain;
+        }
     }
-    double getAftertouch() const { return mAftertouch; }
     
-    // ═══════════════════════════════════════════════════════════════
-    // Phase 3: Voice Constellation Parameters
-    // ═══════════════════════════════════════════════════════════════
-    
-    // Phase 3.1: Detune offset in cents
-    void setDetuneOffset(double cents) { mDetuneOffset = cents; }
-    double getDetuneOffset() const { return mDetuneOffset; }
-    
-    // Phase 3.2: Time offset in milliseconds (delay before note triggers)
-    void setTimeOffset(double ms) { mTimeOffsetMs = ms; }
-    double getTimeOffset() const { return mTimeOffsetMs; }
-    
-    // Phase 3.3: Formant offset in Hz
-    void setFormantOffset(double hz) { mFormantOffsetHz = hz; }
-    double getFormantOffset() const { return mFormantOffsetHz; }
+    // Constant-power gains for a pan position, cached until the position
+    // changes: cos/sin of (pan + 1) * pi/4, as quarter-wave sinTurns
+    void updatePanGains(double pan) {
+        pan = std::max(-1.0, std::min(1.0, pan));
+        if (pan == mGainPan) {
+            return;
+        }
+        mGainPan = pan;
+        double turns = (pan + 1.0) * 0.125;
+        mLeftGain = static_cast<SampleType>(DSPUtilities::sinTurns(0.25 - turns));
+        mRightGain = static_cast<SampleType>(DSPUtilities::sinTurns(turns));
+    }
     
-    // Phase 3.4: Pan position (-1 = left, 0 = center, +1 = right)
-    void setPan(double pan) { mPan = std::max(-1.0, std::min(1.0, pan)); }
-    double getPan() const { return mPan; }
+    // Fused output stage over one chunk: formant/dry mix, Air, amp envelope,
+    // and the precombined velocity x master gain, ramped linearly from the
+    // previous chunk's gain. One pass over the scratch buffers; with Air
+    // bypassed the loop has no recurrence and vectorizes.
+    template <bool Accumulate>
+    void applyOutputStage(SampleType* output, int count) {
+        if (count <= 0) {
+            return;
+        }
+        const SampleType dryGain = mFormantFilter.getDryGain();
+        const SampleType startGain = mOutputGain;
+        const SampleType targetGain = outputGainTarget();
+        const SampleType gainStep = (targetGain - startGain) / static_cast<SampleType>(count);
+        
+        if (mAirFilter.isBypassed()) {
+            for (int i = 0; i < count; ++i) {
+                SampleType gain = startGain + gainStep * static_cast<SampleType>(i + 1);
+                SampleType y = (mWetBuffer[i] + mDryBuffer[i] * dryGain) * mEnvBuffer[i] * gain;
+                output[i] = Accumulate ? output[i] + y : y;
+            }
+            mAirFilter.process(mWetBuffer[count - 1] + mDryBuffer[count - 1] * dryGain);
+        } else {
+            for (int i = 0; i < count; ++i) {
+                SampleType gain = startGain + gainStep * static_cast<SampleType>(i + 1);
+                SampleType x = mAirFilter.process(mWetBuffer[i] + mDryBuffer[i] * dryGain);
+                SampleType y = x * mEnvBuffer[i] * gain;
+                output[i] = Accumulate ? output[i] + y : y;
+            }
+        }
+        mOutputGain = targetGain;
+    }
     
-    // Phase 3.5: LFO phase offset (0.0 to 1.0, represents 0-360°)
-    void setLFOPhaseOffset(double offset) {
-        mLFOPhaseOffset = std::fmod(std::max(0.0, offset), 1.0);
-        mLFO.setPhaseOffset(mLFOPhaseOffset);
+    SampleType outputGainTarget() const {
+        return static_cast<SampleType>(mVelocity * mParams.masterVolume);
     }
-    double getLFOPhaseOffset() const { return mLFOPhaseOffset; }
     
-private:
     double noteToFrequency(int noteNumber) const {
         // MIDI note to frequency: f = 440 * 2^((n-69)/12)
-        return 440.0 * std::pow(2.0, (noteNumber - 69) / 12.0);
+        return PitchTable::noteToFrequency(noteNumber);
     }
     
     void updateGlideCoeff() {
@@ -481,16 +1127,18 @@ private:
         } else {
             mGlideCoeff = 1.0;  // Instant (no glide)
         }
+        mTickGlideSamples = 0;
     }
     
     double mSampleRate;
     
     // Components
-    PulsarOscillator mPulsarOsc;
-    FormantFilter mFormantFilter;
-    ADSREnvelope mAmpEnvelope;
-    ADSREnvelope mModEnvelope;  // Mod envelope (Phase 2.2)
-    LFO mLFO;
+    OscillatorType mPulsarOsc;
+    FilterType mFormantFilter;
+    AirType mAirFilter;
+    EnvelopeType mAmpEnvelope;
+    EnvelopeType mModEnvelope;  // Mod envelope (Phase 2.2)
+    LFOType mLFO;
     
     // Parameters
     VoxVoiceParameters mParams;
@@ -505,9 +1153,44 @@ private:
     double mRawVelocity = 1.0;  // Phase 2.4: Raw velocity for mod env scaling
     bool mNoteOn;
     int mVoiceIndex;
-    double mCurrentLFOValue = 0.0;
-    double mCurrentModEnvValue = 0.0;  // Phase 2.2
+    SampleType mCurrentLFOValue = 0;
+    SampleType mCurrentModEnvValue = 0;  // Phase 2.2
+    const SampleType* mSharedLFOValues = nullptr;
+    int mSharedLFOIndex = 0;
+    
+    // Global modulation block (VoicePool) and the next sample to read
+    const GlobalModulationBlock* mGlobalModulation = nullptr;
+    int mGlobalModulationIndex = 0;
+    
+    // Control-rate block render (modControlRate > 1)
+    ControlRamp mFrequencyRamp;      // Hz
+    ControlRamp mDutyRamp;
+    int mTickGlideSamples = 0;       // tick length mTickGlideCoeff was computed for
+    double mTickGlideCoeff = 1.0;
+    
+    // Per-voice drift and chaos offsets (VoicePool)
+    ControlRamp mVoicePitchRamp;     // semitones
+    ControlRamp mVoiceFormantRamp;   // Hz
+    bool mVoiceModulated = false;
+    
+    // Fused output stage (scratch buffers for block renders)
+    SampleType mOutputGain = SampleType(1);
+    std::array<SampleType, kRenderChunk> mWetBuffer{};
+    std::array<SampleType, kRenderChunk> mDryBuffer{};
+    std::array<SampleType, kRenderChunk> mEnvBuffer{};
+    std::array<SampleType, kRenderChunk> mModEnvBuffer{};
+    
+    // Stereo render: per-sample grain pan, mono scratch, cached pan gains
+    double mGrainPan = 0.0;          // current grain's pan scatter
+    std::array<double, kRenderChunk> mGrainPanBuffer{};
+    std::array<SampleType, kRenderChunk> mMonoBuffer{};
+    std::array<SampleType, kRenderChunk> mLFOBuffer{};      // Offset shared LFO span
+    double mGainPan = 2.0;           // pan position of mLeftGain/mRightGain (2: none yet)
+    SampleType mLeftGain = SampleType(0);
+    SampleType mRightGain = SampleType(0);
     double mAftertouch = 0.0;          // Phase 2.5
+    double mNotePitchBend = 0.0;       // semitones, per-note expression
+    double mTimbre = 0.0;              // -1 to +1, per-note expression
     
     // Phase 3: Constellation offsets
     double mDetuneOffset = 0.0;      // cents
@@ -519,4 +1202,7 @@ private:
     double mLFOPhaseOffset = 0.0;    // 0 to 1
 };
 
+using VoxVoice = VoxVoiceT<double>;
+using VoxVoiceFloat = VoxVoiceT<float>;
+
 #endif // __cplusplus
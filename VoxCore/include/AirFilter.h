@@ -0,0 +1,3 @@
+// Forward to DSP implementation
+#pragma once
+#include "DSP/Filters/AirFilter.h"
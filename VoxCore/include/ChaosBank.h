@@ -0,0 +1,3 @@
+// Forward to DSP implementation
+#pragma once
+#include "DSP/Modulators/ChaosBank.h"
@@ -21,8 +21,12 @@
 // Vowel shaping filter with dual F1/F2 resonances
 #include "FormantFilter.h"
 
+// "Air" one-pole brightness control after the formants
+#include "AirFilter.h"
+
 // Amplitude envelope
 #include "ADSREnvelope.h"
+#include "EnvelopeBank.h"
 
 // Complete pulsar synthesis voice
 #include "VoxVoice.h"
@@ -30,6 +34,7 @@
 // Polyphonic voice management
 #include "VoiceAllocator.h"
 #include "VoicePool.h"
+#include "ExpressionRouter.h"
 
 // ═══════════════════════════════════════════════════════════════════════════
 // SUPPORTING COMPONENTS
@@ -48,6 +53,8 @@
 #include "GlobalLFO.h"
 #include "DriftGenerator.h"
 #include "ChaosGenerator.h"
+#include "DriftBank.h"
+#include "ChaosBank.h"
 #include "FormantSequencer.h"
 #include "GlobalModulation.h"
 
@@ -60,6 +67,10 @@
 
 // Utility functions
 #include "DSPUtilities.h"
+#include "ControlRate.h"
+#include "PitchTable.h"
+#include "RenderWorkers.h"
+#include "ParameterSlots.h"
 
 // ═══════════════════════════════════════════════════════════════════════════
 // LEGACY STUBS (for build compatibility only - not used in Vox)
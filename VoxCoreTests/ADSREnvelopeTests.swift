@@ -259,6 +259,114 @@ struct ADSREnvelopeTests {
         }
     }
     
+    @Test func envelopeBlockMatchesPerSample() async throws {
+        // Segment-at-a-time block rendering must reproduce process() exactly,
+        // including transitions that land inside a block
+        func makeEnvelope() -> ADSREnvelope {
+            var envelope = ADSREnvelope(48000.0)
+            envelope.setAttackTime(0.01)
+            envelope.setDecayTime(0.03)
+            envelope.setSustainLevel(0.4)
+            envelope.setReleaseTime(0.02)
+            return envelope
+        }
+        var reference = makeEnvelope()
+        var block = makeEnvelope()
+        
+        let blockSizes = [1, 7, 64, 333, 512, 1024]
+        var expected: [Double] = []
+        var rendered: [Double] = []
+        for (index, size) in (blockSizes + blockSizes + blockSizes + blockSizes).enumerated() {
+            if index == 0 {
+                reference.noteOn()
+                block.noteOn()
+            } else if index == 14 {
+                reference.noteOff()
+                block.noteOff()
+            }
+            for _ in 0..<size {
+                expected.append(reference.process())
+            }
+            var output = [Double](repeating: 0.0, count: size)
+            block.processBlock(&output, Int32(size))
+            rendered.append(contentsOf: output)
+            #expect(block.getState() == reference.getState())
+        }
+        
+        #expect(rendered == expected)
+        
+        // Release finishes inside the final blocks
+        #expect(block.getState() == .IDLE)
+    }
+    
+    @Test func envelopeBankMatchesEnvelopes() async throws {
+        // Lanes in different segments, gathered into the bank each block
+        func makeEnvelope(_ index: Int) -> ADSREnvelope {
+            var envelope = ADSREnvelope(48000.0)
+            envelope.setAttackTime(0.002 + 0.003 * Double(index))
+            envelope.setDecayTime(0.01 + 0.005 * Double(index))
+            envelope.setSustainLevel(0.1 * Double(index))
+            envelope.setReleaseTime(0.005 + 0.004 * Double(index))
+            envelope.noteOn()
+            return envelope
+        }
+        let laneCount = 8
+        var reference = (0..<laneCount).map(makeEnvelope)
+        var banked = reference
+        var bank = EnvelopeBank()
+        
+        for blockIndex in 0..<60 {
+            if blockIndex == 20 {
+                for lane in stride(from: 0, to: laneCount, by: 2) {
+                    reference[lane].noteOff()
+                    banked[lane].noteOff()
+                }
+            }
+            let count = 1 + (blockIndex * 37) % 64
+            bank.clear()
+            for lane in 0..<laneCount {
+                _ = bank.addLane(banked[lane], -1)
+            }
+            bank.process(Int32(count))
+            for lane in 0..<laneCount {
+                bank.store(Int32(lane), &banked[lane])
+                var expected = [Double](repeating: 0.0, count: count)
+                let active = Int(reference[lane].processBlockWhileActive(&expected, Int32(count)))
+                #expect(Int(bank.getActiveSamples(Int32(lane))) == active)
+                for i in 0..<active {
+                    #expect(bank.getOutput(Int32(lane), Int32(i)) == expected[i])
+                }
+                #expect(banked[lane].getState() == reference[lane].getState())
+            }
+        }
+        
+        // Released lanes finished; held lanes sit in sustain
+        #expect(banked[0].getState() == .IDLE)
+        #expect(banked[1].getState() == .SUSTAIN)
+    }
+    
+    @Test func envelopeSamplesUntilSilentMatchesRender() async throws {
+        var envelope = ADSREnvelope(48000.0)
+        envelope.setAttackTime(0.02)
+        envelope.setReleaseTime(0.4)
+        
+        envelope.noteOn()
+        for _ in 0..<2000 { _ = envelope.process() }
+        #expect(envelope.getSamplesUntilSilent(0.001) == ADSREnvelope.kNeverSilent, "Held notes never fall silent")
+        
+        envelope.noteOff()
+        for _ in 0..<100 { _ = envelope.process() }
+        let predicted = Int(envelope.getSamplesUntilSilent(0.001))
+        
+        // Render until the output stays below the threshold
+        var lastLoud = 0
+        for n in 1...100_000 {
+            if envelope.process() >= 0.001 { lastLoud = n }
+        }
+        #expect(Swift.abs(predicted - (lastLoud + 1)) <= 1, "Prediction should match the rendered tail")
+        #expect(envelope.getSamplesUntilSilent(0.001) == 0, "Idle envelope is already silent")
+    }
+    
     @Test func envelopeParameterValidation() async throws {
         // Test parameter clamping
         var envelope = ADSREnvelope(44100.0)
@@ -0,0 +1,70 @@
+//
+//  AirFilterTests.swift
+//  VoxCoreTests
+//
+//  Tests for the Air one-pole lowpass (brightness control)
+//
+
+import Testing
+@testable import VoxCore
+
+@Suite("Air Filter Tests")
+struct AirFilterTests {
+    let sampleRate = 44100.0
+    
+    @Test("Air defaults to zero and bypasses")
+    func testDefaultBypass() {
+        var filter = AirFilter(sampleRate)
+        #expect(filter.getAir() == 0.0, "Default Air should be 0")
+        #expect(filter.isBypassed(), "Air = 0 should bypass")
+        
+        for x in [0.5, -0.25, 1.0, 0.0] {
+            #expect(filter.process(x) == x, "Bypassed filter should pass input unchanged")
+        }
+    }
+    
+    @Test("Air maps to the documented cutoff and clamps")
+    func testCutoffMapping() {
+        var filter = AirFilter(sampleRate)
+        filter.setAir(0.5)
+        #expect(Swift.abs(filter.getCutoffFrequency() - 11000.0) < 1e-9, "Air 0.5 -> 11 kHz")
+        filter.setAir(1.0)
+        #expect(Swift.abs(filter.getCutoffFrequency() - 2000.0) < 1e-9, "Air 1.0 -> 2 kHz, never fully closed")
+        filter.setAir(2.0)
+        #expect(filter.getAir() == 1.0, "Air should clamp to 1")
+        filter.setAir(-1.0)
+        #expect(filter.getAir() == 0.0, "Air should clamp to 0")
+    }
+    
+    @Test("Air attenuates high frequencies but passes DC")
+    func testLowpassResponse() {
+        var filter = AirFilter(sampleRate)
+        filter.setAir(1.0)
+        
+        // Nyquist-rate alternating signal should be strongly attenuated
+        var peak = 0.0
+        for i in 0..<1000 {
+            let y = filter.process(i % 2 == 0 ? 1.0 : -1.0)
+            if i > 500 { peak = Swift.max(peak, Swift.abs(y)) }
+        }
+        #expect(peak < 0.2, "Full Air should attenuate Nyquist content")
+        
+        filter.reset()
+        var y = 0.0
+        for _ in 0..<1000 { y = filter.process(1.0) }
+        #expect(Swift.abs(y - 1.0) < 1e-6, "DC should pass at unity gain")
+    }
+    
+    @Test("Block processing matches per-sample processing")
+    func testBlockMatchesProcess() {
+        var a = AirFilter(sampleRate)
+        var b = AirFilter(sampleRate)
+        a.setAir(0.7)
+        b.setAir(0.7)
+        
+        var block = (0..<256).map { Double(($0 * 37) % 17) / 8.0 - 1.0 }
+        let expected = block.map { a.process($0) }
+        b.processBlock(&block, Int32(block.count))
+        #expect(block == expected, "processBlock should match process()")
+    }
+}
@@ -0,0 +1,108 @@
+//
+//  FloatRenderPathTests.swift
+//  VoxCoreTests
+//
+//  Tests for the single-precision render path (VoxVoiceFloat / VoicePoolFloat)
+//  against the double-precision reference engine
+//
+
+import Testing
+@testable import VoxCore
+
+@Suite("Float Render Path Tests")
+struct FloatRenderPathTests {
+    let sampleRate = 48000.0
+
+    // Parameters that exercise every stage of the voice chain
+    func modulatedParameters() -> VoxVoiceParameters {
+        var params = VoxVoiceParameters()
+        params.useVowelMorph = false
+        params.lfoRate = 5.0
+        params.lfoToPitch = 0.3
+        params.lfoToDutyCycle = 0.1
+        params.modEnvToFormant1 = 200.0
+        return params
+    }
+
+    @Test("Float voice tracks the double reference voice")
+    func testVoiceError() {
+        var reference = VoxVoice(sampleRate)
+        var single = VoxVoiceFloat(sampleRate)
+        reference.setParameters(modulatedParameters())
+        single.setParameters(modulatedParameters())
+
+        reference.noteOn(60, 0.8)
+        single.noteOn(60, 0.8)
+
+        var maxError = 0.0
+        var signalEnergy = 0.0
+        var errorEnergy = 0.0
+        for i in 0..<Int(sampleRate) {
+            if i == Int(sampleRate / 2) {
+                reference.noteOff(60)
+                single.noteOff(60)
+            }
+            let r = reference.process()
+            let f = Double(single.process())
+            let e = f - r
+            maxError = Swift.max(maxError, Swift.abs(e))
+            signalEnergy += r * r
+            errorEnergy += e * e
+        }
+
+        let snr = 10.0 * log10(signalEnergy / Swift.max(errorEnergy, 1e-30))
+        print("Float voice error report: max |e| = \(maxError), SNR = \(snr) dB")
+        #expect(maxError < 1e-3, "Float voice should stay within -60 dB of the reference")
+        #expect(snr > 80.0, "Float voice error should be well below audibility")
+    }
+
+    @Test("Float pool tracks the double reference pool")
+    func testPoolError() {
+        var reference = VoicePool(8, sampleRate)
+        var single = VoicePoolFloat(8, sampleRate)
+        reference.setParameters(modulatedParameters())
+        single.setParameters(modulatedParameters())
+
+        for note: Int32 in [60, 64, 67, 71] {
+            _ = reference.noteOn(note, 0.9)
+            _ = single.noteOn(note, 0.9)
+        }
+
+        var maxError = 0.0
+        for _ in 0..<Int(sampleRate / 2) {
+            let e = Double(single.process()) - reference.process()
+            maxError = Swift.max(maxError, Swift.abs(e))
+        }
+
+        print("Float pool error report: max |e| = \(maxError)")
+        #expect(maxError < 2e-3, "Float pool should track the reference pool")
+    }
+
+    @Test("Float components match their double counterparts")
+    func testComponentError() {
+        var envD = ADSREnvelope(sampleRate)
+        var envF = ADSREnvelopeFloat(sampleRate)
+        envD.noteOn()
+        envF.noteOn()
+
+        var filterD = FormantFilter(sampleRate)
+        var filterF = FormantFilterFloat(sampleRate)
+
+        var oscD = PulsarOscillator(sampleRate)
+        var oscF = PulsarOscillatorFloat(sampleRate)
+        oscD.setFrequency(220.0)
+        oscF.setFrequency(220.0)
+
+        var envError = 0.0
+        var filterError = 0.0
+        for _ in 0..<4800 {
+            envError = Swift.max(envError, Swift.abs(Double(envF.process()) - envD.process()))
+            let d = filterD.process(oscD.process())
+            let f = Double(filterF.process(oscF.process()))
+            filterError = Swift.max(filterError, Swift.abs(f - d))
+        }
+
+        #expect(envError < 1e-5, "Float envelope should match double envelope")
+        #expect(filterError < 1e-3, "Float oscillator + filter should match double path")
+    }
+}
@@ -209,4 +209,151 @@ struct FormantFilterTests {
         let outputAfterReset = filter.process(0.0)
         #expect(Swift.abs(outputAfterReset) < 0.01, "Filter should be cleared after reset")
     }
+    
+    // MARK: - Batched Coefficient Update Tests
+    
+    @Test("Setters defer coefficient updates until the next process call")
+    func testLazyCoefficientUpdate() {
+        var filter = FormantFilter(sampleRate)
+        #expect(!filter.needsCoefficientUpdate(), "Fresh filter should have valid coefficients")
+        
+        filter.setFormant1Frequency(500.0)
+        filter.setFormant2Frequency(1500.0)
+        filter.setFormant1Q(12.0)
+        filter.setFormant2Q(8.0)
+        #expect(filter.needsCoefficientUpdate(), "Setters should only mark coefficients dirty")
+        
+        _ = filter.process(0.0)
+        #expect(!filter.needsCoefficientUpdate(), "process() should recompute coefficients once")
+        
+        // Re-setting identical values should not dirty the coefficients
+        filter.setFormant1Frequency(500.0)
+        filter.setFormant2Q(8.0)
+        #expect(!filter.needsCoefficientUpdate(), "Unchanged values should not trigger an update")
+    }
+    
+    @Test("Batched setter calls produce the same output as a freshly configured filter")
+    func testBatchedUpdateMatchesFreshFilter() {
+        var batched = FormantFilter(sampleRate)
+        batched.setFormant1Frequency(300.0)
+        batched.setFormant1Q(20.0)
+        batched.setFormant2Frequency(2700.0)
+        batched.setFormant2Q(15.0)
+        
+        var fresh = FormantFilter(sampleRate)
+        fresh.setFormant1Frequency(300.0)
+        _ = fresh.process(0.0)
+        fresh.setFormant1Q(20.0)
+        _ = fresh.process(0.0)
+        fresh.setFormant2Frequency(2700.0)
+        fresh.setFormant2Q(15.0)
+        fresh.reset()
+        
+        _ = batched.process(0.0)
+        batched.reset()
+        
+        var block = [Double](repeating: 0.0, count: 256)
+        block[0] = 1.0
+        var reference: [Double] = []
+        for sample in block {
+            reference.append(fresh.process(sample))
+        }
+        
+        batched.processBlock(&block, Int32(block.count))
+        
+        for i in 0..<block.count {
+            #expect(Swift.abs(block[i] - reference[i]) < 1e-12, "Block output should match per-sample output")
+        }
+    }
+    
+    // MARK: - Vowel Space Tests
+    
+    @Test("Vowel morph end stops at U instead of wrapping toward A")
+    func testVowelMorphNoWrap() {
+        var filter = FormantFilter(sampleRate)
+        filter.setVowelMorph(0.99)
+        #expect(filter.getFormant1Frequency() < 400.0, "Near U, F1 should stay between O and U")
+        #expect(filter.getFormant2Frequency() < 800.0, "Near U, F2 should stay between O and U")
+    }
+    
+    @Test("Vowel space corners and edges hit the vowel table")
+    func testVowelSpaceAnchors() {
+        var filter = FormantFilter(sampleRate)
+        
+        // (x, y) -> (F1, F2)
+        let anchors: [(Double, Double, Double, Double)] = [
+            (0.5, 1.0, 800.0, 1200.0),  // A
+            (0.0, 0.5, 400.0, 2200.0),  // E
+            (0.0, 0.0, 300.0, 2700.0),  // I
+            (1.0, 0.5, 500.0, 800.0),   // O
+            (1.0, 0.0, 350.0, 700.0)    // U
+        ]
+        for (x, y, f1, f2) in anchors {
+            filter.setVowelPosition(x, y)
+            #expect(filter.isUsingVowelSpace(), "Setting a position should enable the vowel space")
+            #expect(Swift.abs(filter.getFormant1Frequency() - f1) < 1e-9, "F1 should match the vowel table")
+            #expect(Swift.abs(filter.getFormant2Frequency() - f2) < 1e-9, "F2 should match the vowel table")
+        }
+        
+        filter.setFormant1Frequency(1000.0)
+        #expect(!filter.isUsingVowelSpace(), "Manual frequencies should leave the vowel space")
+    }
+    
+    @Test("Coefficient grid matches directly computed coefficients")
+    func testVowelSpaceGridAccuracy() {
+        var worst = 0.0
+        for (x, y) in [(0.13, 0.77), (0.5, 0.5), (0.91, 0.07), (0.33, 0.29)] {
+            var grid = FormantFilter(sampleRate)
+            grid.setVowelPosition(x, y)
+            
+            var direct = FormantFilter(sampleRate)
+            direct.setFormant1Frequency(grid.getFormant1Frequency())
+            direct.setFormant2Frequency(grid.getFormant2Frequency())
+            
+            for i in 0..<2048 {
+                let input = i == 0 ? 1.0 : 0.0
+                worst = Swift.max(worst, Swift.abs(grid.process(input) - direct.process(input)))
+            }
+        }
+        #expect(worst < 1e-3, "Bilinear grid lookup should track the exact SVF response")
+    }
+    
+    @Test("Vowel space follows a sample rate change")
+    func testVowelSpaceSampleRateChange() {
+        var changed = FormantFilter(sampleRate)
+        changed.setSampleRate(96000.0)
+        var fresh = FormantFilter(96000.0)
+        changed.setVowelPosition(0.3, 0.6)
+        fresh.setVowelPosition(0.3, 0.6)
+
+        var worst = 0.0
+        for i in 0..<2048 {
+            let input = i == 0 ? 1.0 : 0.0
+            worst = Swift.max(worst, Swift.abs(changed.process(input) - fresh.process(input)))
+        }
+        #expect(worst == 0.0, "Filters at the same rate should read the same shared grid")
+    }
+
+    @Test("Voice LFO sweeps the vowel space")
+    func testVoiceVowelSpaceModulation() {
+        var params = VoxVoiceParameters()
+        params.useVowelSpace = true
+        params.vowelX = 0.5
+        params.vowelY = 0.5
+        
+        var still = VoxVoice(sampleRate)
+        still.setParameters(params)
+        params.lfoRate = 4.0
+        params.lfoToVowelX = 0.5
+        var swept = VoxVoice(sampleRate)
+        swept.setParameters(params)
+        
+        still.noteOn(60, 1.0)
+        swept.noteOn(60, 1.0)
+        var maxDiff = 0.0
+        for _ in 0..<Int(sampleRate / 4) {
+            maxDiff = Swift.max(maxDiff, Swift.abs(still.process() - swept.process()))
+        }
+        #expect(maxDiff > 0.01, "LFO to vowel X should change the voice timbre")
+    }
 }
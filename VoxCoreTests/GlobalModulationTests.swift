@@ -237,6 +237,117 @@ struct DriftGeneratorTests {
         let value = drift.getCurrentValue()
         #expect(Swift.abs(value) < 0.1, "Should be near 0 after reset")
     }
+    
+    @Test("DriftGenerator control-rate mode tracks audio rate")
+    func testControlRate() {
+        var audio = DriftGenerator(sampleRate)
+        audio.setRate(0.1)
+        audio.setMode(DriftGenerator.Mode.Tide)
+        
+        var control = DriftGenerator(sampleRate)
+        control.setRate(0.1)
+        control.setMode(DriftGenerator.Mode.Tide)
+        control.setControlRate(64)
+        #expect(control.getControlRate() == 64)
+        
+        var maxError = 0.0
+        for _ in 0..<Int(sampleRate * 15) {
+            maxError = max(maxError, Swift.abs(audio.process() - control.process()))
+        }
+        #expect(maxError < 0.001, "64-sample ticks should barely change a 0.1 Hz tide, error \(maxError)")
+    }
+    
+    @Test("DriftGenerator Entropy halves its distance to the target every half-life")
+    func testEntropyHalfLife() {
+        for samplesPerTick: Int32 in [1, 32] {
+            var drift = DriftGenerator(sampleRate)
+            drift.setMode(DriftGenerator.Mode.Entropy)
+            drift.setEntropyHalfLife(0.5)
+            drift.setEntropyTarget(-0.5)
+            drift.setControlRate(samplesPerTick)
+            drift.reset()
+            #expect(drift.getRawValue() == DriftGenerator.kEntropyStart)
+            
+            for _ in 0..<Int(sampleRate * 0.5) { _ = drift.process() }
+            let oneHalfLife = drift.getRawValue()
+            for _ in 0..<Int(sampleRate * 0.5) { _ = drift.process() }
+            let twoHalfLives = drift.getRawValue()
+            
+            // 1.0 -> -0.5: distance 1.5, then 0.75, then 0.375
+            #expect(Swift.abs(oneHalfLife - 0.25) < 0.001, "\(samplesPerTick)-sample ticks: \(oneHalfLife)")
+            #expect(Swift.abs(twoHalfLives + 0.125) < 0.001, "\(samplesPerTick)-sample ticks: \(twoHalfLives)")
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Per-Voice Drift and Chaos Banks
+// ═══════════════════════════════════════════════════════════════════════════
+
+@Suite("Drift and Chaos Bank Tests")
+struct ModulatorBankTests {
+    let sampleRate = 44100.0
+    let tick: Int32 = 32
+    
+    @Test("DriftBank lanes wander independently and stay bounded")
+    func testDriftBankLanes() {
+        for mode in [DriftGenerator.Mode.RandomWalk, .Breath, .Tide] {
+            var bank = DriftBank(sampleRate)
+            bank.setMode(mode)
+            bank.setRate(0.1)
+            
+            var maxSpread = 0.0
+            for _ in 0..<(Int(sampleRate) * 30 / Int(tick)) {
+                bank.process(tick)
+                var low = 1.0
+                var high = -1.0
+                for lane: Int32 in 0..<16 {
+                    let value = bank.getValue(lane)
+                    #expect(value >= -1.0 && value <= 1.0, "\(mode) lane \(lane) out of range: \(value)")
+                    low = min(low, value)
+                    high = max(high, value)
+                }
+                maxSpread = max(maxSpread, high - low)
+            }
+            #expect(maxSpread > 0.1, "\(mode) lanes should not move in lockstep, spread \(maxSpread)")
+        }
+    }
+    
+    @Test("DriftBank Entropy lanes restart on retrigger and decay to zero")
+    func testDriftBankEntropy() {
+        var bank = DriftBank(sampleRate)
+        bank.setMode(DriftGenerator.Mode.Entropy)
+        bank.setEntropyHalfLife(0.5)
+        bank.retrigger(0)
+        bank.retrigger(1)
+        let start0 = bank.getValue(0)
+        let start1 = bank.getValue(1)
+        #expect(start0 != start1, "Each lane draws its own offset")
+        #expect(bank.getValue(2) == 0.0, "Lanes that were not retriggered stay put")
+        
+        // One half-life, to within a tick
+        for _ in 0..<(Int(sampleRate) / 2 / Int(tick)) { bank.process(tick) }
+        #expect(Swift.abs(bank.getValue(0) / start0 - 0.5) < 0.001)
+        #expect(Swift.abs(bank.getValue(1) / start1 - 0.5) < 0.001)
+    }
+    
+    @Test("ChaosBank lanes stay finite, bounded and distinct")
+    func testChaosBankLanes() {
+        for type in [ChaosGenerator.ChaosType.Lorenz, .Henon, .Rossler] {
+            var bank = ChaosBank(sampleRate)
+            bank.setType(type)
+            bank.setRate(10.0)
+            
+            for _ in 0..<(Int(sampleRate) * 10 / Int(tick)) {
+                bank.process(tick)
+                for lane: Int32 in 0..<16 {
+                    let value = bank.getValue(lane)
+                    #expect(value.isFinite && value >= -1.0 && value <= 1.0, "\(type) lane \(lane): \(value)")
+                }
+            }
+            #expect(bank.getValue(0) != bank.getValue(1), "\(type) lanes should follow their own orbits")
+        }
+    }
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -283,7 +394,7 @@ struct ChaosGeneratorTests {
     
     @Test("ChaosGenerator output stays in valid range")
     func testOutputRange() {
-        for type in [ChaosGenerator.ChaosType.Lorenz, ChaosGenerator.ChaosType.Henon] {
+        for type in [ChaosGenerator.ChaosType.Lorenz, .Henon, .Rossler] {
             var chaos = ChaosGenerator(sampleRate)
             chaos.setType(type)
             chaos.setAmount(1.0)
@@ -297,6 +408,55 @@ struct ChaosGeneratorTests {
         }
     }
     
+    @Test("ChaosGenerator Rossler never produces NaN or Inf")
+    func testRosslerStability() {
+        var chaos = ChaosGenerator(sampleRate)
+        chaos.setType(ChaosGenerator.ChaosType.Rossler)
+        chaos.setRate(10.0)
+        
+        var minVal = Double.infinity
+        var maxVal = -Double.infinity
+        for _ in 0..<Int(sampleRate * 30) {
+            let value = chaos.process()
+            #expect(value.isFinite, "Rossler output must be finite")
+            minVal = min(minVal, value)
+            maxVal = max(maxVal, value)
+        }
+        #expect(chaos.isStateValid())
+        #expect(maxVal - minVal > 0.5, "Rossler should orbit, got range \(maxVal - minVal)")
+    }
+    
+    @Test("ChaosGenerator control-rate mode stays bounded and tracks audio rate")
+    func testControlRate() {
+        for type in [ChaosGenerator.ChaosType.Lorenz, .Henon, .Rossler] {
+            for rate in [1.0, 10.0] {
+                var audioRate = ChaosGenerator(sampleRate)
+                audioRate.setType(type)
+                audioRate.setRate(rate)
+                var controlRate = audioRate
+                controlRate.setControlRate(64)
+                #expect(controlRate.getControlRate() == 64)
+                
+                // Same starting state: the interpolated output follows the
+                // audio-rate trajectory one tick late, so compare ranges
+                var audioMin = Double.infinity, audioMax = -Double.infinity
+                var controlMin = Double.infinity, controlMax = -Double.infinity
+                for _ in 0..<Int(sampleRate * 10) {
+                    let a = audioRate.process()
+                    let c = controlRate.process()
+                    #expect(c.isFinite && c >= -1.0 && c <= 1.0, "\(type) control-rate output out of range: \(c)")
+                    audioMin = min(audioMin, a)
+                    audioMax = max(audioMax, a)
+                    controlMin = min(controlMin, c)
+                    controlMax = max(controlMax, c)
+                }
+                #expect(controlRate.isStateValid())
+                #expect(Swift.abs((controlMax - controlMin) - (audioMax - audioMin)) < 0.1,
+                        "\(type) at rate \(rate) should cover the same range at control rate")
+            }
+        }
+    }
+    
     @Test("ChaosGenerator Lorenz produces chaotic variation")
     func testLorenzChaos() {
         var chaos = ChaosGenerator(sampleRate)
@@ -570,6 +730,43 @@ struct FormantSequencerTests {
         #expect(seq.getTempo() == 120.0)
     }
     
+    @Test("FormantSequencer follows the host beat position")
+    func testSyncToBeatPosition() {
+        var seq = FormantSequencer(sampleRate)
+        seq.setSyncMode(FormantSequencer.SyncMode.TempoSync)
+        seq.setTempo(120.0)
+        seq.setBeatDivision(FormantSequencer.BeatDivision.Quarter)
+        
+        // Beat 5 is the start of step 5 with quarter-note steps
+        seq.syncToBeatPosition(5.0)
+        _ = seq.process()
+        #expect(seq.getCurrentStep() == 5)
+        #expect(seq.getStepPhase() < 1e-9)
+        
+        // Resyncing every block to the host grid matches a sequencer that
+        // simply ran from beat 0
+        func makeSequencer() -> FormantSequencer {
+            var sequencer = FormantSequencer(sampleRate)
+            sequencer.setSyncMode(FormantSequencer.SyncMode.TempoSync)
+            sequencer.setTempo(133.0)
+            sequencer.setBeatDivision(FormantSequencer.BeatDivision.Sixteenth)
+            sequencer.setGlide(30.0)
+            sequencer.syncToBeatPosition(0.0)
+            return sequencer
+        }
+        var free = makeSequencer()
+        var synced = makeSequencer()
+        let blockSize = 256
+        var maxDiff = 0.0
+        for block in 0..<500 {
+            synced.syncToBeatPosition(Double(block * blockSize) * 133.0 / 60.0 / sampleRate)
+            for _ in 0..<blockSize {
+                maxDiff = max(maxDiff, Swift.abs(free.process() - synced.process()))
+            }
+        }
+        #expect(maxDiff < 1e-9, "Beat-synced sequencer should not drift, diff \(maxDiff)")
+    }
+    
     @Test("FormantSequencer can be stopped and started")
     func testTransportControl() {
         var seq = FormantSequencer(sampleRate)
@@ -616,6 +813,26 @@ struct FormantSequencerTests {
         seq.setGlideCurve(FormantSequencer.GlideCurve.Exponential)
         #expect(seq.getGlideCurve() == FormantSequencer.GlideCurve.Exponential)
     }
+    
+    @Test("FormantSequencer control-rate mode ramps step changes")
+    func testControlRate() {
+        var seq = FormantSequencer(sampleRate)
+        seq.setRate(10.0)
+        seq.setControlRate(32)
+        
+        var maxJump = 0.0
+        var previous = seq.process()
+        for _ in 0..<Int(sampleRate) {
+            let value = seq.process()
+            maxJump = max(maxJump, Swift.abs(value - previous))
+            #expect(value >= 0.0 && value <= 1.0, "Ramped output should stay in range")
+            previous = value
+        }
+        
+        // Steps are 0.25 apart; a 32-sample ramp moves at most 0.25 / 32 per sample
+        #expect(maxJump <= 0.25 / 32.0 + 1e-12, "Step changes should be ramped, max jump \(maxJump)")
+        #expect(seq.getCurrentStep() > 0, "Sequencer should still advance")
+    }
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -673,5 +890,58 @@ struct GlobalModulationIntegrationTests {
         var globalMod = GlobalModulation(sampleRate)
         globalMod.setTempo(140.0)
         #expect(true, "Tempo set without crash")
+        
+        globalMod.syncToBeatPosition(17.5)
+        let values = globalMod.process()
+        #expect(values.totalPitchMod.isFinite, "Beat sync should leave modulation valid")
+    }
+    
+    @Test("GlobalModulation control rate can be set")
+    func testControlRate() {
+        var globalMod = GlobalModulation(sampleRate)
+        globalMod.setControlRate(16)
+        #expect(globalMod.getControlRate() == 16)
+        
+        for _ in 0..<Int(sampleRate) {
+            let values = globalMod.process()
+            #expect(values.totalPitchMod.isFinite)
+        }
+        
+        // Out-of-range settings clamp to audio rate ... 64 samples
+        globalMod.setControlRate(0)
+        #expect(globalMod.getControlRate() == 1)
+        globalMod.setControlRate(1000)
+        #expect(globalMod.getControlRate() == 64)
+    }
+    
+    @Test("GlobalModulation processBlock matches per-sample process")
+    func testProcessBlock() {
+        var amounts = GlobalModulationAmounts()
+        amounts.lfo1ToPitch = 2.0
+        amounts.lfo2ToFormant1 = 100.0
+        amounts.driftToPan = 0.5
+        amounts.chaosToDutyCycle = 0.1
+        
+        var perSample = GlobalModulation(sampleRate)
+        perSample.setRoutingAmounts(amounts)
+        perSample.setControlRate(16)
+        var block = perSample  // Same source state, including the chaos seed
+        
+        let destinations: [ModDestination] = [.Pitch, .Formant1, .Formant2, .VowelMorph, .DutyCycle, .Pan]
+        var maxDiff = 0.0
+        for blockIndex in 0..<500 {
+            let count = (blockIndex % 7) * 9 + 1  // 1 ... 55 samples
+            block.processBlock(Int32(count))
+            #expect(block.getBlockCount() == Int32(count))
+            for i in 0..<count {
+                _ = perSample.process()
+                for dest in destinations {
+                    let diff = perSample.getModulationFor(dest) - block.getBlockValue(dest, Int32(i))
+                    maxDiff = max(maxDiff, Swift.abs(diff))
+                }
+            }
+            maxDiff = max(maxDiff, Swift.abs(perSample.getValues().totalPitchMod - block.getValues().totalPitchMod))
+        }
+        #expect(maxDiff == 0.0, "Block buffers should hold exactly the per-sample values, diff \(maxDiff)")
     }
 }
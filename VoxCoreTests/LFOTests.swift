@@ -1,4 +1,5 @@
 import Testing
+import Foundation
 import VoxCore
 
 @Suite("LFO Tests")
@@ -175,6 +176,40 @@ struct LFOTests {
         #expect(zeroCrossings >= 1 && zeroCrossings <= 3, "Expected ~2 zero crossings at 120 BPM quarter notes, got \(zeroCrossings)")
     }
     
+    @Test("Dotted and triplet divisions use their true lengths")
+    func testBeatDivisionLengths() {
+        #expect(LFO.beatsPerCycle(LFO.BeatDivision.DOTTED_HALF) == 3.0)
+        #expect(LFO.beatsPerCycle(LFO.BeatDivision.DOTTED_QUARTER) == 1.5)
+        #expect(LFO.beatsPerCycle(LFO.BeatDivision.DOTTED_EIGHTH) == 0.75)
+        #expect(LFO.beatsPerCycle(LFO.BeatDivision.SIXTEENTH_DOT) == 0.375)
+        #expect(LFO.beatsPerCycle(LFO.BeatDivision.TRIPLET_QUARTER) == 2.0 / 3.0)
+    }
+    
+    @Test("Beat position sync places a tempo-synced LFO on the host grid")
+    func testSyncToBeatPosition() {
+        var synced = LFO(sampleRate)
+        synced.setSyncMode(LFO.SyncMode.TEMPO_SYNC)
+        synced.setTempo(120.0)
+        synced.setWaveform(LFO.Waveform.SAW)
+        var reference = synced
+        
+        // Beat 6.25 at quarter-note cycles is a quarter of the way through a cycle
+        synced.syncToBeatPosition(6.25)
+        reference.setPhaseOffset(0.25)
+        reference.reset()
+        var maxDiff = 0.0
+        for _ in 0..<1000 {
+            maxDiff = max(maxDiff, Swift.abs(synced.process() - reference.process()))
+        }
+        #expect(maxDiff == 0.0, "Synced LFO should read a quarter cycle in, diff \(maxDiff)")
+        
+        // Free-running LFOs ignore the host position
+        var free = LFO(sampleRate)
+        var untouched = free
+        free.syncToBeatPosition(6.25)
+        #expect(free.process() == untouched.process())
+    }
+    
     @Test("Retrigger mode can be set")
     func testRetriggerMode() {
         var lfo = LFO(sampleRate)
@@ -283,4 +318,146 @@ struct LFOTests {
             }
         }
     }
+    
+    @Test("Phase offset is applied once after retrigger")
+    func testPhaseOffsetAfterRetrigger() {
+        var lfo = LFO(sampleRate)
+        lfo.setWaveform(LFO.Waveform.SAW)
+        lfo.setFrequency(1.0)
+        lfo.setSmoothingCutoff(20000.0)
+        lfo.setPhaseOffset(0.25)
+        lfo.retrigger()
+        
+        // Saw at phase 0.25 is -0.5 (the offset used to be added twice)
+        let value = lfo.process()
+        #expect(Swift.abs(value + 0.5) < 1e-9, "Saw should read phase 0.25 after retrigger, got \(value)")
+        
+        // Changing the offset mid-cycle shifts the running phase by the difference
+        lfo.setPhaseOffset(0.5)
+        let shifted = lfo.process()
+        #expect(Swift.abs(shifted - (value + 2.0 * 0.25 + 2.0 / sampleRate)) < 1e-9,
+                "Offset change should move the phase by 0.25, got \(shifted)")
+    }
+    
+    @Test("Polynomial sine tracks sin() closely")
+    func testSineAccuracy() {
+        var lfo = LFO(sampleRate)
+        lfo.setWaveform(LFO.Waveform.SINE)
+        lfo.setFrequency(1.0)
+        lfo.setSmoothingCutoff(20000.0)
+        
+        var maxError = 0.0
+        for i in 0..<Int(sampleRate) {
+            let expected = sin(2.0 * Double.pi * Double(i) / sampleRate)
+            maxError = max(maxError, Swift.abs(lfo.process() - expected))
+        }
+        #expect(maxError < 1e-8, "Sine error should be negligible, got \(maxError)")
+    }
+    
+    func makeBlockTestLFO(_ waveform: LFO.Waveform, _ cutoff: Double) -> LFO {
+        var lfo = LFO(sampleRate)
+        lfo.setWaveform(waveform)
+        lfo.setFrequency(37.0)
+        lfo.setPhaseOffset(0.3)
+        lfo.setSmoothingCutoff(cutoff)
+        lfo.setDelayTime(0.002)
+        lfo.setRandomSeed(7)
+        return lfo
+    }
+    
+    @Test("processBlock matches per-sample process for every waveform")
+    func testBlockMatchesProcess() {
+        let waveforms: [LFO.Waveform] = [.SINE, .TRIANGLE, .SAW, .SQUARE, .SAMPLE_AND_HOLD, .RANDOM, .NOISE]
+        let total = 4096
+        
+        for waveform in waveforms {
+            for cutoff in [20000.0, 30.0] {
+                var perSample = makeBlockTestLFO(waveform, cutoff)
+                var block = makeBlockTestLFO(waveform, cutoff)
+                
+                var expected = [Double](repeating: 0.0, count: total)
+                for i in 0..<total { expected[i] = perSample.process() }
+                
+                var rendered = [Double](repeating: 0.0, count: total)
+                var done = 0
+                var size = 1
+                while done < total {
+                    let count = min(size, total - done)
+                    var chunk = [Double](repeating: 0.0, count: count)
+                    block.processBlock(&chunk, Int32(count))
+                    rendered.replaceSubrange(done..<(done + count), with: chunk)
+                    done += count
+                    size = size * 3 % 257 + 1
+                }
+                
+                #expect(rendered == expected, "\(waveform) block render should match process (cutoff \(cutoff))")
+            }
+        }
+    }
+    
+    @Test("Control-rate LFO ramps between ticks and tracks the audio-rate LFO")
+    func testControlRate() {
+        var audio = LFO(sampleRate)
+        audio.setWaveform(LFO.Waveform.SINE)
+        audio.setFrequency(2.0)
+        audio.setSmoothingCutoff(20000.0)
+        
+        var control = LFO(sampleRate)
+        control.setWaveform(LFO.Waveform.SINE)
+        control.setFrequency(2.0)
+        control.setSmoothingCutoff(20000.0)
+        control.setControlRate(16)
+        #expect(control.getControlRate() == 16)
+        
+        var maxError = 0.0
+        var maxStepChange = 0.0
+        var previousStep = 0.0
+        var previous = 0.0
+        for i in 0..<Int(sampleRate) {
+            let reference = audio.process()
+            let value = control.process()
+            if i >= 16 {
+                maxError = max(maxError, Swift.abs(value - reference))
+            }
+            // Within a tick the output is a straight line
+            let step = value - previous
+            if i % 16 != 0 && i > 16 {
+                maxStepChange = max(maxStepChange, Swift.abs(step - previousStep))
+            }
+            previousStep = step
+            previous = value
+        }
+        
+        // One tick of lag at 2 Hz is about 2 * pi * 2 * 16 / 44100 = 0.005
+        #expect(maxError < 0.01, "Control-rate sine should track audio rate, error \(maxError)")
+        #expect(maxStepChange < 1e-12, "Output should be linear within a tick, got \(maxStepChange)")
+    }
+    
+    @Test("Control-rate processBlock matches per-sample process")
+    func testControlRateBlockMatchesProcess() {
+        let total = 4096
+        for waveform in [LFO.Waveform.SINE, .SQUARE, .SAMPLE_AND_HOLD, .NOISE] {
+            var perSample = makeBlockTestLFO(waveform, 30.0)
+            var block = makeBlockTestLFO(waveform, 30.0)
+            perSample.setControlRate(32)
+            block.setControlRate(32)
+            
+            var expected = [Double](repeating: 0.0, count: total)
+            for i in 0..<total { expected[i] = perSample.process() }
+            
+            var rendered = [Double](repeating: 0.0, count: total)
+            var done = 0
+            var size = 5
+            while done < total {
+                let count = min(size, total - done)
+                var chunk = [Double](repeating: 0.0, count: count)
+                block.processBlock(&chunk, Int32(count))
+                rendered.replaceSubrange(done..<(done + count), with: chunk)
+                done += count
+                size = size * 7 % 131 + 1
+            }
+            
+            #expect(rendered == expected, "\(waveform) control-rate block render should match process")
+        }
+    }
 }
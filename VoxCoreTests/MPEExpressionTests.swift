@@ -0,0 +1,190 @@
+//
+//  MPEExpressionTests.swift
+//  VoxCoreTests
+//
+//  Tests for MPE zones and MIDI 2.0 per-note expression routing
+//
+
+import Testing
+@testable import VoxCore
+
+@Suite("MPE Expression Tests")
+struct MPEExpressionTests {
+    let sampleRate = 44100.0
+
+    func makePool() -> VoicePool {
+        var pool = VoicePool(4, sampleRate)
+        var params = VoxVoiceParameters()
+        params.ampAttack = 0.001
+        params.ampSustain = 1.0
+        pool.setParameters(params)
+        return pool
+    }
+
+    // MARK: - Zones
+
+    @Test("Zones are off until configured")
+    func testNoZonesByDefault() {
+        let router = ExpressionRouter()
+
+        #expect(router.getLowerZoneMembers() == 0)
+        #expect(router.getUpperZoneMembers() == 0)
+        for channel in Int32(0)..<16 {
+            #expect(!router.isMemberChannel(channel))
+        }
+    }
+
+    @Test("MPE Configuration Message sets up the lower zone")
+    func testConfigurationMessage() {
+        var pool = makePool()
+        var router = ExpressionRouter()
+
+        // RPN 6 on the lower master channel with 15 member channels
+        router.controlChange(&pool, 0, 101, 0)
+        router.controlChange(&pool, 0, 100, 6)
+        router.controlChange(&pool, 0, 6, 15)
+
+        #expect(router.getLowerZoneMembers() == 15)
+        #expect(!router.isMemberChannel(0), "Master channel is not a member")
+        #expect(router.isMemberChannel(1))
+        #expect(router.isMemberChannel(15))
+
+        // Both zones share the channels between the masters
+        router.setZones(7, 7)
+        #expect(router.getMemberZone(7) == 0)
+        #expect(router.getMemberZone(8) == 1)
+        #expect(router.getMemberZone(15) == -1)
+    }
+
+    // MARK: - Channel Expression
+
+    @Test("Member channel bend reaches only its own note")
+    func testMemberChannelBend() {
+        var pool = makePool()
+        var router = ExpressionRouter()
+        router.setZones(15, 0)
+
+        let voice1 = router.noteOn(&pool, 1, 60, 1.0)
+        let voice2 = router.noteOn(&pool, 2, 64, 1.0)
+
+        router.pitchBend(&pool, 1, 0.5)
+
+        let bend1 = pool.getVoice(voice1)!.pointee.getNotePitchBend()
+        let bend2 = pool.getVoice(voice2)!.pointee.getNotePitchBend()
+        #expect(bend1 == 24.0, "Half bend over the 48 semitone member range, got \(bend1)")
+        #expect(bend2 == 0.0, "Other channel's note should not bend, got \(bend2)")
+    }
+
+    @Test("The same pitch on two member channels is two notes")
+    func testSamePitchOnTwoChannels() {
+        var pool = makePool()
+        var router = ExpressionRouter()
+        router.setZones(15, 0)
+
+        router.pitchBend(&pool, 1, 0.25)
+        router.pitchBend(&pool, 2, -0.5)
+        let voice1 = router.noteOn(&pool, 1, 60, 1.0)
+        let voice2 = router.noteOn(&pool, 2, 60, 1.0)
+
+        #expect(voice1 >= 0 && voice2 >= 0)
+        #expect(voice1 != voice2, "Second channel should not retrigger the first channel's voice")
+        #expect(pool.getVoice(voice1)!.pointee.getNotePitchBend() == 12.0)
+        #expect(pool.getVoice(voice2)!.pointee.getNotePitchBend() == -24.0)
+
+        router.pitchBend(&pool, 2, 1.0)
+        #expect(pool.getVoice(voice1)!.pointee.getNotePitchBend() == 12.0,
+                "Channel 2's bend should leave channel 1's note alone")
+        #expect(pool.getVoice(voice2)!.pointee.getNotePitchBend() == 48.0)
+
+        for _ in 0..<2000 {
+            _ = pool.process()
+        }
+
+        // Staggered note-offs: each releases only its own channel's voice
+        router.noteOff(&pool, 1, 60)
+        #expect(pool.getVoice(voice1)!.pointee.isReleasing())
+        #expect(!pool.getVoice(voice2)!.pointee.isReleasing(), "Channel 2's note should keep sounding")
+
+        for _ in 0..<Int(sampleRate) {
+            _ = pool.process()
+        }
+        #expect(pool.getActiveVoiceCount() == 1, "Only channel 2's voice should remain")
+        #expect(pool.getVoice(voice2)!.pointee.isActive())
+
+        router.noteOff(&pool, 2, 60)
+        #expect(pool.getVoice(voice2)!.pointee.isReleasing())
+    }
+
+    @Test("Expression sent before the note-on applies to the new note")
+    func testExpressionBeforeNoteOn() {
+        var pool = makePool()
+        var router = ExpressionRouter()
+        router.setZones(15, 0)
+
+        router.pitchBend(&pool, 3, -0.25)
+        router.channelPressure(&pool, 3, 0.6)
+        router.controlChange(&pool, 3, 74, 127)
+        let voice = router.noteOn(&pool, 3, 67, 1.0)
+
+        let state = pool.getVoice(voice)!.pointee
+        #expect(state.getNotePitchBend() == -12.0)
+        #expect(state.getAftertouch() == 0.6)
+        #expect(state.getTimbre() > 0.98, "CC74 127 is full timbre, got \(state.getTimbre())")
+    }
+
+    @Test("Non-member channels keep the global pitch bend")
+    func testNonMemberChannelBend() {
+        var pool = makePool()
+        var router = ExpressionRouter()
+
+        let voice = router.noteOn(&pool, 0, 60, 1.0)
+        router.pitchBend(&pool, 0, 1.0)
+        router.channelPressure(&pool, 0, 1.0)
+
+        #expect(pool.getVoice(voice)!.pointee.getNotePitchBend() == 0.0)
+        #expect(pool.getVoice(voice)!.pointee.getAftertouch() == 0.0,
+                "Channel pressure outside a zone is ignored")
+    }
+
+    // MARK: - MIDI 2.0 Per-Note Expression
+
+    @Test("Per-note pitch bend and timbre address the note directly")
+    func testPerNoteExpression() {
+        var pool = makePool()
+        var router = ExpressionRouter()
+
+        let voice1 = router.noteOn(&pool, 0, 60, 1.0)
+        let voice2 = router.noteOn(&pool, 0, 64, 1.0)
+
+        router.notePitchBend(&pool, 0, 64, -1.0)
+        router.noteTimbre(&pool, 0, 64, 0.0)
+
+        #expect(pool.getVoice(voice1)!.pointee.getNotePitchBend() == 0.0)
+        #expect(pool.getVoice(voice2)!.pointee.getNotePitchBend() == -48.0)
+        #expect(pool.getVoice(voice2)!.pointee.getTimbre() == -1.0)
+    }
+
+    @Test("Timbre moves the formants")
+    func testTimbreToFormant() {
+        var params = VoxVoiceParameters()
+        params.ampAttack = 0.001
+        params.ampSustain = 1.0
+        params.useVowelMorph = false  // Manual formants
+        params.timbreToFormant1 = 600.0
+
+        var plain = VoicePool(4, sampleRate)
+        var bright = VoicePool(4, sampleRate)
+        plain.setParameters(params)
+        bright.setParameters(params)
+
+        _ = plain.noteOn(60, 1.0)
+        _ = bright.noteOn(60, 1.0)
+        bright.setNoteTimbre(60, 1.0)
+
+        var difference = 0.0
+        for _ in 0..<2000 {
+            difference += Swift.abs(plain.process() - bright.process())
+        }
+        #expect(difference > 0.1, "Timbre should change the sound, difference \(difference)")
+    }
+}
@@ -226,4 +226,85 @@ struct PerVoiceLFOTests {
         let voice = pool.getVoice(voiceIndex)
         #expect(voice != nil, "Should be able to access voice")
     }
+    
+    // MARK: - Shared LFO Tests
+    
+    // Render two free-running voices with the shared LFO on or off
+    func renderFreeRunningLFO(shared: Bool, spread: Double, waveform: Int32) -> [Double] {
+        var params = VoxVoiceParameters()
+        params.lfoRetrigger = false
+        params.lfoRate = 3.0
+        params.lfoWaveform = waveform
+        params.lfoToPitch = 0.3
+        
+        var pool = VoicePool(8, sampleRate)
+        pool.setSharedLFOEnabled(shared)
+        pool.setParameters(params)
+        pool.setLFOPhaseSpread(spread)
+        _ = pool.noteOn(60, 0.8)
+        _ = pool.noteOn(64, 0.9)
+        
+        var buffer = [Double](repeating: 0.0, count: 4800)
+        pool.processBlock(&buffer, 4800)
+        return buffer
+    }
+    
+    @Test("Shared LFO is used only for free-running deterministic LFOs")
+    func testSharedLFOConditions() {
+        var pool = VoicePool(4, sampleRate)
+        var params = VoxVoiceParameters()
+        params.lfoRetrigger = true
+        pool.setParameters(params)
+        #expect(!pool.isUsingSharedLFO(), "Retriggered LFOs need their own phase")
+        
+        params.lfoRetrigger = false
+        pool.setParameters(params)
+        #expect(pool.isUsingSharedLFO())
+        
+        params.lfoWaveform = 4  // Sample & Hold
+        pool.setParameters(params)
+        #expect(!pool.isUsingSharedLFO(), "Random waveforms stay per-voice")
+        
+        params.lfoWaveform = 0
+        pool.setParameters(params)
+        pool.setSharedLFOEnabled(false)
+        #expect(!pool.isUsingSharedLFO())
+    }
+    
+    @Test("Shared LFO matches per-voice LFOs for voices started together")
+    func testSharedLFOMatchesPerVoice() {
+        for waveform: Int32 in 0...3 {
+            let shared = renderFreeRunningLFO(shared: true, spread: 0.0, waveform: waveform)
+            let perVoice = renderFreeRunningLFO(shared: false, spread: 0.0, waveform: waveform)
+            #expect(shared == perVoice, "Waveform \(waveform) should match exactly")
+            
+            let sharedSpread = renderFreeRunningLFO(shared: true, spread: 90.0, waveform: waveform)
+            let perVoiceSpread = renderFreeRunningLFO(shared: false, spread: 90.0, waveform: waveform)
+            var maxDiff = 0.0
+            for i in 0..<sharedSpread.count {
+                maxDiff = max(maxDiff, Swift.abs(sharedSpread[i] - perVoiceSpread[i]))
+            }
+            #expect(maxDiff < 1e-9, "Waveform \(waveform) with spread should match, diff \(maxDiff)")
+        }
+    }
+    
+    @Test("Free-running voices share one LFO phase")
+    func testSharedLFOPhaseCoherence() {
+        var pool = VoicePool(4, sampleRate)
+        var params = VoxVoiceParameters()
+        params.lfoRetrigger = false
+        params.lfoRate = 2.0
+        pool.setParameters(params)
+        
+        let first = pool.noteOn(60, 1.0)
+        for _ in 0..<12345 {
+            _ = pool.process()
+        }
+        let second = pool.noteOn(67, 1.0)
+        _ = pool.process()
+        
+        let a = pool.getVoice(first)!.pointee.getLFOValue()
+        let b = pool.getVoice(second)!.pointee.getLFOValue()
+        #expect(a == b, "A later voice should join the running LFO, got \(a) vs \(b)")
+    }
 }
@@ -0,0 +1,479 @@
+//
+//  PerformanceBenchmarkTests.swift
+//  VoxCoreTests
+//
+//  Render-cost benchmarks for the DSP engine. Each benchmark prints its
+//  timing so runs can be compared; assertions only check that the code under
+//  test produced sound, so results never fail on a slow CI machine.
+//
+//  The suite renders many seconds of audio, so normal test runs skip it. Set
+//  VOX_BENCHMARKS=1 in the test environment (or scheme) to run it; it is
+//  tagged .benchmark for filtering.
+//
+
+import Foundation
+import Testing
+@testable import VoxCore
+
+extension Tag {
+    @Tag static var benchmark: Self
+}
+
+@Suite("Performance Benchmarks", .tags(.benchmark),
+       .enabled(if: ProcessInfo.processInfo.environment["VOX_BENCHMARKS"] != nil,
+                "Set VOX_BENCHMARKS=1 to run the benchmarks"))
+struct PerformanceBenchmarkTests {
+    let sampleRate = 48000.0
+    let seconds = 2
+
+    func milliseconds(_ duration: Duration) -> Double {
+        let parts = duration.components
+        return Double(parts.seconds) * 1000.0 + Double(parts.attoseconds) / 1e15
+    }
+
+    // Times one run of work, which returns a checksum of what it rendered,
+    // and checks that it produced output. Returns milliseconds.
+    func measure(_ label: String, _ work: () -> Double) -> Double {
+        var checksum = 0.0
+        let time = ContinuousClock().measure {
+            checksum = work()
+        }
+        #expect(checksum != 0.0, "\(label) should produce output")
+        return milliseconds(time)
+    }
+
+    // Times a then b (see measure) and prints both with b's speedup over a
+    func compare(_ label: String, _ nameA: String, _ nameB: String,
+                 _ a: () -> Double, _ b: () -> Double) {
+        let timeA = measure("\(label), \(nameA)", a)
+        let timeB = measure("\(label), \(nameB)", b)
+        print("\(label): \(nameA) \(timeA) ms, \(nameB) \(timeB) ms, speedup \(timeA / timeB)x")
+    }
+
+    // Renders blocks of a pool for the benchmark length; returns a checksum
+    func renderBlocks(_ pool: inout VoicePool, _ buffer: inout [Double]) -> Double {
+        let blocks = Int(sampleRate) * seconds / buffer.count
+        var sum = 0.0
+        for _ in 0..<blocks {
+            pool.processBlock(&buffer, Int32(buffer.count))
+            sum += Swift.abs(buffer[0])
+        }
+        return sum
+    }
+
+    // MARK: - Sample Type
+
+    @Test("Benchmark: double vs float voice pool render")
+    func benchmarkSampleType() {
+        var params = VoxVoiceParameters()
+        params.lfoToPitch = 0.2
+        params.lfoToDutyCycle = 0.1
+
+        var reference = VoicePool(8, sampleRate)
+        var single = VoicePoolFloat(8, sampleRate)
+        reference.setParameters(params)
+        single.setParameters(params)
+        for note: Int32 in [48, 55, 60, 64, 67, 71, 74, 79] {
+            _ = reference.noteOn(note, 1.0)
+            _ = single.noteOn(note, 1.0)
+        }
+
+        let frames = Int(sampleRate) * seconds
+        compare("VoicePool 8 voices, \(seconds)s", "double", "float", {
+            var sum = 0.0
+            for _ in 0..<frames { sum += Swift.abs(reference.process()) }
+            return sum
+        }, {
+            var sum: Float = 0.0
+            for _ in 0..<frames { sum += Swift.abs(single.process()) }
+            return Double(sum)
+        })
+    }
+
+    // MARK: - Output Stage
+
+    @Test("Benchmark: per-sample vs block render with fused output stage")
+    func benchmarkBlockRender() {
+        var params = VoxVoiceParameters()
+        params.air = 0.3
+
+        var perSample = VoicePool(8, sampleRate)
+        var block = VoicePool(8, sampleRate)
+        perSample.setParameters(params)
+        block.setParameters(params)
+        for note: Int32 in [48, 55, 60, 64, 67, 71, 74, 79] {
+            _ = perSample.noteOn(note, 1.0)
+            _ = block.noteOn(note, 1.0)
+        }
+
+        let blockSize = 256
+        let blocks = Int(sampleRate) * seconds / blockSize
+        var buffer = [Double](repeating: 0.0, count: blockSize)
+        compare("VoicePool 8 voices, \(seconds)s", "per-sample", "block", {
+            var sum = 0.0
+            for _ in 0..<(blocks * blockSize) { sum += Swift.abs(perSample.process()) }
+            return sum
+        }, {
+            var sum = 0.0
+            for _ in 0..<blocks {
+                block.processBlock(&buffer, Int32(blockSize))
+                sum += Swift.abs(buffer[0])
+            }
+            return sum
+        })
+    }
+
+    // MARK: - Envelope
+
+    @Test("Benchmark: ADSR per-sample vs segment block render")
+    func benchmarkEnvelopeBlock() {
+        var perSample = ADSREnvelope(sampleRate)
+        var block = ADSREnvelope(sampleRate)
+        let blockSize = 256
+        let blocks = Int(sampleRate) * seconds * 8 / blockSize
+        var buffer = [Double](repeating: 0.0, count: blockSize)
+
+        compare("ADSR \(seconds * 8)s", "per-sample", "block", {
+            var sum = 0.0
+            for b in 0..<blocks {
+                if b % 400 == 0 { perSample.noteOn() }
+                if b % 400 == 300 { perSample.noteOff() }
+                for _ in 0..<blockSize { sum += perSample.process() }
+            }
+            return sum
+        }, {
+            var sum = 0.0
+            for b in 0..<blocks {
+                if b % 400 == 0 { block.noteOn() }
+                if b % 400 == 300 { block.noteOff() }
+                block.processBlock(&buffer, Int32(blockSize))
+                sum += buffer[blockSize - 1]
+            }
+            return sum
+        })
+    }
+
+    @Test("Benchmark: per-voice envelopes vs envelope bank")
+    func benchmarkEnvelopeBank() {
+        let laneCount = 32
+        var envelopes = [ADSREnvelope](repeating: ADSREnvelope(sampleRate), count: laneCount)
+        var banked = envelopes
+        var bank = EnvelopeBank()
+        let blockSize = 64
+        let blocks = Int(sampleRate) * seconds / blockSize
+        var buffer = [Double](repeating: 0.0, count: blockSize)
+
+        compare("\(laneCount) envelopes, \(seconds)s", "per-envelope", "bank", {
+            var sum = 0.0
+            for b in 0..<blocks {
+                for lane in 0..<laneCount {
+                    if b % 300 == lane { envelopes[lane].noteOn() }
+                    if b % 300 == 150 + lane { envelopes[lane].noteOff() }
+                    envelopes[lane].processBlock(&buffer, Int32(blockSize))
+                    sum += buffer[blockSize - 1]
+                }
+            }
+            return sum
+        }, {
+            var sum = 0.0
+            for b in 0..<blocks {
+                bank.clear()
+                for lane in 0..<laneCount {
+                    if b % 300 == lane { banked[lane].noteOn() }
+                    if b % 300 == 150 + lane { banked[lane].noteOff() }
+                    _ = bank.addLane(banked[lane], -1)
+                }
+                bank.process(Int32(blockSize))
+                for lane in 0..<laneCount {
+                    bank.store(Int32(lane), &banked[lane])
+                    sum += bank.getOutput(Int32(lane), Int32(blockSize - 1))
+                }
+            }
+            return sum
+        })
+    }
+
+    // MARK: - LFO
+
+    @Test("Benchmark: LFO per-sample vs block render")
+    func benchmarkLFOBlock() {
+        let lfoCount = 32
+        var perSample = [LFO](repeating: LFO(sampleRate), count: lfoCount)
+        for i in 0..<lfoCount {
+            perSample[i].setWaveform(LFO.Waveform.SINE)
+            perSample[i].setFrequency(5.0)
+            perSample[i].setPhaseOffset(Double(i) / Double(lfoCount))
+        }
+        var block = perSample
+        let blockSize = 64
+        let blocks = Int(sampleRate) * seconds / blockSize
+        var buffer = [Double](repeating: 0.0, count: blockSize)
+
+        compare("\(lfoCount) sine LFOs, \(seconds)s", "per-sample", "block", {
+            var sum = 0.0
+            for _ in 0..<blocks {
+                for i in 0..<lfoCount {
+                    for _ in 0..<blockSize { sum += Swift.abs(perSample[i].process()) }
+                }
+            }
+            return sum
+        }, {
+            var sum = 0.0
+            for _ in 0..<blocks {
+                for i in 0..<lfoCount {
+                    block[i].processBlock(&buffer, Int32(blockSize))
+                    sum += Swift.abs(buffer[blockSize - 1])
+                }
+            }
+            return sum
+        })
+    }
+
+    @Test("Benchmark: modulation sources at audio vs control rate")
+    func benchmarkControlRate() {
+        var lfos = [GlobalLFO](repeating: GlobalLFO(sampleRate), count: 2)
+        var drift = DriftGenerator(sampleRate)
+        var sequencer = FormantSequencer(sampleRate)
+
+        let frames = Int(sampleRate) * seconds * 4
+        let render = { (samplesPerTick: Int32) -> Double in
+            for i in 0..<lfos.count { lfos[i].setControlRate(samplesPerTick) }
+            drift.setControlRate(samplesPerTick)
+            sequencer.setControlRate(samplesPerTick)
+            var sum = 0.0
+            for _ in 0..<frames {
+                sum += lfos[0].process() + lfos[1].process() + drift.process() + sequencer.process()
+            }
+            return sum
+        }
+        compare("2 LFOs + drift + sequencer, \(seconds * 4)s", "audio rate", "32-sample ticks",
+                { render(1) }, { render(32) })
+    }
+
+    @Test("Benchmark: chaos attractors at audio vs control rate")
+    func benchmarkChaos() {
+        let frames = Int(sampleRate) * seconds * 4
+        for type in [ChaosGenerator.ChaosType.Lorenz, .Henon, .Rossler] {
+            let render = { (samplesPerTick: Int32) -> Double in
+                var chaos = ChaosGenerator(sampleRate)
+                chaos.setType(type)
+                chaos.setControlRate(samplesPerTick)
+                var sum = 0.0
+                for _ in 0..<frames { sum += Swift.abs(chaos.process()) }
+                return sum
+            }
+            compare("Chaos \(type), \(seconds * 4)s of modulation", "audio rate", "32-sample ticks",
+                    { render(1) }, { render(32) })
+        }
+    }
+
+    @Test("Benchmark: sixteen scalar drift/chaos generators vs lane banks")
+    func benchmarkModulatorBanks() {
+        let voices = 16
+        let samplesPerTick: Int32 = 32
+        var drifts = [DriftGenerator](repeating: DriftGenerator(sampleRate), count: voices)
+        var chaos = [ChaosGenerator](repeating: ChaosGenerator(sampleRate), count: voices)
+        for v in 0..<voices {
+            drifts[v].setControlRate(samplesPerTick)
+            chaos[v].setControlRate(samplesPerTick)
+        }
+        var driftBank = DriftBank(sampleRate)
+        var chaosBank = ChaosBank(sampleRate)
+
+        let frames = Int(sampleRate) * seconds * 4
+        compare("\(voices) voices drift + chaos, \(seconds * 4)s", "scalar", "banks", {
+            var sum = 0.0
+            for _ in 0..<frames {
+                for v in 0..<voices { sum += Swift.abs(drifts[v].process() + chaos[v].process()) }
+            }
+            return sum
+        }, {
+            var sum = 0.0
+            for _ in 0..<(frames / Int(samplesPerTick)) {
+                driftBank.process(samplesPerTick)
+                chaosBank.process(samplesPerTick)
+                for v: Int32 in 0..<Int32(voices) { sum += Swift.abs(driftBank.getValue(v) + chaosBank.getValue(v)) }
+            }
+            return sum
+        })
+    }
+
+    @Test("Benchmark: global modulation per voice vs one block render")
+    func benchmarkGlobalModulationBlock() {
+        var amounts = GlobalModulationAmounts()
+        amounts.lfo1ToPitch = 1.0
+        amounts.driftToFormant1 = 50.0
+        amounts.chaosToDutyCycle = 0.1
+        var shared = GlobalModulation(sampleRate)
+        shared.setRoutingAmounts(amounts)
+        let voices = 16
+        var perVoice = [GlobalModulation](repeating: shared, count: voices)
+
+        let blockSize: Int32 = 64
+        let frames = Int(sampleRate) * seconds
+        compare("Global modulation, \(voices) voices, \(seconds)s", "per voice", "shared block", {
+            var sum = 0.0
+            for _ in 0..<frames {
+                for v in 0..<voices { sum += Swift.abs(perVoice[v].process().totalPitchMod) }
+            }
+            return sum
+        }, {
+            var sum = 0.0
+            for _ in 0..<(frames / Int(blockSize)) {
+                shared.processBlock(blockSize)
+                for _ in 0..<voices { sum += Swift.abs(shared.getBlockValue(.Pitch, blockSize - 1)) }
+            }
+            return sum
+        })
+    }
+
+    @Test("Benchmark: per-voice vs shared free-running LFO")
+    func benchmarkSharedLFO() {
+        var params = VoxVoiceParameters()
+        params.lfoRetrigger = false
+        params.lfoToPitch = 0.2
+
+        // Zero spread reads the shared values; 90 degrees of spread gives
+        // every voice its own offset from the shared phase
+        for spread in [0.0, 90.0] {
+            var perVoice = VoicePool(16, sampleRate)
+            var shared = VoicePool(16, sampleRate)
+            perVoice.setSharedLFOEnabled(false)
+            perVoice.setParameters(params)
+            shared.setParameters(params)
+            perVoice.setLFOPhaseSpread(spread)
+            shared.setLFOPhaseSpread(spread)
+            for note: Int32 in 48..<64 {
+                _ = perVoice.noteOn(note, 1.0)
+                _ = shared.noteOn(note, 1.0)
+            }
+
+            var buffer = [Double](repeating: 0.0, count: 256)
+            compare("VoicePool 16 voices, free LFO, spread \(spread), \(seconds)s", "per-voice", "shared",
+                    { renderBlocks(&perVoice, &buffer) }, { renderBlocks(&shared, &buffer) })
+        }
+    }
+
+    @Test("Benchmark: voice modulation routing at audio vs control rate")
+    func benchmarkVoiceControlRate() {
+        var params = VoxVoiceParameters()
+        params.lfoRate = 5.0
+        params.lfoToPitch = 0.5
+        params.lfoToFormant1 = 200.0
+        params.lfoToFormant2 = 300.0
+
+        var audioRate = VoicePool(16, sampleRate)
+        var controlRate = VoicePool(16, sampleRate)
+        audioRate.setParameters(params)
+        params.modControlRate = 32
+        controlRate.setParameters(params)
+        for note: Int32 in 48..<64 {
+            _ = audioRate.noteOn(note, 1.0)
+            _ = controlRate.noteOn(note, 1.0)
+        }
+
+        var buffer = [Double](repeating: 0.0, count: 256)
+        compare("VoicePool 16 voices, LFO to pitch + formants, \(seconds)s", "audio rate", "32-sample ticks",
+                { renderBlocks(&audioRate, &buffer) }, { renderBlocks(&controlRate, &buffer) })
+    }
+
+    @Test("Benchmark: mono vs stereo voice pool render")
+    func benchmarkStereoRender() {
+        var params = VoxVoiceParameters()
+        params.lfoToPitch = 0.2
+
+        var pool = VoicePool(16, sampleRate)
+        pool.setParameters(params)
+        pool.setPanSpread(1.0)
+        for note: Int32 in 48..<64 {
+            _ = pool.noteOn(note, 1.0)
+        }
+
+        let blockSize = 256
+        let blocks = Int(sampleRate) * seconds / blockSize
+        var left = [Double](repeating: 0.0, count: blockSize)
+        var right = [Double](repeating: 0.0, count: blockSize)
+        compare("VoicePool 16 voices, pan spread, \(seconds)s", "mono", "stereo", {
+            renderBlocks(&pool, &left)
+        }, {
+            var sum = 0.0
+            for _ in 0..<blocks {
+                pool.processBlockStereo(&left, &right, Int32(blockSize))
+                sum += Swift.abs(left[0]) + Swift.abs(right[0])
+            }
+            return sum
+        })
+    }
+
+    @Test("Benchmark: voice pool scaling from 16 to 256 voices")
+    func benchmarkVoicePoolScaling() {
+        var params = VoxVoiceParameters()
+        params.lfoToPitch = 0.2
+        params.voiceDriftToPitch = 10.0
+
+        var buffer = [Double](repeating: 0.0, count: 256)
+        for voices: Int32 in [16, 64, 256] {
+            var pool = VoicePool(voices, sampleRate)
+            pool.setParameters(params)
+            pool.setUnisonVoices(voices / 64 + 1)
+            pool.setStealingEnabled(false)
+            var note: Int32 = 24
+            while pool.getActiveVoiceCount() < voices && note < 120 {
+                _ = pool.noteOn(note, 1.0)
+                note += 1
+            }
+
+            let ms = measure("VoicePool \(voices) voices") { renderBlocks(&pool, &buffer) }
+            let active = pool.getActiveVoiceCount()
+            print("VoicePool \(voices) voices (\(active) active), \(seconds)s: \(ms) ms, \(ms / Double(active)) ms per voice")
+        }
+    }
+
+    @Test("Benchmark: voice pool render on 0, 2 and 4 threads")
+    func benchmarkParallelRender() {
+        var params = VoxVoiceParameters()
+        params.lfoToPitch = 0.2
+        params.voiceDriftToPitch = 10.0
+
+        var buffer = [Double](repeating: 0.0, count: 256)
+        var times: [Double] = []
+        for threads: Int32 in [0, 2, 4] {
+            var pool = VoicePool(64, sampleRate)
+            pool.setRenderThreadCount(threads)
+            pool.setParameters(params)
+            for note: Int32 in 36..<100 {
+                _ = pool.noteOn(note, 1.0)
+            }
+            times.append(measure("VoicePool 64 voices, \(threads) threads") { renderBlocks(&pool, &buffer) })
+        }
+
+        print("VoicePool 64 voices, \(seconds)s: serial \(times[0]) ms, 2 threads \(times[1]) ms, 4 threads \(times[2]) ms, speedup \(times[0] / times[2])x")
+    }
+
+    @Test("Benchmark: parameter event cost, full rebuild vs changed groups")
+    func benchmarkParameterEvents() {
+        var params = VoxVoiceParameters()
+        var pool = VoicePool(16, sampleRate)
+        pool.setParameters(params)
+        for note: Int32 in 48..<64 {
+            _ = pool.noteOn(note, 1.0)
+        }
+
+        // One automation lane: formant mix moving every event
+        let events = 20000
+        compare("VoicePool 16 voices, formant mix automation, \(events) events", "full rebuild", "changed groups", {
+            for i in 0..<events {
+                params.formantMix = 0.5 + 0.5 * Double(i % 100) / 100.0
+                pool.setParameters(params, VoxParameterGroups.kAll)
+            }
+            return Double(events)
+        }, {
+            for i in 0..<events {
+                params.formantMix = 0.5 + 0.5 * Double(i % 100) / 100.0
+                pool.setParameters(params)
+            }
+            return Double(events)
+        })
+        #expect(pool.getParameters().formantMix > 0.5, "Events should reach the pool")
+    }
+}
@@ -183,6 +183,70 @@ struct StochasticCloudTests {
         #expect(maxOffset < 400, "Formant offsets should be reasonable (within ~4 sigma)")
     }
     
+    @Test("Voice latches formant scatter into its filter at grain onsets only")
+    func testVoiceLatchesFormantScatterPerGrain() {
+        var params = VoxVoiceParameters()
+        params.useVowelMorph = false
+        params.dutyCycle = 0.3
+        
+        var stochastic = StochasticParams()
+        stochastic.formantScatter = 150.0
+        stochastic.cloudScatter = 1.0
+        
+        var voice = VoxVoice(sampleRate)
+        voice.setParameters(params)
+        voice.setStochasticParams(stochastic)
+        voice.seedRNG(7)
+        voice.noteOn(57, 1.0)  // 220 Hz -> ~200 grains per second
+        
+        // Count how often the latched offset changes; it may only change
+        // once per grain, never mid-grain
+        let numSamples = Int(sampleRate / 10)
+        var changes = 0
+        var distinct = Set<Double>()
+        var previous = voice.getGrainFormantOffset()
+        for _ in 0..<numSamples {
+            _ = voice.process()
+            let offset = voice.getGrainFormantOffset()
+            if offset != previous {
+                changes += 1
+                previous = offset
+            }
+            distinct.insert(offset)
+        }
+        
+        let grains = Int(220.0 * Double(numSamples) / sampleRate) + 1
+        #expect(changes > grains / 2, "Formant scatter should reach the voice filter")
+        #expect(changes <= grains, "Filter offset should only change at grain onsets")
+        #expect(distinct.count > 5, "Each grain should get its own formant offset")
+    }
+    
+    @Test("Voice formant scatter changes the rendered output")
+    func testVoiceFormantScatterAffectsOutput() {
+        var params = VoxVoiceParameters()
+        params.useVowelMorph = false
+        
+        var stochastic = StochasticParams()
+        stochastic.formantScatter = 200.0
+        
+        var dry = VoxVoice(sampleRate)
+        var scattered = VoxVoice(sampleRate)
+        dry.setParameters(params)
+        scattered.setParameters(params)
+        scattered.setStochasticParams(stochastic)
+        dry.noteOn(60, 1.0)
+        scattered.noteOn(60, 1.0)
+        
+        var maxDiff = 0.0
+        for _ in 0..<4410 {
+            maxDiff = Swift.max(maxDiff, Swift.abs(dry.process() - scattered.process()))
+        }
+        #expect(maxDiff > 0.001, "Formant scatter should audibly change the voice")
+        
+        scattered.reset()
+        #expect(scattered.getGrainFormantOffset() == 0.0, "Reset should clear the latched offset")
+    }
+    
     // ═══════════════════════════════════════════════════════════════════
     // MARK: - Phase 5.4: Per-Grain Pan Scatter Tests
     // ═══════════════════════════════════════════════════════════════════
@@ -238,6 +302,39 @@ struct StochasticCloudTests {
         }
     }
     
+    @Test("Voice stereo render pans each grain by its latched scatter")
+    func testVoicePanScatterStereo() {
+        var stochastic = StochasticParams()
+        stochastic.panScatter = 1.0
+        
+        var mono = VoxVoice(sampleRate)
+        var stereo = VoxVoice(sampleRate)
+        mono.setStochasticParams(stochastic)
+        stereo.setStochasticParams(stochastic)
+        mono.seedRNG(11)
+        stereo.seedRNG(11)
+        mono.noteOn(57, 1.0)
+        stereo.noteOn(57, 1.0)
+        
+        let numSamples = 4410
+        var output = [Double](repeating: 0.0, count: numSamples)
+        var left = [Double](repeating: 0.0, count: numSamples)
+        var right = [Double](repeating: 0.0, count: numSamples)
+        mono.processBlock(&output, Int32(numSamples))
+        stereo.processBlockStereo(&left, &right, Int32(numSamples))
+        
+        var maxPowerError = 0.0
+        var leftLouder = 0
+        var rightLouder = 0
+        for i in 0..<numSamples {
+            maxPowerError = Swift.max(maxPowerError, Swift.abs(left[i] * left[i] + right[i] * right[i] - output[i] * output[i]))
+            if Swift.abs(left[i]) > Swift.abs(right[i]) * 1.5 { leftLouder += 1 }
+            if Swift.abs(right[i]) > Swift.abs(left[i]) * 1.5 { rightLouder += 1 }
+        }
+        #expect(maxPowerError < 1e-6, "Grain panning should be constant-power")
+        #expect(leftLouder > 0 && rightLouder > 0, "Grains should land on both sides")
+    }
+    
     // ═══════════════════════════════════════════════════════════════════
     // MARK: - Phase 5.5: Per-Grain Amplitude Scatter Tests
     // ═══════════════════════════════════════════════════════════════════
@@ -198,6 +198,43 @@ struct VoiceAllocatorTests {
         #expect(allocator.getOldestActiveVoice() == -1, "Should return -1 with no active voices")
     }
     
+    // MARK: - Lookup Tests
+    
+    @Test("Active voice list stays in ascending voice order")
+    func testActiveVoiceList() {
+        var allocator = VoiceAllocator(8)
+        allocator.setAllocationMode(.HighestNote)
+        
+        _ = allocator.allocate(60)  // voice 7
+        _ = allocator.allocate(62)  // voice 6
+        _ = allocator.allocate(64)  // voice 5
+        allocator.deallocate(6)
+        
+        #expect(allocator.getActiveVoiceCount() == 2, "Two voices should remain active")
+        #expect(allocator.getActiveVoice(0) == 5, "Lowest active voice should come first")
+        #expect(allocator.getActiveVoice(1) == 7, "Highest active voice should come last")
+    }
+    
+    @Test("Note table finds every voice allocated to a note")
+    func testNoteTableLookup() {
+        var allocator = VoiceAllocator(8)
+        
+        _ = allocator.allocate(60)  // voice 0
+        _ = allocator.allocate(64)  // voice 1
+        _ = allocator.allocate(60)  // voice 2 (unison)
+        
+        #expect(allocator.findVoicePlayingNote(60) == 0, "Lookup should return the group's lowest voice")
+        #expect(allocator.findNextVoicePlayingNote(60, 0) == 2, "Both voices of the group should be listed")
+        #expect(allocator.findNextVoicePlayingNote(60, 2) == -1, "The group should end after its last voice")
+        
+        allocator.deallocate(0)
+        #expect(allocator.findVoicePlayingNote(60) == 2, "Remaining group voice should be found")
+        #expect(allocator.findVoicePlayingNote(67) == -1, "Unplayed note should not be found")
+        
+        allocator.reset()
+        #expect(allocator.findVoicePlayingNote(64) == -1, "Reset should clear the note table")
+    }
+    
     // MARK: - Reset Tests
     
     @Test("Reset clears all allocations")
@@ -241,6 +241,48 @@ struct VoiceMixingTests {
         #expect(releaseRMS > 0.01, "Voice in release should still contribute: RMS=\(releaseRMS)")
     }
     
+    @Test("Block render matches per-sample mix, with and without the envelope bank")
+    func testBlockRenderMatchesProcess() {
+        var params = VoxVoiceParameters()
+        params.ampAttack = 0.002
+        params.ampRelease = 0.01
+        params.modEnvToFormant1 = 300.0
+        params.useVowelMorph = false
+        
+        for envelopeBank in [false, true] {
+            var reference = VoicePool(8, sampleRate)
+            var block = VoicePool(8, sampleRate)
+            reference.setParameters(params)
+            block.setParameters(params)
+            block.setEnvelopeBankEnabled(envelopeBank)
+            for note: Int32 in [48, 55, 60, 67] {
+                _ = reference.noteOn(note, 0.8)
+                _ = block.noteOn(note, 0.8)
+            }
+            
+            var expected: [Double] = []
+            var rendered: [Double] = []
+            for (index, size) in [100, 37, 256, 1, 500, 64, 1000, 3].enumerated() {
+                if index == 3 {
+                    // Two voices release and go idle mid-block
+                    reference.noteOff(48)
+                    reference.noteOff(60)
+                    block.noteOff(48)
+                    block.noteOff(60)
+                }
+                for _ in 0..<size {
+                    expected.append(reference.process())
+                }
+                var buffer = [Double](repeating: 0.0, count: size)
+                block.processBlock(&buffer, Int32(size))
+                rendered.append(contentsOf: buffer)
+            }
+            
+            #expect(rendered == expected, "Block render (bank \(envelopeBank)) should match per-sample render")
+            #expect(block.getActiveVoiceCount() == 2, "Released voices should be returned to the pool")
+        }
+    }
+    
     // MARK: - Velocity Mix Tests
     
     @Test("Voices with different velocities mix correctly")
@@ -363,6 +363,312 @@ struct VoicePoolTests {
         #expect(maxAmp == 0.0, "Should produce silence after reset")
     }
     
+    // MARK: - Block vs Per-Sample Render
+    
+    // Plays notes on two pools from makePool, renders one in blocks and the
+    // other per sample, and returns the largest sample difference. The block
+    // pool is passed to afterRender once rendering is done.
+    func blockRenderDifference(notes: [Int32], _ makePool: () -> VoicePool,
+                               afterRender: (inout VoicePool) -> Void = { _ in }) -> Double {
+        var perSample = makePool()
+        var block = makePool()
+        for note in notes {
+            _ = perSample.noteOn(note, 1.0)
+            _ = block.noteOn(note, 1.0)
+        }
+        
+        // Odd block size so render spans and modulation ticks interleave
+        let blockSize = 100
+        var buffer = [Double](repeating: 0.0, count: blockSize)
+        var maxDiff = 0.0
+        for _ in 0..<50 {
+            block.processBlock(&buffer, Int32(blockSize))
+            for i in 0..<blockSize {
+                maxDiff = max(maxDiff, Swift.abs(buffer[i] - perSample.process()))
+            }
+        }
+        afterRender(&block)
+        return maxDiff
+    }
+    
+    // MARK: - Per-Voice Drift Tests
+    
+    @Test("Per-voice drift renders the same per sample and in blocks")
+    func testVoiceDriftBlockMatchesPerSample() {
+        var params = VoxVoiceParameters()
+        params.voiceDriftRate = 0.1
+        params.voiceDriftToPitch = 30.0
+        params.voiceChaosToPitch = 20.0
+        
+        let maxDiff = blockRenderDifference(notes: [48, 52, 55, 60], {
+            var pool = VoicePool(8, sampleRate)
+            pool.setParameters(params)
+            #expect(pool.isUsingVoiceModulation())
+            return pool
+        })
+        #expect(maxDiff < 1e-12, "Block render should match per-sample render, diff \(maxDiff)")
+    }
+    
+    @Test("Per-voice drift detunes each voice on its own")
+    func testVoiceDriftChangesOutput() {
+        var params = VoxVoiceParameters()
+        var steady = VoicePool(4, sampleRate)
+        steady.setParameters(params)
+        #expect(!steady.isUsingVoiceModulation())
+        
+        params.voiceChaosRate = 10.0
+        params.voiceChaosToPitch = 50.0
+        var drifting = VoicePool(4, sampleRate)
+        drifting.setParameters(params)
+        
+        _ = steady.noteOn(60, 1.0)
+        _ = drifting.noteOn(60, 1.0)
+        var maxDiff = 0.0
+        for _ in 0..<Int(sampleRate) {
+            maxDiff = max(maxDiff, Swift.abs(steady.process() - drifting.process()))
+        }
+        #expect(maxDiff > 0.01, "Chaos on pitch should move the voice away from the steady render")
+    }
+    
+    @Test("Per-voice formant wander reaches vowel morph and vowel space")
+    func testVoiceFormantModulationInVowelModes() {
+        for useVowelSpace in [false, true] {
+            var params = VoxVoiceParameters()
+            params.useVowelSpace = useVowelSpace
+            var steady = VoicePool(4, sampleRate)
+            steady.setParameters(params)
+            
+            params.voiceChaosToFormant = 300.0
+            var wandering = VoicePool(4, sampleRate)
+            wandering.setParameters(params)
+            
+            _ = steady.noteOn(60, 1.0)
+            _ = wandering.noteOn(60, 1.0)
+            var difference = 0.0
+            for _ in 0..<10000 {
+                difference += Swift.abs(steady.process() - wandering.process())
+            }
+            #expect(difference > 1.0, "Formant chaos should move the formants, vowel space \(useVowelSpace), difference \(difference)")
+        }
+    }
+    
+    // MARK: - Global Modulation Tests
+    
+    @Test("Global modulation renders the same per sample and in blocks")
+    func testGlobalModulationBlockMatchesPerSample() {
+        var amounts = GlobalModulationAmounts()
+        amounts.lfo1ToPitch = 1.0
+        amounts.lfo2ToDutyCycle = 0.1
+        
+        let maxDiff = blockRenderDifference(notes: [48, 52, 55, 60], {
+            var pool = VoicePool(8, sampleRate)
+            #expect(!pool.isGlobalModulationEnabled(), "Global modulation is opt-in")
+            pool.setGlobalModulationEnabled(true)
+            pool.setGlobalModulationAmounts(amounts)
+            return pool
+        })
+        #expect(maxDiff == 0.0, "Block render should match per-sample render, diff \(maxDiff)")
+    }
+    
+    @Test("Global modulation reaches every voice")
+    func testGlobalModulationChangesOutput() {
+        var amounts = GlobalModulationAmounts()
+        amounts.lfo1ToPitch = 2.0
+        
+        var plain = VoicePool(4, sampleRate)
+        var modulated = VoicePool(4, sampleRate)
+        modulated.setGlobalModulationEnabled(true)
+        modulated.setGlobalModulationAmounts(amounts)
+        _ = plain.noteOn(60, 1.0)
+        _ = modulated.noteOn(60, 1.0)
+        
+        var maxDiff = 0.0
+        for _ in 0..<Int(sampleRate) {
+            maxDiff = max(maxDiff, Swift.abs(plain.process() - modulated.process()))
+        }
+        #expect(maxDiff > 0.01, "Global pitch modulation should change the render")
+    }
+    
+    @Test("Global formant modulation reaches vowel morph and vowel space")
+    func testGlobalFormantModulationInVowelModes() {
+        var amounts = GlobalModulationAmounts()
+        amounts.lfo1ToFormant1 = 300.0
+        
+        for useVowelSpace in [false, true] {
+            var params = VoxVoiceParameters()
+            params.useVowelSpace = useVowelSpace
+            var plain = VoicePool(4, sampleRate)
+            var modulated = VoicePool(4, sampleRate)
+            plain.setParameters(params)
+            modulated.setParameters(params)
+            modulated.setGlobalModulationEnabled(true)
+            modulated.setGlobalModulationAmounts(amounts)
+            _ = plain.noteOn(60, 1.0)
+            _ = modulated.noteOn(60, 1.0)
+            
+            var difference = 0.0
+            for _ in 0..<Int(sampleRate) {
+                difference += Swift.abs(plain.process() - modulated.process())
+            }
+            #expect(difference > 1.0, "Global F1 modulation should move the formant, vowel space \(useVowelSpace), difference \(difference)")
+        }
+    }
+    
+    // MARK: - Note Lookup Tests
+    
+    @Test("Note events reach every voice of a unison group")
+    func testUnisonGroupLookup() {
+        var pool = VoicePool(8, sampleRate)
+        pool.setUnisonVoices(3)
+        
+        _ = pool.noteOn(60, 1.0)
+        _ = pool.noteOn(64, 1.0)
+        #expect(pool.getActiveVoiceCount() == 6, "Each note should take three voices")
+        
+        pool.setPolyAftertouch(60, 0.5)
+        var pressed = 0
+        for i: Int32 in 0..<8 {
+            if let voice = pool.getVoice(i), voice.pointee.getAftertouch() == 0.5 {
+                pressed += 1
+            }
+        }
+        #expect(pressed == 3, "Aftertouch should reach the whole group")
+        
+        pool.noteOff(60)
+        var buffer = [Double](repeating: 0.0, count: Int(sampleRate))
+        pool.processBlock(&buffer, Int32(buffer.count))
+        #expect(!pool.isNoteActive(60), "Released group should finish")
+        #expect(pool.isNoteActive(64), "Held group should keep sounding")
+        #expect(pool.getActiveVoiceCount() == 3, "Only the held group's voices should remain")
+    }
+    
+    // MARK: - High Polyphony Tests
+    
+    @Test("Pools beyond sixteen voices give every note its own voice")
+    func testHighPolyphonyAllocation() {
+        var pool = VoicePool(64, sampleRate)
+        #expect(pool.getVoiceCount() == 64)
+        
+        for note: Int32 in 0..<64 {
+            #expect(pool.noteOn(36 + note, 1.0) == note, "Each note should take the next voice")
+        }
+        #expect(pool.getActiveVoiceCount() == 64, "All 64 voices should sound")
+        #expect(pool.isNoteActive(99), "The last note should be found")
+        
+        // A 65th note steals the oldest voice
+        #expect(pool.noteOn(100, 1.0) == 0, "The oldest voice should be stolen")
+        #expect(!pool.isNoteActive(36), "The stolen note should be gone")
+        #expect(pool.getActiveVoiceCount() == 64)
+        
+        pool.allNotesOff()
+        var buffer = [Double](repeating: 0.0, count: Int(sampleRate))
+        pool.processBlock(&buffer, Int32(buffer.count))
+        #expect(pool.getActiveVoiceCount() == 0, "Every voice should return to the pool")
+    }
+    
+    @Test("Pools beyond sixteen voices render the same per sample and in blocks")
+    func testHighPolyphonyBlockMatchesPerSample() {
+        var params = VoxVoiceParameters()
+        params.voiceDriftToPitch = 30.0
+        params.voiceChaosToFormant = 50.0
+        
+        let maxDiff = blockRenderDifference(notes: Array(40..<80), {
+            var pool = VoicePool(40, sampleRate)
+            pool.setParameters(params)
+            return pool
+        }, afterRender: { block in
+            #expect(block.getActiveVoiceCount() == 40)
+        })
+        #expect(maxDiff < 1e-12, "Block render should match per-sample render, diff \(maxDiff)")
+    }
+    
+    // MARK: - Parameter Update Tests
+    
+    @Test("Incremental parameter changes render the same as full rebuilds")
+    func testIncrementalParameters() {
+        var params = VoxVoiceParameters()
+        var incremental = VoicePool(8, sampleRate)
+        var full = VoicePool(8, sampleRate)
+        incremental.setParameters(params)
+        full.setParameters(params, VoxParameterGroups.kAll)
+        for note: Int32 in [48, 55, 60, 64] {
+            _ = incremental.noteOn(note, 1.0)
+            _ = full.noteOn(note, 1.0)
+        }
+        
+        let blockSize = 128
+        var a = [Double](repeating: 0.0, count: blockSize)
+        var b = [Double](repeating: 0.0, count: blockSize)
+        var maxDiff = 0.0
+        for block in 0..<60 {
+            switch block % 4 {
+            case 0: params.formantMix = 0.5 + 0.01 * Double(block)
+            case 1: params.vowelMorph = 0.01 * Double(block)
+            case 2: params.ampSustain = 0.4 + 0.005 * Double(block)
+            default: params.air = 0.005 * Double(block)
+            }
+            incremental.setParameters(params)
+            full.setParameters(params, VoxParameterGroups.kAll)
+            incremental.processBlock(&a, Int32(blockSize))
+            full.processBlock(&b, Int32(blockSize))
+            for i in 0..<blockSize {
+                maxDiff = max(maxDiff, Swift.abs(a[i] - b[i]))
+            }
+        }
+        #expect(maxDiff == 0.0, "Rebuilding only the changed groups should not change the render, diff \(maxDiff)")
+    }
+    
+    // MARK: - Parallel Render Tests
+    
+    func renderStereo(threads: Int32) -> [Double] {
+        var params = VoxVoiceParameters()
+        params.voiceDriftToPitch = 20.0
+        params.ampRelease = 0.05
+        
+        var pool = VoicePool(24, sampleRate)
+        pool.setRenderThreadCount(threads)
+        pool.setParameters(params)
+        pool.setPanSpread(1.0)
+        for note: Int32 in 40..<64 {
+            _ = pool.noteOn(note, 1.0)
+        }
+        
+        let blockSize = 300
+        var left = [Double](repeating: 0.0, count: blockSize)
+        var right = [Double](repeating: 0.0, count: blockSize)
+        var output: [Double] = []
+        for block in 0..<40 {
+            if block == 20 {
+                pool.allNotesOff()
+            }
+            pool.processBlockStereo(&left, &right, Int32(blockSize))
+            output += left
+            output += right
+        }
+        return output
+    }
+    
+    @Test("Parallel render output does not depend on the thread count")
+    func testParallelRenderIsDeterministic() {
+        let serial = renderStereo(threads: 0)
+        let oneThread = renderStereo(threads: 1)
+        #expect(oneThread == serial, "One thread should match the serial render exactly")
+        #expect(renderStereo(threads: 2) == serial, "Two threads should match the serial render exactly")
+        #expect(renderStereo(threads: 4) == serial, "Four threads should match the serial render exactly")
+    }
+    
+    @Test("Render workers run the setup hook before the first render")
+    func testRenderThreadSetup() {
+        var pool = VoicePool(24, sampleRate)
+        pool.setRenderThreadSetup({ _, _ in true }, nil)
+        pool.setRenderThreadCount(4)
+        #expect(pool.getRealtimeRenderThreadCount() == 3, "Every worker should have joined the schedule")
+        
+        pool.setRenderThreadSetup({ _, _ in false }, nil)
+        #expect(pool.getRenderThreadCount() == 4)
+        #expect(pool.getRealtimeRenderThreadCount() == 0, "Restarted workers should run the new hook")
+    }
+    
     // MARK: - Allocation Mode Tests
     
     @Test("Allocation mode can be changed")
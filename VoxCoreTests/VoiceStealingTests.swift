@@ -75,6 +75,35 @@ struct VoiceStealingTests {
         #expect(is76Active, "New note 76 should be active")
     }
     
+    @Test("SoonestSilent mode steals the voice closest to the end of its release")
+    func testSoonestSilentStealing() {
+        var pool = VoicePool(4, sampleRate)
+        pool.setStealingEnabled(true)
+        pool.setStealingMode(.SoonestSilent)
+        
+        _ = pool.noteOn(60, 1.0)  // Oldest, still held
+        _ = pool.noteOn(64, 1.0)
+        _ = pool.noteOn(67, 1.0)
+        _ = pool.noteOn(72, 1.0)
+        for _ in 0..<4410 { _ = pool.process() }
+        
+        // 64 released well before 67, so its tail ends first
+        pool.noteOff(64)
+        for _ in 0..<4000 { _ = pool.process() }
+        pool.noteOff(67)
+        for _ in 0..<100 { _ = pool.process() }
+        #expect(pool.getActiveVoiceCount() == 4, "Released voices should still be sounding")
+        #expect(pool.getPredictedActiveVoiceCount(Int32(sampleRate)) == 2,
+                "Only the held voices should outlast one second")
+        
+        _ = pool.noteOn(76, 1.0)
+        
+        #expect(!pool.isNoteActive(64), "Almost-finished note (64) should have been stolen")
+        #expect(pool.isNoteActive(60), "Held oldest note should survive")
+        #expect(pool.isNoteActive(67), "Later release should survive")
+        #expect(pool.isNoteActive(76), "New note should be playing")
+    }
+    
     @Test("Quietest mode steals the voice with lowest velocity")
     func testQuietestStealing() {
         var pool = VoicePool(4, sampleRate)
@@ -106,6 +135,36 @@ struct VoiceStealingTests {
         #expect(is76Active, "New note 76 should be active")
     }
     
+    @Test("Faintest mode steals released voices first, then the lowest output level")
+    func testFaintestStealing() {
+        var pool = VoicePool(4, sampleRate)
+        pool.setStealingEnabled(true)
+        pool.setStealingMode(.Faintest)
+        
+        var params = VoxVoiceParameters()
+        params.ampRelease = 2.0
+        pool.setParameters(params)
+        
+        _ = pool.noteOn(60, 1.0)
+        _ = pool.noteOn(64, 0.3)  // Quietest held note
+        _ = pool.noteOn(67, 1.0)
+        _ = pool.noteOn(72, 1.0)
+        var buffer = [Double](repeating: 0.0, count: 4410)
+        pool.processBlock(&buffer, 4410)
+        
+        // 67 is louder than 64 but already fading
+        pool.noteOff(67)
+        pool.processBlock(&buffer, 100)
+        _ = pool.noteOn(76, 1.0)
+        #expect(!pool.isNoteActive(67), "Released note should be stolen first")
+        #expect(pool.isNoteActive(64), "Held notes survive while a released one remains")
+        
+        // The new note is still in its attack and counts at its peak
+        _ = pool.noteOn(77, 1.0)
+        #expect(!pool.isNoteActive(64), "Quietest held note should be stolen next")
+        #expect(pool.isNoteActive(76), "Just-started note should not be taken for the faintest")
+    }
+    
     // MARK: - Stealing Disabled Tests
     
     @Test("No stealing when disabled")
@@ -203,6 +262,34 @@ struct VoiceStealingTests {
         #expect(is84Active, "Note 84 should be active")
     }
     
+    // MARK: - Steal Fade Tests
+    
+    @Test("Stolen voices fade out instead of cutting off")
+    func testStolenVoiceFadesOut() {
+        var pool = VoicePool(1, sampleRate)
+        pool.setStealingEnabled(true)
+        
+        var params = VoxVoiceParameters()
+        params.ampAttack = 1.0  // New note stays near silent during the fade
+        pool.setParameters(params)
+        
+        _ = pool.noteOn(60, 1.0)
+        var held = [Double](repeating: 0.0, count: 44100)
+        pool.processBlock(&held, 44100)
+        let heldPeak = held[44000...].map { Swift.abs($0) }.max() ?? 0.0
+        
+        _ = pool.noteOn(72, 1.0)
+        var output = [Double](repeating: 0.0, count: 512)
+        pool.processBlock(&output, 512)
+        
+        let fadeSamples = Int(VoicePool.kStealFadeSeconds * sampleRate)
+        let headPeak = output[0..<64].map { Swift.abs($0) }.max() ?? 0.0
+        let tailPeak = output[(fadeSamples + 50)...].map { Swift.abs($0) }.max() ?? 0.0
+        #expect(headPeak > 0.25 * heldPeak, "Stolen note should still sound right after the steal")
+        #expect(tailPeak < 0.05 * heldPeak, "Stolen note should be gone after the fade")
+        #expect(pool.getActiveVoiceCount() == 1, "Fading voices do not count as active")
+    }
+    
     // MARK: - Stealing Mode Configuration Tests
     
     @Test("Stealing mode can be changed at runtime")
@@ -226,6 +226,26 @@ struct VoxVoiceTests {
                "High note (\(highZC) ZC) should be at least 2x higher freq than low note (\(lowZC) ZC)")
     }
     
+    @Test("Pitch ratios stay within a thousandth of a cent")
+    func testPitchTableAccuracy() {
+        #expect(PitchTable.noteToFrequency(69) == 440.0, "A4 should be 440 Hz")
+        for octave in -4...4 {
+            let ratio = PitchTable.semitonesToRatio(Double(octave * 12))
+            let expected = octave >= 0 ? Double(1 << octave) : 1.0 / Double(1 << -octave)
+            #expect(ratio == expected, "Whole octaves should be exact")
+        }
+        
+        // Every MIDI interval from A4, against the std::pow note table
+        let maxRelativeError = 5.8e-7  // 0.001 cents
+        for note: Int32 in 0..<128 {
+            let expected = PitchTable.noteToFrequency(note) / 440.0
+            let ratio = PitchTable.semitonesToRatio(Double(note - 69))
+            #expect(Swift.abs(ratio / expected - 1.0) < maxRelativeError, "Note \(note) ratio off by \(ratio / expected - 1.0)")
+            let cents = PitchTable.centsToRatio(Double(note - 69) * 100.0)
+            #expect(Swift.abs(cents / expected - 1.0) < maxRelativeError, "Note \(note) cents ratio off by \(cents / expected - 1.0)")
+        }
+    }
+    
     @Test("Pitch bend affects frequency")
     func testPitchBend() {
         var voice = VoxVoice(sampleRate)
@@ -312,4 +332,223 @@ struct VoxVoiceTests {
         #expect(!voice.isActive(), "Voice should be inactive after reset")
         #expect(voice.getCurrentNote() == -1, "Note should be cleared after reset")
     }
+    
+    // MARK: - Output Stage Tests
+    
+    @Test("Block render matches per-sample render")
+    func testBlockMatchesProcess() {
+        var params = VoxVoiceParameters()
+        params.lfoToPitch = 0.2
+        params.air = 0.4
+        
+        var perSample = VoxVoice(sampleRate)
+        var block = VoxVoice(sampleRate)
+        perSample.setParameters(params)
+        block.setParameters(params)
+        perSample.noteOn(60, 0.8)
+        block.noteOn(60, 0.8)
+        
+        var expected = [Double](repeating: 0.0, count: 1000)
+        for i in 0..<expected.count {
+            expected[i] = perSample.process()
+        }
+        var rendered = [Double](repeating: 0.0, count: 1000)
+        block.processBlock(&rendered, Int32(rendered.count))
+        
+        #expect(rendered == expected, "Fused block output stage should match process()")
+    }
+    
+    @Test("Air darkens the voice")
+    func testAirDarkens() {
+        var bright = VoxVoice(sampleRate)
+        var dark = VoxVoice(sampleRate)
+        var params = VoxVoiceParameters()
+        bright.setParameters(params)
+        params.air = 1.0
+        dark.setParameters(params)
+        bright.noteOn(69, 1.0)
+        dark.noteOn(69, 1.0)
+        
+        // Compare high-frequency content via first-difference energy
+        var brightPrev = 0.0, darkPrev = 0.0
+        var brightHF = 0.0, darkHF = 0.0
+        for _ in 0..<4410 {
+            let b = bright.process()
+            let d = dark.process()
+            brightHF += (b - brightPrev) * (b - brightPrev)
+            darkHF += (d - darkPrev) * (d - darkPrev)
+            brightPrev = b
+            darkPrev = d
+        }
+        #expect(darkHF < brightHF * 0.9, "Full Air should roll off high frequencies")
+    }
+    
+    @Test("Master volume changes ramp across a block")
+    func testMasterVolumeRamp() {
+        var voice = VoxVoice(sampleRate)
+        var params = VoxVoiceParameters()
+        params.ampAttack = 0.001
+        params.formantMix = 0.0  // Dry pulsar train, no filter ringing
+        params.dutyCycle = 1.0
+        params.pulsaretShape = 2
+        voice.setParameters(params)
+        voice.noteOn(60, 1.0)
+        
+        var warmup = [Double](repeating: 0.0, count: 2048)
+        voice.processBlock(&warmup, Int32(warmup.count))
+        
+        params.masterVolume = 0.0
+        voice.setParameters(params)
+        var block = [Double](repeating: 0.0, count: 64)
+        voice.processBlock(&block, Int32(block.count))
+        
+        #expect(block[0] != 0.0 || block[1] != 0.0, "Gain should not jump to the new level")
+        #expect(block[63] == 0.0, "Gain should reach the new level by the end of the chunk")
+    }
+    
+    @Test("Control-rate block render matches audio rate for a static voice")
+    func testControlRateStaticVoice() {
+        var audioRate = VoxVoice(sampleRate)
+        var controlRate = VoxVoice(sampleRate)
+        var params = VoxVoiceParameters()
+        audioRate.setParameters(params)
+        params.modControlRate = 32
+        controlRate.setParameters(params)
+        audioRate.noteOn(57, 1.0)
+        controlRate.noteOn(57, 1.0)
+        
+        var expected = [Double](repeating: 0.0, count: 4800)
+        var rendered = [Double](repeating: 0.0, count: 4800)
+        audioRate.processBlock(&expected, Int32(expected.count))
+        controlRate.processBlock(&rendered, Int32(rendered.count))
+        
+        #expect(rendered == expected, "Unmodulated targets should not change between control ticks")
+    }
+    
+    @Test("Control-rate block render tracks per-sample modulation")
+    func testControlRateTracksModulation() {
+        var perSample = VoxVoice(sampleRate)
+        var block = VoxVoice(sampleRate)
+        var params = VoxVoiceParameters()
+        params.lfoRate = 5.0
+        params.lfoToPitch = 2.0
+        params.lfoToFormant1 = 300.0
+        params.lfoToDutyCycle = 0.1
+        params.modControlRate = 32
+        perSample.setParameters(params)
+        block.setParameters(params)
+        perSample.noteOn(57, 1.0)
+        block.noteOn(57, 1.0)
+        
+        var expected = [Double](repeating: 0.0, count: 48000)
+        for i in 0..<expected.count {
+            expected[i] = perSample.process()
+        }
+        var rendered = [Double](repeating: 0.0, count: 48000)
+        block.processBlock(&rendered, Int32(rendered.count))
+        
+        var maxDiff = 0.0
+        for i in 0..<rendered.count {
+            maxDiff = Swift.max(maxDiff, Swift.abs(rendered[i] - expected[i]))
+        }
+        #expect(maxDiff > 0.0, "Block render should evaluate the routing once per tick")
+        #expect(maxDiff < 0.01, "Ramped targets should stay close to per-sample routing (max diff \(maxDiff))")
+    }
+    
+    @Test("Stereo block render pans with constant-power gains")
+    func testStereoBlockPan() {
+        var mono = VoxVoice(sampleRate)
+        var stereo = VoxVoice(sampleRate)
+        let params = VoxVoiceParameters()
+        mono.setParameters(params)
+        stereo.setParameters(params)
+        stereo.setPan(-0.5)
+        mono.noteOn(60, 1.0)
+        stereo.noteOn(60, 1.0)
+        
+        var output = [Double](repeating: 0.0, count: 1000)
+        var left = [Double](repeating: 0.0, count: 1000)
+        var right = [Double](repeating: 0.0, count: 1000)
+        mono.processBlock(&output, Int32(output.count))
+        stereo.processBlockStereo(&left, &right, Int32(left.count))
+        
+        // Pan -0.5: cos(pi/8) left, sin(pi/8) right
+        let leftGain = 0.9238795325112867
+        let rightGain = 0.3826834323650898
+        var maxDiff = 0.0
+        for i in 0..<output.count {
+            maxDiff = Swift.max(maxDiff, Swift.abs(left[i] - output[i] * leftGain))
+            maxDiff = Swift.max(maxDiff, Swift.abs(right[i] - output[i] * rightGain))
+        }
+        #expect(maxDiff < 1e-8, "Stereo render should be the mono render times the pan gains")
+    }
+    
+    // MARK: - Parameter Group Tests
+    
+    @Test("Parameter changes map to the subsystems they feed")
+    func testParameterGroups() {
+        let base = VoxVoiceParameters()
+        var changed = base
+        #expect(VoxParameterGroups.changed(base, changed) == 0, "Equal parameters need no rebuild")
+        
+        changed.ampAttack = 0.5
+        #expect(VoxParameterGroups.changed(base, changed) == VoxParameterGroups.kAmpEnvelope)
+        
+        changed.vowelMorph = 0.5
+        changed.lfoRate = 3.0
+        let expected = VoxParameterGroups.kAmpEnvelope | VoxParameterGroups.kFormant | VoxParameterGroups.kLFO
+        #expect(VoxParameterGroups.changed(base, changed) == expected)
+        
+        // Render-time fields rebuild nothing
+        var levels = base
+        levels.masterVolume = 0.5
+        levels.lfoToPitch = 1.0
+        #expect(VoxParameterGroups.changed(base, levels) == 0)
+    }
+    
+    @Test("Parameter slots hand the render thread only control-thread changes")
+    func testParameterSlots() {
+        var slots = ParameterSlots()
+        #expect(!slots.hasChanges(), "Nothing written yet")
+        
+        slots.write(5, 0.25)
+        slots.write(5, 0.5)
+        slots.write(70, 1.0)
+        #expect(slots.hasChanges())
+        let changes = slots.takeChanges()
+        #expect(changes.contains(5))
+        #expect(changes.contains(70))
+        #expect(changes.next(0) == 5)
+        #expect(changes.next(6) == 70)
+        #expect(changes.next(71) == -1)
+        #expect(slots.load(5) == 0.5, "The newest value is read")
+        #expect(!slots.hasChanges(), "Changes are taken once")
+        #expect(!slots.write(UInt64(ParameterSlots.kNumSlots), 1.0), "Out of range addresses are ignored")
+    }
+    
+    @Test("A control-thread change never rolls back render-side automation")
+    func testParameterSlotsKeepAutomation() {
+        var slots = ParameterSlots()
+        let automated = 3
+        let edited = 9
+        var render = [Float](repeating: 0.0, count: Int(ParameterSlots.kNumSlots))
+        
+        // The UI edits one parameter; before the next render, automation for
+        // another arrives on the render thread and applies at once
+        slots.write(UInt64(edited), 0.7)
+        slots.store(UInt64(automated), 0.9)
+        render[automated] = 0.9
+        
+        // Block boundary: only the UI's change is re-applied
+        let changes = slots.takeChanges()
+        var address = Int(changes.next(0))
+        while address >= 0 {
+            render[address] = slots.load(UInt64(address))
+            address = Int(changes.next(Int32(address + 1)))
+        }
+        
+        #expect(!changes.contains(Int32(automated)))
+        #expect(render[automated] == 0.9, "Automation should survive the UI change")
+        #expect(render[edited] == 0.7)
+    }
 }
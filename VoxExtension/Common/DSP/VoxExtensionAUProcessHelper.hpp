@@ -35,6 +35,9 @@ public:
         
         AUEventSampleTime now = AUEventSampleTime(timestamp->mSampleTime);
         AUAudioFrameCount framesRemaining = frameCount;
+        
+        // Host tempo and beat position, read once for the whole buffer
+        mKernel.beginRender(now);
         AURenderEvent const *nextEvent = events; // events is a linked list, at the beginning, the nextEvent is the first event
         
         auto callProcess = [this] (AudioBufferList* outBufferListPtr, AUEventSampleTime now, AUAudioFrameCount frameCount, AUAudioFrameCount const frameOffset) {
@@ -10,7 +10,8 @@
 #import <AudioToolbox/AudioToolbox.h>
 #include <cstring>
 #include <cstdint>
-#include <unordered_map>
+#include <atomic>
+#include <array>
 #include <cmath>
 #import <CoreMIDI/CoreMIDI.h>
 #import <algorithm>
@@ -33,31 +34,28 @@
 /*
  VoxExtensionDSPKernel
  As a non-ObjC class, this is safe to use from render thread.
+ 
+ Parameters: raw values live in ParameterSlots, a dense array of atomics
+ indexed by address, so getParameter() and setParameter() never allocate or
+ lock. A control-thread write (UI, state restore) marks its address changed;
+ at the start of each render call the render thread re-applies just the
+ changed addresses on top of its own voice parameters. Automation events
+ arrive on the render thread and apply directly, and a later control-thread
+ change to another parameter cannot roll them back.
  */
 class VoxExtensionDSPKernel {
 public:
     VoxExtensionDSPKernel() {
-        // Initialize stored parameters
-        std::memset(&mStoredParameters, 0, sizeof(mStoredParameters));
+        // Fields without an AU parameter start at zero
+        std::memset(&mRenderParameters, 0, sizeof(mRenderParameters));
         
-        // Set sensible defaults
-        mStoredParameters.masterVolume = 0.5;
-        mStoredParameters.dutyCycle = 0.2;
-        mStoredParameters.pulsaretShape = 1;
-        mStoredParameters.vowelMorph = 0.0;
-        mStoredParameters.formant1Freq = 800.0;
-        mStoredParameters.formant2Freq = 1200.0;
-        mStoredParameters.formant1Q = 10.0;
-        mStoredParameters.formant2Q = 10.0;
-        mStoredParameters.formantMix = 1.0;
-        mStoredParameters.useVowelMorph = true;
-        mStoredParameters.ampAttack = 0.01;
-        mStoredParameters.ampDecay = 0.1;
-        mStoredParameters.ampSustain = 0.7;
-        mStoredParameters.ampRelease = 0.3;
-        mStoredParameters.glideEnabled = false;
-        mStoredParameters.glideTime = 0.1;
-        mStoredParameters.pitchBendSemitones = 0.0;
+        // Every parameter starts at its default; the voice parameters are
+        // built from those values
+        for (AUParameterAddress address = 0; address < kNumParameterSlots; ++address) {
+            const AUValue value = defaultParameterValue(address);
+            mParameters.store(address, value);
+            applyParameter(mRenderParameters, address, value);
+        }
     }
     
     void initialize(int channelCount, double inSampleRate) {
@@ -65,11 +63,18 @@ public:
         mSampleRate = inSampleRate;
         
         // Initialize polyphonic voice pool (8 voices)
-        mVoicePool = std::make_unique<VoicePool>(8, inSampleRate);
+        mVoicePool = std::make_unique<VoxEngine>(8, inSampleRate);
         VOX_LOG("VoicePool created with 8 voices");
-        mVoicePool->setParameters(mStoredParameters);
+        // Not rendering yet, so this thread may take the render side
+        applyChangedParameters();
+        mVoicePool->setParameters(mRenderParameters);
         mVoicePool->setStealingEnabled(true);
-        mVoicePool->setStealingMode(VoicePool::StealingMode::Oldest);
+        mVoicePool->setStealingMode(VoxEngine::StealingMode::Faintest);
+        mVoicePool->setTempo(mHostTempo);
+        mExpression.reset();
+        
+        // Scratch buffer for block rendering (allocated here, never on the render thread)
+        mRenderBuffer.assign(std::max<AUAudioFrameCount>(mMaxFramesToRender, 1), VoxEngine::Sample(0));
         
         // Initialize output level metering
         mLevelDecayCoeff = std::exp(-1.0f / (static_cast<float>(mSampleRate) * 0.05f));
@@ -90,132 +95,136 @@ public:
     }
     
     // MARK: - Parameter Getter / Setter
+    static constexpr AUParameterAddress kNumParameterSlots = ParameterSlots::kNumSlots;
+    
+    // Control threads only (UI, state restore); the render thread applies
+    // automation through handleParameterEvent()
     void setParameter(AUParameterAddress address, AUValue value) {
-        // Store raw parameter value
-        mRawParameterValues[address] = value;
-        
-        bool updateVoice = true;
-        
+        mParameters.write(address, value);
+    }
+    
+    // Any thread; wait-free
+    AUValue getParameter(AUParameterAddress address) const {
+        return mParameters.load(address);
+    }
+    
+    static AUValue defaultParameterValue(AUParameterAddress address) {
+        switch (address) {
+            case VoxExtensionParameterAddress::masterVolume:
+                return -6.0f;
+            case VoxExtensionParameterAddress::modQuality:
+                return static_cast<AUValue>(kDefaultModQuality);
+            case VoxExtensionParameterAddress::pulsaretShape:
+                return 1.0f;
+            case VoxExtensionParameterAddress::dutyCycle:
+                return 20.0f;
+            case VoxExtensionParameterAddress::useVowelMorph:
+                return 1.0f;
+            case VoxExtensionParameterAddress::vowelMorph:
+                return 0.0f;
+            case VoxExtensionParameterAddress::formant1Freq:
+                return 800.0f;
+            case VoxExtensionParameterAddress::formant2Freq:
+                return 1200.0f;
+            case VoxExtensionParameterAddress::formant1Q:
+                return 10.0f;
+            case VoxExtensionParameterAddress::formant2Q:
+                return 10.0f;
+            case VoxExtensionParameterAddress::formantMix:
+                return 100.0f;
+            case VoxExtensionParameterAddress::air:
+                return 0.0f;
+            case VoxExtensionParameterAddress::ampAttack:
+                return 10.0f;
+            case VoxExtensionParameterAddress::ampDecay:
+                return 100.0f;
+            case VoxExtensionParameterAddress::ampSustain:
+                return 70.0f;
+            case VoxExtensionParameterAddress::ampRelease:
+                return 300.0f;
+            case VoxExtensionParameterAddress::glideEnabled:
+                return 0.0f;
+            case VoxExtensionParameterAddress::glideTime:
+                return 100.0f;
+            case VoxExtensionParameterAddress::pitchBendRange:
+                return 2.0f;
+            default:
+                return 0.0f;
+        }
+    }
+    
+    // Convert one AU parameter value into the voice parameters; false for
+    // addresses that are not voice parameters
+    static bool applyParameter(VoxVoiceParameters& params, AUParameterAddress address, AUValue value) {
         switch (address) {
             // Master Section
             case VoxExtensionParameterAddress::masterVolume:
-                mStoredParameters.masterVolume = dBToAmplitude(value);
+                params.masterVolume = dBToAmplitude(value);
+                break;
+            case VoxExtensionParameterAddress::modQuality:
+                params.modControlRate = ControlRate::samplesForChoice(static_cast<int>(value));
                 break;
                 
             // Pulsar Oscillator
             case VoxExtensionParameterAddress::pulsaretShape:
-                mStoredParameters.pulsaretShape = static_cast<int>(value);
+                params.pulsaretShape = static_cast<int>(value);
                 break;
             case VoxExtensionParameterAddress::dutyCycle:
-                mStoredParameters.dutyCycle = value / 100.0;  // Convert from percent
+                params.dutyCycle = value / 100.0;  // Convert from percent
                 break;
                 
             // Formant Filter
             case VoxExtensionParameterAddress::useVowelMorph:
-                mStoredParameters.useVowelMorph = (value >= 0.5);
+                params.useVowelMorph = (value >= 0.5);
                 break;
             case VoxExtensionParameterAddress::vowelMorph:
-                mStoredParameters.vowelMorph = value;
+                params.vowelMorph = value;
                 break;
             case VoxExtensionParameterAddress::formant1Freq:
-                mStoredParameters.formant1Freq = value;
+                params.formant1Freq = value;
                 break;
             case VoxExtensionParameterAddress::formant2Freq:
-                mStoredParameters.formant2Freq = value;
+                params.formant2Freq = value;
                 break;
             case VoxExtensionParameterAddress::formant1Q:
-                mStoredParameters.formant1Q = value;
+                params.formant1Q = value;
                 break;
             case VoxExtensionParameterAddress::formant2Q:
-                mStoredParameters.formant2Q = value;
+                params.formant2Q = value;
                 break;
             case VoxExtensionParameterAddress::formantMix:
-                mStoredParameters.formantMix = value / 100.0;  // Convert from percent
+                params.formantMix = value / 100.0;  // Convert from percent
+                break;
+            case VoxExtensionParameterAddress::air:
+                params.air = value / 100.0;  // Convert from percent
                 break;
                 
             // Amp Envelope
             case VoxExtensionParameterAddress::ampAttack:
-                mStoredParameters.ampAttack = value / 1000.0;  // Convert from ms to seconds
+                params.ampAttack = value / 1000.0;  // Convert from ms to seconds
                 break;
             case VoxExtensionParameterAddress::ampDecay:
-                mStoredParameters.ampDecay = value / 1000.0;
+                params.ampDecay = value / 1000.0;
                 break;
             case VoxExtensionParameterAddress::ampSustain:
-                mStoredParameters.ampSustain = value / 100.0;  // Convert from percent
+                params.ampSustain = value / 100.0;  // Convert from percent
                 break;
             case VoxExtensionParameterAddress::ampRelease:
-                mStoredParameters.ampRelease = value / 1000.0;
+                params.ampRelease = value / 1000.0;
                 break;
                 
             // Performance
             case VoxExtensionParameterAddress::glideEnabled:
-                mStoredParameters.glideEnabled = (value >= 0.5);
+                params.glideEnabled = (value >= 0.5);
                 break;
             case VoxExtensionParameterAddress::glideTime:
-                mStoredParameters.glideTime = value / 1000.0;  // Convert from ms
+                params.glideTime = value / 1000.0;  // Convert from ms
                 break;
-            case VoxExtensionParameterAddress::pitchBendRange:
-                mPitchBendRange = static_cast<int>(value);
-                updateVoice = false;
-                break;
-                
             default:
-                updateVoice = false;
-                break;
-        }
-        
-        // Apply to voice pool if it exists
-        if (updateVoice && mVoicePool) {
-            mVoicePool->setParameters(mStoredParameters);
-        }
-    }
-    
-    AUValue getParameter(AUParameterAddress address) {
-        // Return raw parameter value if stored
-        auto it = mRawParameterValues.find(address);
-        if (it != mRawParameterValues.end()) {
-            return it->second;
-        }
-        
-        // Return defaults
-        switch (address) {
-            case VoxExtensionParameterAddress::masterVolume:
-                return -6.0f;
-            case VoxExtensionParameterAddress::pulsaretShape:
-                return 1.0f;
-            case VoxExtensionParameterAddress::dutyCycle:
-                return 20.0f;
-            case VoxExtensionParameterAddress::useVowelMorph:
-                return 1.0f;
-            case VoxExtensionParameterAddress::vowelMorph:
-                return 0.0f;
-            case VoxExtensionParameterAddress::formant1Freq:
-                return 800.0f;
-            case VoxExtensionParameterAddress::formant2Freq:
-                return 1200.0f;
-            case VoxExtensionParameterAddress::formant1Q:
-                return 10.0f;
-            case VoxExtensionParameterAddress::formant2Q:
-                return 10.0f;
-            case VoxExtensionParameterAddress::formantMix:
-                return 100.0f;
-            case VoxExtensionParameterAddress::ampAttack:
-                return 10.0f;
-            case VoxExtensionParameterAddress::ampDecay:
-                return 100.0f;
-            case VoxExtensionParameterAddress::ampSustain:
-                return 70.0f;
-            case VoxExtensionParameterAddress::ampRelease:
-                return 300.0f;
-            case VoxExtensionParameterAddress::glideEnabled:
-                return 0.0f;
-            case VoxExtensionParameterAddress::glideTime:
-                return 100.0f;
-            case VoxExtensionParameterAddress::pitchBendRange:
-                return 2.0f;
-            default:
-                return 0.0f;
+                // Kernel settings (pitch bend range) and unused addresses
+                return false;
         }
+        return true;
     }
     
     // MARK: - Max Frames
@@ -236,6 +245,43 @@ public:
         mTransportStateBlock = transportBlock;
     }
     
+    // Query the host once per render call. Tempo changes go to the voice
+    // pool immediately; the beat position is kept with the buffer start time
+    // so process() can place every segment exactly on the host's beat grid.
+    void beginRender(AUEventSampleTime bufferStartTime) {
+        // Parameters changed by a control thread since the last render
+        if (applyChangedParameters() && mVoicePool) {
+            mVoicePool->setParameters(mRenderParameters);
+        }
+        
+        mHostBufferStartTime = bufferStartTime;
+        mHostBeatValid = false;
+        
+        // Hosts without a transport block are treated as always playing
+        bool transportMoving = true;
+        if (mTransportStateBlock) {
+            AUHostTransportStateFlags flags = 0;
+            if (mTransportStateBlock(&flags, nullptr, nullptr, nullptr)) {
+                transportMoving = (flags & AUHostTransportStateMoving) != 0;
+            }
+        }
+        
+        if (mMusicalContextBlock) {
+            double tempo = 0.0;
+            double beatPosition = 0.0;
+            if (mMusicalContextBlock(&tempo, nullptr, nullptr, &beatPosition, nullptr, nullptr)) {
+                if (tempo > 0.0 && tempo != mHostTempo) {
+                    mHostTempo = tempo;
+                    if (mVoicePool) {
+                        mVoicePool->setTempo(tempo);
+                    }
+                }
+                mHostBeatPosition = beatPosition;
+                mHostBeatValid = transportMoving;
+            }
+        }
+    }
+    
     // MARK: - MIDI Protocol
     MIDIProtocolID AudioUnitMIDIProtocol() const {
         return kMIDIProtocol_2_0;
@@ -259,14 +305,25 @@ public:
             return;
         }
         
-        // Generate per sample DSP from polyphonic voice pool
-        for (UInt32 frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
-            // Process all active voices and sum
-            const auto sample = static_cast<float>(mVoicePool->process());
+        // Render the polyphonic voice pool in blocks (each voice runs its
+        // fused output stage over the block), then copy to all channels
+        const AUAudioFrameCount chunkSize = static_cast<AUAudioFrameCount>(mRenderBuffer.size());
+        for (AUAudioFrameCount offset = 0; offset < frameCount; offset += chunkSize) {
+            const AUAudioFrameCount count = std::min(chunkSize, frameCount - offset);
+            if (mHostBeatValid) {
+                // Beat position of this chunk's first sample, from the host's
+                // position at the buffer start (no accumulated increments)
+                const double samples = static_cast<double>(bufferStartTime + offset - mHostBufferStartTime);
+                mVoicePool->syncToBeatPosition(mHostBeatPosition + samples * mHostTempo / (60.0 * mSampleRate));
+            }
+            mVoicePool->processBlock(mRenderBuffer.data(), static_cast<int>(count));
             
             // Output to all channels (mono to stereo)
             for (UInt32 channel = 0; channel < outputBuffers.size(); ++channel) {
-                outputBuffers[channel][frameIndex] = sample;
+                float* out = outputBuffers[channel] + offset;
+                for (AUAudioFrameCount i = 0; i < count; ++i) {
+                    out[i] = static_cast<float>(mRenderBuffer[i]);
+                }
             }
         }
         
@@ -325,11 +382,18 @@ public:
         }
     }
     
+    // Render thread: automation applies to the render-side parameters at once
     void handleParameterEvent(AUEventSampleTime now, AUParameterEvent const& parameterEvent) {
-        setParameter(parameterEvent.parameterAddress, parameterEvent.value);
+        const AUParameterAddress address = parameterEvent.parameterAddress;
+        if (mParameters.store(address, parameterEvent.value) &&
+            applyParameter(mRenderParameters, address, parameterEvent.value) && mVoicePool) {
+            mVoicePool->setParameters(mRenderParameters);
+        }
     }
     
     void handleMIDIEventList(AUEventSampleTime now, AUMIDIEventList const* midiEvent) {
+        mExpression.setMasterBendRange(pitchBendRange());
+        
         auto visitor = [] (void* context, MIDITimeStamp timeStamp, MIDIUniversalMessage message) {
             auto thisObject = static_cast<VoxExtensionDSPKernel *>(context);
             
@@ -354,40 +418,49 @@ public:
         MIDIEventListForEachEvent(&midiEvent->eventList, visitor, this);
     }
     
-    // MIDI 1.0 handler
+    // MIDI 1.0 handler. Notes and expression go through the expression
+    // router, which sends MPE member channels' bend, pressure and timbre to
+    // their own notes and everything else to the whole pool.
     void handleMIDI1VoiceMessage(const struct MIDIUniversalMessage& message) {
-        const auto status = message.channelVoice1.status;
-        const auto note = message.channelVoice1.note.number;
-        const auto velocity = message.channelVoice1.note.velocity;
+        if (!mVoicePool) {
+            return;
+        }
+        const auto& voice = message.channelVoice1;
+        const int channel = voice.channel;
         
-        switch (status) {
+        switch (voice.status) {
             case kMIDICVStatusNoteOff: {
-                VOX_LOG("MIDI1 Note OFF: note=%d", note);
-                if (mVoicePool) {
-                    mVoicePool->noteOff(note);
-                }
+                VOX_LOG("MIDI1 Note OFF: note=%d", voice.note.number);
+                mExpression.noteOff(*mVoicePool, channel, voice.note.number);
                 break;
             }
             case kMIDICVStatusNoteOn: {
-                VOX_LOG("MIDI1 Note ON: note=%d vel=%d", note, velocity);
-                if (mVoicePool) {
-                    if (velocity == 0) {
-                        // Note on with velocity 0 = note off
-                        mVoicePool->noteOff(note);
-                    } else {
-                        const double normalizedVelocity = (double)velocity / 127.0;
-                        mVoicePool->noteOn(note, normalizedVelocity);
-                    }
+                VOX_LOG("MIDI1 Note ON: note=%d vel=%d", voice.note.number, voice.note.velocity);
+                if (voice.note.velocity == 0) {
+                    // Note on with velocity 0 = note off
+                    mExpression.noteOff(*mVoicePool, channel, voice.note.number);
+                } else {
+                    const double normalizedVelocity = (double)voice.note.velocity / 127.0;
+                    mExpression.noteOn(*mVoicePool, channel, voice.note.number, normalizedVelocity);
                 }
                 break;
             }
             case kMIDICVStatusPitchBend: {
-                if (mVoicePool) {
-                    // MIDI 1.0 pitch bend is 14-bit packed in UInt16
-                    const double normalizedBend = ((double)message.channelVoice1.pitchBend / 16383.0) * 2.0 - 1.0;
-                    const double semitones = normalizedBend * mPitchBendRange;
-                    mVoicePool->setPitchBend(semitones);
-                }
+                // MIDI 1.0 pitch bend is 14-bit packed in UInt16
+                const double normalizedBend = ((double)voice.pitchBend / 16383.0) * 2.0 - 1.0;
+                mExpression.pitchBend(*mVoicePool, channel, normalizedBend);
+                break;
+            }
+            case kMIDICVStatusPolyPressure: {
+                mExpression.notePressure(*mVoicePool, channel, voice.polyPressure.noteNumber, voice.polyPressure.pressure / 127.0);
+                break;
+            }
+            case kMIDICVStatusChannelPressure: {
+                mExpression.channelPressure(*mVoicePool, channel, voice.channelPressure / 127.0);
+                break;
+            }
+            case kMIDICVStatusControlChange: {
+                mExpression.controlChange(*mVoicePool, channel, voice.controlChange.index, voice.controlChange.data);
                 break;
             }
             default:
@@ -395,38 +468,64 @@ public:
         }
     }
     
-    // MIDI 2.0 handler
+    // MIDI 2.0 handler: the channel messages as in MIDI 1.0 at full
+    // resolution, plus per-note pitch bend, poly pressure and per-note
+    // controller 74 (timbre) addressed to the note directly
     void handleMIDI2VoiceMessage(const struct MIDIUniversalMessage& message) {
-        const auto& note = message.channelVoice2.note;
+        if (!mVoicePool) {
+            return;
+        }
+        const auto& voice = message.channelVoice2;
+        const int channel = voice.channel;
         
-        switch (message.channelVoice2.status) {
+        switch (voice.status) {
             case kMIDICVStatusNoteOff: {
-                VOX_LOG("MIDI2 Note OFF: note=%d", note.number);
-                if (mVoicePool) {
-                    mVoicePool->noteOff(note.number);
-                }
+                VOX_LOG("MIDI2 Note OFF: note=%d", voice.note.number);
+                mExpression.noteOff(*mVoicePool, channel, voice.note.number);
                 break;
             }
             case kMIDICVStatusNoteOn: {
-                const auto velocity = message.channelVoice2.note.velocity;
-                VOX_LOG("MIDI2 Note ON: note=%d vel=%u", note.number, velocity);
-                if (mVoicePool) {
-                    const double normalizedVelocity = (double)velocity / (double)std::numeric_limits<std::uint16_t>::max();
-                    mVoicePool->noteOn(note.number, normalizedVelocity);
-                }
+                VOX_LOG("MIDI2 Note ON: note=%d vel=%u", voice.note.number, voice.note.velocity);
+                const double normalizedVelocity = (double)voice.note.velocity / (double)std::numeric_limits<std::uint16_t>::max();
+                mExpression.noteOn(*mVoicePool, channel, voice.note.number, normalizedVelocity);
                 break;
             }
             case kMIDICVStatusPitchBend: {
-                if (mVoicePool) {
-                    // Convert MIDI 2.0 pitch bend to semitones
-                    const double normalizedBend = ((double)message.channelVoice2.pitchBend.data / (double)0xFFFFFFFF) * 2.0 - 1.0;
-                    const double semitones = normalizedBend * mPitchBendRange;
-                    mVoicePool->setPitchBend(semitones);
+                // Convert MIDI 2.0 pitch bend to -1...+1
+                const double normalizedBend = ((double)voice.pitchBend.data / (double)0xFFFFFFFF) * 2.0 - 1.0;
+                mExpression.pitchBend(*mVoicePool, channel, normalizedBend);
+                break;
+            }
+            case kMIDICVStatusPerNotePitchBend: {
+                const double normalizedBend = ((double)voice.perNotePitchBend.data / (double)0xFFFFFFFF) * 2.0 - 1.0;
+                mExpression.notePitchBend(*mVoicePool, channel, voice.perNotePitchBend.noteNumber, normalizedBend);
+                break;
+            }
+            case kMIDICVStatusPolyPressure: {
+                mExpression.notePressure(*mVoicePool, channel, voice.polyPressure.noteNumber, voice.polyPressure.pressure / kMIDI2ValueScale);
+                break;
+            }
+            case kMIDICVStatusChannelPressure: {
+                mExpression.channelPressure(*mVoicePool, channel, voice.channelPressure.data / kMIDI2ValueScale);
+                break;
+            }
+            case kMIDICVStatusAssignablePNC: {
+                if (voice.perNoteController.index == VoxExpressionRouter::kTimbreController) {
+                    mExpression.noteTimbre(*mVoicePool, channel, voice.perNoteController.noteNumber,
+                                           voice.perNoteController.data / kMIDI2ValueScale);
                 }
                 break;
             }
             case kMIDICVStatusControlChange: {
-                // Handle mod wheel, etc. (future expansion)
+                if (voice.controlChange.index == VoxExpressionRouter::kTimbreController) {
+                    mExpression.timbre(*mVoicePool, channel, voice.controlChange.data / kMIDI2ValueScale);
+                }
+                break;
+            }
+            case kMIDICVStatusRegisteredControl: {
+                // RPNs arrive whole in MIDI 2.0; the data MSB is the top 7 bits
+                const int parameter = (voice.controller.bank << 7) | voice.controller.index;
+                mExpression.registeredParameter(*mVoicePool, channel, parameter, static_cast<int>(voice.controller.data >> 25));
                 break;
             }
             default:
@@ -436,6 +535,8 @@ public:
     
     // MARK: - Utility
     static constexpr double kMinimumGainDB = -60.0;
+    static constexpr int kDefaultModQuality = 0;  // Audio rate, so saved sessions render unchanged
+    static constexpr double kMIDI2ValueScale = 4294967296.0;  // 32-bit controller values to 0...1
     
     static inline double dBToAmplitude(double dB) {
         if (dB <= kMinimumGainDB) {
@@ -445,21 +546,45 @@ public:
     }
     
 private:
+    // Render thread: re-apply the addresses control threads changed since
+    // the last call, at their current values, on top of the render-side set.
+    // Returns true if any voice parameter changed.
+    bool applyChangedParameters() {
+        const ParameterChanges changes = mParameters.takeChanges();
+        bool applied = false;
+        for (int address = changes.next(0); address >= 0; address = changes.next(address + 1)) {
+            applied |= applyParameter(mRenderParameters, address, mParameters.load(address));
+        }
+        return applied;
+    }
+    
+    int pitchBendRange() const {
+        return static_cast<int>(getParameter(VoxExtensionParameterAddress::pitchBendRange));
+    }
+    
     double mSampleRate = 44100.0;
     bool mBypassed = false;
     AUAudioFrameCount mMaxFramesToRender = 1024;
     
-    // Polyphonic voice pool (8 voices)
-    std::unique_ptr<VoicePool> mVoicePool;
-    VoxVoiceParameters mStoredParameters;
-    std::unordered_map<AUParameterAddress, AUValue> mRawParameterValues;
+    // Polyphonic voice pool (8 voices); sample type chosen by VOX_FLOAT_ENGINE
+    std::unique_ptr<VoxEngine> mVoicePool;
+    std::vector<VoxEngine::Sample> mRenderBuffer;
+    
+    // MPE zones and per-note expression routing (render thread)
+    VoxExpressionRouter mExpression;
     
-    // Performance settings
-    int mPitchBendRange = 2;  // semitones
+    // Parameters: raw values by address with the control threads' changed
+    // mask (any thread), and the render thread's voice parameters
+    ParameterSlots mParameters;
+    VoxVoiceParameters mRenderParameters;
     
     // Host context
     AUHostMusicalContextBlock mMusicalContextBlock = nullptr;
     AUHostTransportStateBlock mTransportStateBlock = nullptr;
+    AUEventSampleTime mHostBufferStartTime = 0;
+    double mHostTempo = 120.0;
+    double mHostBeatPosition = 0.0;
+    bool mHostBeatValid = false;
     
     // Level metering
     float mCurrentLevel = 0.0f;
@@ -21,6 +21,15 @@ let VoxExtensionParameterSpecs = ParameterTreeSpec {
             defaultValue: -6.0,
             flags: [.flag_IsWritable, .flag_IsReadable, .flag_IsHighResolution, .flag_CanRamp]
         )
+        ParameterSpec(
+            address: .modQuality,
+            identifier: "modQuality",
+            name: "Mod Quality",
+            units: .indexed,
+            valueRange: 0...4,
+            defaultValue: 0,
+            valueStrings: ["Audio Rate", "8 Samples", "16 Samples", "32 Samples", "64 Samples"]
+        )
     }
     
     // PULSAR OSCILLATOR SECTION
@@ -109,6 +118,15 @@ let VoxExtensionParameterSpecs = ParameterTreeSpec {
             defaultValue: 100.0,
             flags: [.flag_IsWritable, .flag_IsReadable, .flag_IsHighResolution, .flag_CanRamp]
         )
+        ParameterSpec(
+            address: .air,
+            identifier: "air",
+            name: "Air",
+            units: .percent,
+            valueRange: 0.0...100.0,
+            defaultValue: 0.0,
+            flags: [.flag_IsWritable, .flag_IsReadable, .flag_IsHighResolution, .flag_CanRamp]
+        )
     }
     
     // AMP ENVELOPE SECTION
@@ -12,6 +12,7 @@
 typedef NS_ENUM(AUParameterAddress, VoxExtensionParameterAddress) {
     // Master Section
     masterVolume = 0,
+    modQuality = 1,          // Modulation control rate: 0=Audio, 1=8, 2=16, 3=32, 4=64 samples
     
     // Pulsar Oscillator Section
     pulsaretShape = 10,      // 0=Gaussian, 1=RaisedCosine, 2=Sine, 3=Triangle
@@ -25,6 +26,7 @@ typedef NS_ENUM(AUParameterAddress, VoxExtensionParameterAddress) {
     formant2Q = 24,          // Q factor (1-30)
     formantMix = 25,         // 0.0 (dry) to 1.0 (full formant)
     useVowelMorph = 26,      // Boolean: use morph or manual formants
+    air = 27,                // percent (0 = bright, 100 = dark)
     
     // Amp Envelope
     ampAttack = 30,          // milliseconds